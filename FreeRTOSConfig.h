@@ -137,7 +137,15 @@ to exclude the API function. */
 #define INCLUDE_xQueueGetMutexHolder            1
 
 /* A header file that defines trace macro can be included here. */
-#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
+/* Run time stats count microseconds from the RP2040 timer.  It's 64 bits wide, so the counters
+don't wrap after 71 minutes the way a 32 bit one would.  cpu_stats.c also hooks every context
+switch so the time can be split per core. */
+#define configRUN_TIME_COUNTER_TYPE             uint64_t
+
+extern void CpuStatsInit(void);
+extern void CpuStatsTaskSwitchedIn(void);
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() CpuStatsInit()
+#define traceTASK_SWITCHED_IN()                 CpuStatsTaskSwitchedIn()
 
 extern uint64_t time_us_64(void);
 #define portGET_RUN_TIME_COUNTER_VALUE() time_us_64()
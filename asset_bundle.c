@@ -0,0 +1,152 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "asset_bundle.h"
+
+#define FNV_OFFSET 2166136261u
+#define FNV_PRIME 16777619u
+
+#ifdef ASSET_BUNDLE_FILE
+// The bundle from pack_bundle.py goes straight into flash, with no C array in between.  The build
+// passes its path as a string in ASSET_BUNDLE_FILE (see CMakeLists.txt).  The directory is read in
+// place, so it's aligned to a flash page, which keeps the clips' alignment in the bundle too.
+__asm__(".section .rodata.asset_bundle, \"a\"\n"
+        ".balign 256\n"
+        "assetBundleStart:\n"
+        ".incbin \"" ASSET_BUNDLE_FILE "\"\n"
+        "assetBundleEnd:\n"
+        ".previous\n");
+extern const uint8_t assetBundleStart[], assetBundleEnd[];
+
+#endif
+
+// Opened by AssetBundleInit.  Data is NULL without a bundle, or if it was turned down.
+static assetBundle_t builtIn;
+
+
+// Check the header, that every clip and name lies inside the bundle and that the directory is sorted
+// for AssetBundleFind, then point the bundle at it.  If anything's wrong, bundle->Error says what.
+// It doesn't print, so it can run before stdio is up.
+bool AssetBundleOpen (assetBundle_t * bundle, const void * data, size_t length) {
+    const assetBundleHeader_t *header = data;
+    const assetBundleEntry_t *entries = (const assetBundleEntry_t *)(header + 1);
+    const uint8_t *bytes = data;
+    uint32_t i;
+
+    bundle->Data = NULL;
+    if (length < sizeof(assetBundleHeader_t) || header->Magic != ASSET_BUNDLE_MAGIC ||
+        header->Version != ASSET_BUNDLE_VERSION || header->EntrySize != sizeof(assetBundleEntry_t) ||
+        header->Length > length || header->NamesOffset > header->Length ||
+        sizeof(assetBundleHeader_t) + (size_t)header->Count * sizeof(assetBundleEntry_t) > header->NamesOffset) {
+        bundle->Error = "bad header";
+        return false;
+    }
+    for (i = 0; i < header->Count; i++) {
+        if (entries[i].Offset > header->Length || entries[i].Length > header->Length - entries[i].Offset ||
+            entries[i].NameOffset < header->NamesOffset || entries[i].NameOffset >= header->Length ||
+            entries[i].AudioOffset >= entries[i].Length) {
+            bundle->Error = "a clip is out of bounds";
+            return false;
+        }
+        if (memchr(bytes + entries[i].NameOffset, '\0', header->Length - entries[i].NameOffset) == NULL) {
+            bundle->Error = "a name runs off the end";
+            return false;
+        }
+        if (i && entries[i].Id <= entries[i - 1].Id) {
+            bundle->Error = "the directory isn't sorted by ID";
+            return false;
+        }
+    }
+
+    bundle->Data = data;
+    bundle->Header = header;
+    bundle->Entries = entries;
+    bundle->Error = NULL;
+    return true;
+}
+
+
+// Open the bundle built into the firmware, if there is one.  Call once at start-up, before the tasks
+// that use it are running.
+void AssetBundleInit (void) {
+#ifdef ASSET_BUNDLE_FILE
+    AssetBundleOpen(&builtIn, assetBundleStart, (size_t)(assetBundleEnd - assetBundleStart));
+#endif
+}
+
+
+// The bundle built into the firmware, or NULL if there isn't one (or it was turned down).
+const assetBundle_t * AssetBundleBuiltIn (void) {
+    return builtIn.Data != NULL ? &builtIn : NULL;
+}
+
+
+// 32-bit FNV-1a of the name, the same as pack_bundle.py.
+uint32_t AssetBundleId (const char * name) {
+    uint32_t hash = FNV_OFFSET;
+    while (*name)
+        hash = (hash ^ (uint8_t)*name++) * FNV_PRIME;
+    return hash;
+}
+
+
+// Binary search of the directory, which is sorted by ID.
+const assetBundleEntry_t * AssetBundleFind (const assetBundle_t * bundle, uint32_t id) {
+    uint32_t low = 0, high, middle;
+
+    if (bundle == NULL)
+        return NULL;
+    high = bundle->Header->Count;
+    while (low < high) {
+        middle = low + (high - low) / 2;
+        if (bundle->Entries[middle].Id < id)
+            low = middle + 1;
+        else if (bundle->Entries[middle].Id > id)
+            high = middle;
+        else
+            return &bundle->Entries[middle];
+    }
+    return NULL;
+}
+
+
+// The packer won't put two names with the same ID in a bundle, but the name is checked anyway so a
+// name that isn't there can't find some other clip.
+const assetBundleEntry_t * AssetBundleFindName (const assetBundle_t * bundle, const char * name) {
+    const assetBundleEntry_t *entry = AssetBundleFind(bundle, AssetBundleId(name));
+
+    if (entry != NULL && strcmp(AssetBundleName(bundle, entry), name) != 0)
+        return NULL;
+    return entry;
+}
+
+
+const char * AssetBundleName (const assetBundle_t * bundle, const assetBundleEntry_t * entry) {
+    return (const char *)bundle->Data + entry->NameOffset;
+}
+
+
+const void * AssetBundleClip (const assetBundle_t * bundle, const assetBundleEntry_t * entry) {
+    return bundle->Data + entry->Offset;
+}
+
+
+void AssetBundlePrint (const assetBundle_t * bundle) {
+    const assetBundleEntry_t *entry;
+    uint32_t i;
+
+    if (bundle == NULL) {
+        if (builtIn.Error != NULL)
+            printf("No asset bundle: the built-in one was turned down (%s).\r\n", builtIn.Error);
+        else
+            printf("No asset bundle.\r\n");
+        return;
+    }
+    printf("Bundle: %u clips, %u bytes.\r\n", (unsigned)bundle->Header->Count, (unsigned)bundle->Header->Length);
+    printf("      ID    Bytes     ms  Ch  Name\r\n");
+    for (i = 0; i < bundle->Header->Count; i++) {
+        entry = &bundle->Entries[i];
+        printf("%08x %8u %6u %3u  %s\r\n", (unsigned)entry->Id, (unsigned)entry->Length,
+               (unsigned)(entry->Samples / 48), (unsigned)entry->Channels, AssetBundleName(bundle, entry));
+    }
+}
@@ -0,0 +1,59 @@
+// Asset Bundle Header File
+// Many Ogg Opus clips packed into one block of flash by tools/pack_bundle.py, instead of a C array
+// per clip.  A short header is followed by a directory of fixed-size entries sorted by clip ID, so a
+// clip is found with a binary search.  Each entry has the clip's offset and length in the bundle, and
+// the stream info the player would otherwise parse out of its Ogg headers at start-up: pre-skip,
+// length in samples and where the audio pages start.  Clip IDs are the FNV-1a hash of the clip's
+// name (its file name, without the extension), and the names are kept in the bundle too.
+// Everything is little-endian and read in place; nothing is copied out of flash.
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef ASSET_BUNDLE_H
+#define ASSET_BUNDLE_H
+
+#define ASSET_BUNDLE_MAGIC 0x3142504F // "OPB1"
+#define ASSET_BUNDLE_VERSION 1
+
+typedef struct {
+    uint32_t Magic;
+    uint16_t Version;
+    uint16_t EntrySize;         // sizeof(assetBundleEntry_t), so the directory can grow.
+    uint32_t Count;
+    uint32_t NamesOffset;       // The NUL-terminated names, after the directory.
+    uint32_t Length;            // Of the whole bundle.
+    uint32_t Align;             // Every clip starts on a multiple of this.
+} assetBundleHeader_t;
+
+typedef struct {
+    uint32_t Id;
+    uint32_t NameOffset;        // From the start of the bundle, like Offset.
+    uint32_t Offset;
+    uint32_t Length;
+    uint32_t AudioOffset;       // Of the first audio page, from the start of the clip.
+    uint32_t Samples;           // At 48kHz, from the last granule position, less the pre-skip.
+    uint32_t InputRate;         // What the clip was encoded from, for information.
+    uint16_t PreSkip;           // At 48kHz.
+    uint8_t Channels;
+    uint8_t Reserved;
+} assetBundleEntry_t;
+
+typedef struct {
+    const uint8_t * Data;
+    const assetBundleHeader_t * Header;
+    const assetBundleEntry_t * Entries;
+    const char * Error;         // Why AssetBundleOpen turned it down, or NULL.
+} assetBundle_t;
+
+bool AssetBundleOpen (assetBundle_t * bundle, const void * data, size_t length);
+void AssetBundleInit (void);
+const assetBundle_t * AssetBundleBuiltIn (void);
+uint32_t AssetBundleId (const char * name);
+const assetBundleEntry_t * AssetBundleFind (const assetBundle_t * bundle, uint32_t id);
+const assetBundleEntry_t * AssetBundleFindName (const assetBundle_t * bundle, const char * name);
+const char * AssetBundleName (const assetBundle_t * bundle, const assetBundleEntry_t * entry);
+const void * AssetBundleClip (const assetBundle_t * bundle, const assetBundleEntry_t * entry);
+void AssetBundlePrint (const assetBundle_t * bundle);
+
+#endif
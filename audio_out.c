@@ -0,0 +1,308 @@
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "hardware/clocks.h"
+#include "hardware/dma.h"
+#include "hardware/pio.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "settings.h"
+#include "audio_out.h"
+
+static struct audio_buffer_pool *producerPool = NULL;
+
+// Play-out model.  playoutEnd is when the I2S consumer will run out of what we've queued so far.
+// While streaming, every buffer we hand over has to arrive before then or the consumer starves.
+static bool streaming = false;
+static uint64_t playoutEnd = 0;
+
+// Underrun record.  Written only from the decode loop; a reset from elsewhere just raises the flag.
+static uint32_t underrunCount = 0;
+static uint64_t underrunTotalUs = 0;
+static uint32_t concealCount = 0;
+static audioOutUnderrun_t underrunLog[AUDIO_OUT_UNDERRUN_LOG];
+static uint32_t underrunLogNext = 0;
+static volatile bool underrunResetRequested = false;
+
+// Silence skipping and parking.  While skipping, skipEnd carries on the play-out timeline for the
+// silence we didn't send, so the decode loop can be paced by it.
+static uint32_t silentUs = 0;
+static bool skipping = false;
+static uint64_t skipEnd = 0;
+static bool parked = false;
+static uint64_t parkedAt = 0;
+static uint32_t parkCount = 0;
+static uint64_t parkedTotalUs = 0;
+static uint64_t skippedTotalUs = 0;
+static uint32_t rearmMaxUs = 0;
+static uint64_t heldAt = 0;             // When I2S was stopped for a clock change.
+
+
+// Set up the audio device.  This is taken pretty verbatim from the Pico Audio example.
+void AudioOutInit (void) {
+    static audio_format_t audio_format = {
+            .format = AUDIO_BUFFER_FORMAT_PCM_S16,
+            .sample_freq = AUDIO_OUT_SAMPLE_RATE,
+            .channel_count = 1,
+    };
+
+    static struct audio_buffer_format producer_format = {
+            .format = &audio_format,
+            .sample_stride = 2
+    };
+
+    bool __unused ok;
+    const struct audio_format *output_format;
+
+    producerPool = audio_new_producer_pool(&producer_format, AUDIO_OUT_BUFFER_COUNT, SAMPLES_PER_BUFFER);
+
+    struct audio_i2s_config config = {
+            .data_pin = I2S_DATA_PIN,
+            .clock_pin_base = I2S_CLOCK_PIN,
+            .dma_channel = AUDIO_OUT_DMA_CHANNEL,
+            .pio_sm = AUDIO_OUT_PIO_SM,
+    };
+
+    output_format = audio_i2s_setup(&audio_format, &config);
+    if (!output_format) {
+        panic("PicoAudio: Unable to open audio device.\n");
+    }
+
+    ok = audio_i2s_connect(producerPool);
+    assert(ok);
+    audio_i2s_set_enabled(true);
+}
+
+
+// Stop the I2S state machine while clk_sys changes, since its divider only suits the old clock.
+// The DAC loses its bit clock and goes quiet, and the DMA waits on the FIFO where it is.
+void AudioOutHold (void) {
+    pio_sm_set_enabled(AUDIO_OUT_PIO, AUDIO_OUT_PIO_SM, false);
+    heldAt = time_us_64();
+}
+
+
+// Re-derive the I2S PIO clock divider after clk_sys has changed, and restart it unless it's parked.
+// This is the same sum pico-extras' audio_i2s.c does when it first sets the sample rate.  Whatever
+// was queued plays that much later.
+void AudioOutRetime (void) {
+    uint32_t divider = clock_get_hz(clk_sys) * 4 / AUDIO_OUT_SAMPLE_RATE;
+    pio_sm_set_clkdiv_int_frac(AUDIO_OUT_PIO, AUDIO_OUT_PIO_SM, divider >> 8u, divider & 0xffu);
+    if (!parked)
+        pio_sm_set_enabled(AUDIO_OUT_PIO, AUDIO_OUT_PIO_SM, true);
+    if (streaming)
+        playoutEnd += time_us_64() - heldAt;
+}
+
+
+// Grab a free buffer to fill.  Blocks until one is available.
+// While silence is being skipped the pool doesn't hold us back, so wait until the next block is
+// nearly due instead.
+audio_buffer_t * AudioOutTake (void) {
+    uint64_t now = time_us_64();
+    if (skipping && skipEnd > now + AUDIO_OUT_LEAD_US)
+        vTaskDelay(pdMS_TO_TICKS((uint32_t)(skipEnd - now - AUDIO_OUT_LEAD_US) / 1000));
+    return take_audio_buffer(producerPool, true);
+}
+
+
+static bool IsSilent (const audio_buffer_t * buffer) {
+    const int16_t *samples = (const int16_t *)buffer->buffer->bytes;
+    uint32_t i;
+    for (i = 0; i < buffer->sample_count; i++) {
+        if (samples[i] > AUDIO_OUT_SILENCE_LEVEL || samples[i] < -AUDIO_OUT_SILENCE_LEVEL)
+            return false;
+    }
+    return true;
+}
+
+
+// Stop the I2S state machine and DMA.  Only done once everything queued has played.
+// audio_i2s_set_enabled(false) only stops the state machine and masks the DMA interrupt, which leaves
+// the channel stalled part way through its silence transfer, and re-enabling would trigger it again
+// while it's still busy.  So the channel is aborted here too, and the completion flag the abort can
+// raise (RP2040-E13) is cleared.
+static void Park (void) {
+    audio_i2s_set_enabled(false);
+    dma_channel_abort(AUDIO_OUT_DMA_CHANNEL);
+    dma_irqn_acknowledge_channel(PICO_AUDIO_I2S_DMA_IRQ, AUDIO_OUT_DMA_CHANNEL);
+    parked = true;
+    parkedAt = time_us_64();
+    parkCount++;
+}
+
+
+static void Unpark (void) {
+    uint64_t start = time_us_64();
+    uint32_t rearmUs;
+
+    audio_i2s_set_enabled(true);
+    parked = false;
+    parkedTotalUs += start - parkedAt;
+    rearmUs = (uint32_t)(time_us_64() - start);
+    if (rearmUs > rearmMaxUs)
+        rearmMaxUs = rearmUs;
+}
+
+
+// Park I2S once the stream has ended, or gone quiet, and the consumer has played everything.  The
+// consumer only picks up a buffer when its current silence transfer ends, so it can finish later than
+// the play-out model says; give it two of those first, or the abort would cut off a real buffer.
+// Call this from the decode loop whether or not it's playing.
+void AudioOutService (void) {
+    if (!parked && (skipping || !streaming) &&
+        time_us_64() >= playoutEnd + AudioOutBufferUs(2 * AUDIO_OUT_SILENCE_SAMPLES))
+        Park();
+}
+
+
+bool AudioOutParked (void) {
+    return parked;
+}
+
+
+static void CheckUnderrunReset (void) {
+    if (underrunResetRequested) {
+        underrunCount = 0;
+        underrunTotalUs = 0;
+        concealCount = 0;
+        underrunLogNext = 0;
+        parkCount = 0;
+        parkedTotalUs = 0;
+        skippedTotalUs = 0;
+        rearmMaxUs = 0;
+        underrunResetRequested = false;
+    }
+}
+
+
+// Log an underrun and ramp the resumed audio in, so the restart doesn't click.
+static void HandleUnderrun (audio_buffer_t * buffer, uint64_t now, uint32_t gapUs) {
+    int16_t *samples = (int16_t *)buffer->buffer->bytes;
+    uint32_t i, fade;
+
+    CheckUnderrunReset();
+    underrunCount++;
+    underrunTotalUs += gapUs;
+    underrunLog[underrunLogNext % AUDIO_OUT_UNDERRUN_LOG].TimeUs = now;
+    underrunLog[underrunLogNext % AUDIO_OUT_UNDERRUN_LOG].GapUs = gapUs;
+    underrunLogNext++;
+
+    fade = buffer->sample_count < AUDIO_OUT_FADE_SAMPLES ? buffer->sample_count : AUDIO_OUT_FADE_SAMPLES;
+    for (i = 0; i < fade; i++)
+        samples[i] = (int16_t)(((int32_t)samples[i] * (int32_t)i) / AUDIO_OUT_FADE_SAMPLES);
+}
+
+
+// Hand a filled buffer to I2S and advance the play-out model.
+// Returns the slack in microseconds: how much queued audio was still left to play when this buffer
+// arrived.  Negative means the consumer had already run dry.  A buffer with no samples ends the
+// stream, and the first buffer of a new stream has no deadline to meet.
+int32_t AudioOutGive (audio_buffer_t * buffer) {
+    uint64_t now = time_us_64();
+    int32_t slack = AUDIO_OUT_NO_DEADLINE;
+    uint32_t bufferUs = AudioOutBufferUs(buffer->sample_count);
+
+    // Long silences are dropped here rather than played.  The first sound after one starts a new
+    // stream, so the gap isn't mistaken for an underrun.
+    if (buffer->sample_count && IsSilent(buffer)) {
+        silentUs += bufferUs;
+        if (silentUs >= AUDIO_OUT_PARK_MS * 1000) {
+            if (!skipping)
+                skipEnd = playoutEnd > now ? playoutEnd : now;
+            skipping = true;
+            skipEnd += bufferUs;
+            skippedTotalUs += bufferUs;
+            queue_free_audio_buffer(producerPool, buffer);
+            return AUDIO_OUT_NO_DEADLINE;
+        }
+    } else {
+        silentUs = 0;
+        if (skipping) {
+            skipping = false;
+            streaming = false;
+        }
+    }
+
+    if (buffer->sample_count == 0) {
+        // End of stream.  The empty buffer goes back to the pool rather than to I2S.
+        streaming = false;
+        skipping = false;
+        silentUs = 0;
+        queue_free_audio_buffer(producerPool, buffer);
+        return slack;
+    } else {
+        if (streaming) {
+            slack = (int32_t)((int64_t)playoutEnd - (int64_t)now);
+            if (slack < 0)
+                HandleUnderrun(buffer, now, (uint32_t)-slack);
+        }
+        if (!streaming || playoutEnd < now)
+            playoutEnd = now;
+        playoutEnd += bufferUs;
+        streaming = true;
+    }
+
+    // Queue it before re-arming, so the channel starts on this buffer rather than on silence.
+    give_audio_buffer(producerPool, buffer);
+    if (parked)
+        Unpark();
+    return slack;
+}
+
+
+// Play time of a number of samples, in microseconds.
+uint32_t AudioOutBufferUs (uint32_t samples) {
+    return (uint32_t)(((uint64_t)samples * 1000000) / AUDIO_OUT_SAMPLE_RATE);
+}
+
+
+// How much audio is queued ahead of the consumer right now, in microseconds.
+uint32_t AudioOutQueuedUs (void) {
+    uint64_t now = time_us_64();
+    if (!streaming || playoutEnd <= now)
+        return 0;
+    return (uint32_t)(playoutEnd - now);
+}
+
+
+// Count a buffer of concealment audio the decode loop put in place of late or broken packets.
+void AudioOutCountConcealment (void) {
+    CheckUnderrunReset();
+    concealCount++;
+}
+
+
+uint32_t AudioOutUnderrunCount (void) {
+    return underrunResetRequested ? 0 : underrunCount;
+}
+
+
+void AudioOutResetUnderruns (void) {
+    underrunResetRequested = true;
+}
+
+
+// Print the counters and the most recent underruns, oldest first.
+void AudioOutPrintUnderruns (void) {
+    uint32_t i, first;
+
+    if (underrunResetRequested) {
+        printf("No underruns.\r\n");
+        return;
+    }
+
+    printf("%u underruns, %u us total gap, %u concealment buffers.\r\n", (unsigned)underrunCount,
+           (unsigned)underrunTotalUs, (unsigned)concealCount);
+    printf("I2S %s.  Parked %u times for %u ms, %u ms of silence skipped, slowest re-arm %u us.\r\n",
+           parked ? "parked" : "running", (unsigned)parkCount, (unsigned)(parkedTotalUs / 1000),
+           (unsigned)(skippedTotalUs / 1000), (unsigned)rearmMaxUs);
+
+    first = underrunLogNext > AUDIO_OUT_UNDERRUN_LOG ? underrunLogNext - AUDIO_OUT_UNDERRUN_LOG : 0;
+    for (i = first; i < underrunLogNext; i++) {
+        audioOutUnderrun_t *event = &underrunLog[i % AUDIO_OUT_UNDERRUN_LOG];
+        printf("  #%u at %u ms: %u us gap\r\n", (unsigned)(i + 1), (unsigned)(event->TimeUs / 1000),
+               (unsigned)event->GapUs);
+    }
+}
@@ -0,0 +1,54 @@
+// Audio Output Header File
+// Wraps the Pico Audio producer pool feeding I2S, and keeps a model of when queued audio will
+// actually be played so the decode loop can see how much time it has left.
+// Long runs of silence aren't sent at all.  Once what was sent has played out, the I2S state machine
+// and its DMA are stopped (parked) until there's sound again, which then starts from its first sample.
+#include <stdbool.h>
+#include <stdint.h>
+#include "pico/audio_i2s.h"
+
+#include "settings.h"
+
+#ifndef AUDIO_OUT_H
+#define AUDIO_OUT_H
+
+#define AUDIO_OUT_SAMPLE_RATE AUDIO_OUTPUT_RATE
+#define SAMPLES_PER_BUFFER 1920 // A 20ms block at 48kHz is 960 samples, plus the resampler's headroom.  Leaves room
+                                // for longer blocks at lower rates.
+#define AUDIO_OUT_BUFFER_COUNT 3
+#define AUDIO_OUT_PIO pio0      // pico-extras' default (PICO_AUDIO_I2S_PIO).
+#define AUDIO_OUT_PIO_SM 0
+#define AUDIO_OUT_DMA_CHANNEL 0
+#define AUDIO_OUT_SILENCE_SAMPLES 256   // What pico-extras' I2S plays each time it finds nothing queued.
+
+#define AUDIO_OUT_NO_DEADLINE INT32_MAX // Slack reported for the first buffer of a stream.
+
+#define AUDIO_OUT_UNDERRUN_LOG 8        // How many recent underruns to remember.
+#define AUDIO_OUT_FADE_SAMPLES (AUDIO_OUT_SAMPLE_RATE / 500) // Fade-in after an underrun.  2ms.
+#define AUDIO_OUT_GUARD_US 3000         // Less queued audio than this is cutting it fine.
+
+#define AUDIO_OUT_SILENCE_LEVEL 2       // Samples this close to zero count as silent (allows for filter noise).
+#define AUDIO_OUT_PARK_MS 200           // Silence longer than this isn't sent to I2S, and I2S is parked once it's drained.
+#define AUDIO_OUT_LEAD_US 5000          // While skipping silence, blocks are made this far ahead of when they're due,
+                                        // which bounds how late the first sound after it can be.
+
+typedef struct {
+    uint64_t TimeUs;    // When the late buffer was handed over.
+    uint32_t GapUs;     // How long the consumer had nothing to play.
+} audioOutUnderrun_t;
+
+void AudioOutInit (void);
+void AudioOutService (void);
+bool AudioOutParked (void);
+void AudioOutHold (void);
+void AudioOutRetime (void);
+audio_buffer_t * AudioOutTake (void);
+int32_t AudioOutGive (audio_buffer_t * buffer);
+uint32_t AudioOutBufferUs (uint32_t samples);
+uint32_t AudioOutQueuedUs (void);
+void AudioOutCountConcealment (void);
+uint32_t AudioOutUnderrunCount (void);
+void AudioOutResetUnderruns (void);
+void AudioOutPrintUnderruns (void);
+
+#endif
@@ -0,0 +1,655 @@
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#if PICO_ON_DEVICE
+    #include "hardware/clocks.h"
+#endif
+
+#include "bench.h"
+#include "compact_stream.h"
+#include "decoder_pool.h"
+#include "mixer.h"
+#include "ogg_data.h"
+#include "ogg_stripper.h"
+#include "opus_scratch.h"
+#include "player.h"
+#include "postproc.h"
+#include "resampler.h"
+#ifdef BENCH_ASSETS
+    #include "bench_assets.h"
+#endif
+#ifdef OPUS_CELT_M0PLUS
+    #include "opus_custom.h"
+    #include "modes.h"
+    #include "opus_celt_m0plus.h"
+#endif
+#ifdef OPUS_SILK_M0PLUS
+    #include "opus_silk_m0plus.h"
+#endif
+
+// Kept off the stack, which is being measured.
+static uint8_t benchPacket[PLAYER_PACKET_LEN];
+static int16_t benchPcm[PLAYER_FRAME_MAX];
+static oggReader_t benchReader;
+static compactReader_t benchCompact;    // Read instead of benchReader for compact streams.
+static size_t benchLength;
+static long benchAudioOffset;
+
+static int16_t stageInput[PLAYER_BLOCK_SAMPLES]; // Noise for the stage timings.
+#define BENCH_TWO_PI 6.283185307179586
+
+static int16_t stageTone[24000 / 50];         // 20ms of BENCH_TONE_HZ at the highest input rate.
+static int16_t stageOutput[MIXER_MAX_BLOCK];
+static int16_t stageInPlace[MIXER_MAX_BLOCK];
+
+static uintptr_t stackProbe;     // Where PaintStack painted.
+static volatile bool benchRequested = false;
+
+static const char modeLetters[DECODE_MODE_COUNT] = { 'S', 'H', 'C' };
+
+
+// Fill the stack just below the caller with a pattern, and remember where.  A call made next from
+// the same frame overwrites it as deep as it goes.
+static void __attribute__((noinline)) PaintStack (void) {
+    volatile uint8_t probe[BENCH_STACK_PROBE];
+    size_t i;
+    for (i = 0; i < BENCH_STACK_PROBE; i++)
+        probe[i] = BENCH_STACK_FILL;
+    stackProbe = (uintptr_t)probe;
+}
+
+
+// How much of what PaintStack filled has been used since.  Stacks grow down, so the pattern is
+// looked for from the bottom up.  BENCH_STACK_PROBE means it went deeper still.
+static size_t StackUsed (void) {
+    const volatile uint8_t * probe = (const volatile uint8_t *)stackProbe;
+    size_t i = 0;
+    while (i < BENCH_STACK_PROBE && probe[i] == BENCH_STACK_FILL)
+        i++;
+    return BENCH_STACK_PROBE - i;
+}
+
+
+// System clock in MHz, to turn times into cycles.  0 off the Pico, where there's no fixed clock.
+static uint32_t ClockMhz (void) {
+#if PICO_ON_DEVICE
+    return clock_get_hz(clk_sys) / 1000000;
+#else
+    return 0;
+#endif
+}
+
+
+// Open an asset at its first packet, with whichever reader its format needs.  Returns its channels.
+static int OpenAsset (const benchAsset_t * asset) {
+    benchLength = asset->Length;
+    if (CompactIsStream(asset->Data, asset->Length)) {
+        if (!CompactReaderOpen(&benchCompact, asset->Data, asset->Length))
+            return 0;
+        return benchCompact.Header.Channels;
+    }
+    benchCompact.Data = NULL;
+    OggReaderSetSource(&benchReader, asset->Data, asset->Length);
+    if (!OggReaderPrepareFile(&benchReader))
+        return 0;
+    benchAudioOffset = OggReaderTell(&benchReader);
+    return benchReader.IDHeader.ChannelCount;
+}
+
+
+// Back to the first packet of the open asset, the way the player opens a clip it's parsed already.
+static void RewindAsset (void) {
+    if (benchCompact.Data != NULL)
+        CompactReaderRewind(&benchCompact);
+    else
+        OggReaderSeek(&benchReader, benchAudioOffset);
+}
+
+
+// The next packet the way the player gets it: in place from a compact stream, copied out of the
+// page from Ogg.  Returns OGG_STRIP_EOF at the end; an empty packet is 0.
+static int FetchPacket (const uint8_t ** packet) {
+    if (benchCompact.Data != NULL)
+        return CompactReaderNextPacket(&benchCompact, packet);
+
+    // Stop at the end of the last page rather than have the reader complain about the next.
+    if (benchReader.CurrentPacket >= benchReader.PageHeader.Segments &&
+        OggReaderTell(&benchReader) >= (long)benchLength)
+        return OGG_STRIP_EOF;
+    *packet = benchPacket;
+    return OggReaderGetNextPacket(&benchReader, benchPacket, sizeof(benchPacket));
+}
+
+
+// Read and decode every packet of one asset.  Returns false if it couldn't be opened.
+// First the packets are only fetched, BENCH_FETCH_PASSES times over, to time the container alone.
+bool BenchRunAsset (const benchAsset_t * asset, benchResult_t * result) {
+    OpusDecoder * decoder;
+    const uint8_t * packet;
+    uint64_t start;
+    uint32_t decodeStart, decodeUs;
+    int length, samples, pass;
+    size_t stack;
+
+    memset(result, 0, sizeof(*result));
+    result->Channels = OpenAsset(asset);
+    if (!result->Channels)
+        return false;
+    start = time_us_64();
+    for (pass = 0; pass < BENCH_FETCH_PASSES; pass++) {
+        while (FetchPacket(&packet) >= 0)
+            ;
+        RewindAsset();
+    }
+    result->FetchUs = time_us_64() - start;
+
+    decoder = DecoderPoolAcquire(PLAYER_SAMPLE_RATE, 1);
+    if (decoder == NULL)
+        return false;
+    OpusScratchResetHighWater();
+
+    while (1) {
+        start = time_us_64();
+        length = FetchPacket(&packet);
+        if (length < 0)
+            break;
+        if (length == 0)
+            continue;   // A lost packet, which the player conceals.  There's nothing to decode.
+
+        PaintStack();
+        OpusScratchAcquire();
+        decodeStart = time_us_32();
+        samples = opus_decode(decoder, packet, length, benchPcm, PLAYER_FRAME_MAX, 0);
+        decodeUs = time_us_32() - decodeStart;
+        OpusScratchRelease();
+        stack = StackUsed();
+
+        result->TotalUs += time_us_64() - start;
+        result->DecodeUs += decodeUs;
+        if (decodeUs > result->WorstUs)
+            result->WorstUs = decodeUs;
+        if (stack > result->StackBytes)
+            result->StackBytes = stack;
+        if (samples > 0)
+            result->Samples += (uint32_t)samples;
+        else
+            result->Errors++;
+        result->Packets++;
+        result->ModePackets[DecodeStatsMode(packet)]++;
+        result->Bytes += (uint32_t)length;
+    }
+    result->Length = (uint32_t)asset->Length;
+
+    DecoderPoolRelease(decoder);
+    result->ScratchBytes = OpusScratchHighWater();
+    return true;
+}
+
+
+static void PrintResult (const char * name, const benchResult_t * result, uint32_t mhz) {
+    char modes[DECODE_MODE_COUNT + 1];
+    uint32_t audioMs = (uint32_t)(result->Samples * 1000 / PLAYER_SAMPLE_RATE);
+    uint32_t avgUs = result->Packets ? (uint32_t)(result->DecodeUs / result->Packets) : 0;
+    uint32_t kbps = audioMs ? (uint32_t)((uint64_t)result->Bytes * 8 / audioMs) : 0;
+    uint32_t rtx10 = result->TotalUs ? (uint32_t)(result->Samples * 10000000 / PLAYER_SAMPLE_RATE / result->TotalUs) : 0;
+    uint32_t fetchNs = result->Packets ? (uint32_t)(result->FetchUs * 1000 / BENCH_FETCH_PASSES / result->Packets) : 0;
+    int mode, count = 0;
+
+    for (mode = 0; mode < DECODE_MODE_COUNT; mode++) {
+        if (result->ModePackets[mode])
+            modes[count++] = modeLetters[mode];
+    }
+    modes[count] = '\0';
+
+    printf("%-24s", name);
+    if (result->Channels)
+        printf(" %2d", result->Channels);
+    else
+        printf(" %2s", "-");
+    printf(" %4u %-3s %6u %7u %6u.%u %7u %7u", (unsigned)kbps, modes, (unsigned)result->Packets, (unsigned)audioMs, (unsigned)(rtx10 / 10), (unsigned)(rtx10 % 10),
+           (unsigned)avgUs, (unsigned)result->WorstUs);
+    if (mhz)
+        printf(" %8u", (unsigned)(avgUs * mhz));
+    else
+        printf(" %8s", "-");
+    printf(" %7u %6u%s", (unsigned)result->ScratchBytes, (unsigned)result->StackBytes,
+           result->StackBytes >= BENCH_STACK_PROBE ? "+" : "");
+    printf(" %7u %6u", (unsigned)(result->Length - result->Bytes), (unsigned)fetchNs);
+    if (result->Errors)
+        printf("  %u packets failed", (unsigned)result->Errors);
+    printf("\r\n");
+}
+
+
+// Run every asset and print the table.  RTx is audio time over read and decode time; cycles are
+// the average per packet at the clock the bench ran at.  Framing is the asset's bytes that aren't
+// Opus packets (headers, pages and lengths), and get ns the time to fetch a packet without decoding.
+void BenchRun (const benchAsset_t * assets, int count) {
+    benchResult_t result, total;
+    uint32_t mhz = ClockMhz();
+    int i, mode;
+
+    if (mhz)
+        printf("Bench: %d assets, %u Hz mono out, %u MHz.\r\n", count, PLAYER_SAMPLE_RATE, (unsigned)mhz);
+    else
+        printf("Bench: %d assets, %u Hz mono out, host.\r\n", count, PLAYER_SAMPLE_RATE);
+    printf("%-24s %2s %4s %-3s %6s %7s %8s %7s %7s %8s %7s %6s %7s %6s\r\n", "asset", "ch", "kbps", "mod", "pkts",
+           "audioms", "RTx", "avg us", "max us", "cyc/pkt", "scratch", "stack", "framing", "get ns");
+
+    memset(&total, 0, sizeof(total));
+    for (i = 0; i < count; i++) {
+        if (!BenchRunAsset(&assets[i], &result)) {
+            printf("%-24s couldn't be opened.\r\n", assets[i].Name);
+            continue;
+        }
+        PrintResult(assets[i].Name, &result, mhz);
+
+        total.Packets += result.Packets;
+        total.Errors += result.Errors;
+        for (mode = 0; mode < DECODE_MODE_COUNT; mode++)
+            total.ModePackets[mode] += result.ModePackets[mode];
+        total.Bytes += result.Bytes;
+        total.Length += result.Length;
+        total.FetchUs += result.FetchUs;
+        total.Samples += result.Samples;
+        total.TotalUs += result.TotalUs;
+        total.DecodeUs += result.DecodeUs;
+        if (result.WorstUs > total.WorstUs)
+            total.WorstUs = result.WorstUs;
+        if (result.ScratchBytes > total.ScratchBytes)
+            total.ScratchBytes = result.ScratchBytes;
+        if (result.StackBytes > total.StackBytes)
+            total.StackBytes = result.StackBytes;
+    }
+    PrintResult("total", &total, mhz);
+}
+
+
+// A mixer source that plays stageInput over and over.  A copy is the least any real source costs.
+static int StageSource (void * context, int16_t * destination, int samples) {
+    (void)context;
+    memcpy(destination, stageInput, samples * sizeof(int16_t));
+    return samples;
+}
+
+
+// One row of the stage table: the time per sample in ns, and in cycles on the Pico, then a note.
+static void PrintStage (const char * name, uint64_t us, uint64_t samples, uint32_t mhz, const char * note) {
+    uint32_t ps = (uint32_t)(us * 1000000 / samples);
+
+    printf("%-32s %6u.%02u", name, (unsigned)(ps / 1000), (unsigned)(ps % 1000 / 10));
+    if (mhz) {
+        uint32_t cycles10 = (uint32_t)(us * mhz * 10 / samples);
+        printf(" %7u.%u", (unsigned)(cycles10 / 10), (unsigned)(cycles10 % 10));
+    } else {
+        printf(" %9s", "-");
+    }
+    printf(*note ? "  %s\r\n" : "%s\r\n", note);
+}
+
+
+// Time the mixer with 1 to MIXER_VOICES voices, at unity gain and at half.  Per voice, so each
+// row is what one more voice costs.  Uses the mixer's voices, so only run it while the player is idle.
+static void BenchMixer (uint32_t mhz) {
+    static const int16_t gains[2] = { MIXER_GAIN_UNITY, MIXER_GAIN_UNITY / 2 };
+    char name[40];
+    uint64_t start, us;
+    int voices, voice, gain, block;
+
+    for (voices = 1; voices <= MIXER_VOICES; voices++) {
+        for (gain = 0; gain < 2; gain++) {
+            for (voice = 0; voice < voices; voice++)
+                MixerStart(voice, StageSource, NULL, gains[gain], 0);
+            start = time_us_64();
+            for (block = 0; block < BENCH_STAGE_BLOCKS; block++)
+                MixerRender(stageOutput, PLAYER_BLOCK_SAMPLES);
+            us = time_us_64() - start;
+            for (voice = 0; voice < voices; voice++)
+                MixerStop(voice);
+
+            snprintf(name, sizeof(name), "mixer, %d voice%s, %s gain", voices, voices > 1 ? "s" : "",
+                     gain ? "Q15" : "unity");
+            PrintStage(name, us, (uint64_t)BENCH_STAGE_BLOCKS * PLAYER_BLOCK_SAMPLES * voices, mhz, "");
+        }
+    }
+}
+
+
+// Copy stageInput out at a gain, which mustn't take it past full scale.
+static void StageLevel (int16_t * destination, int gain) {
+    int i;
+    for (i = 0; i < PLAYER_BLOCK_SAMPLES; i++)
+        destination[i] = (int16_t)(stageInput[i] * gain);
+}
+
+
+// Time the post-processing chain as settings.h sets it up: on the quiet noise, where only the EQ
+// and volume do anything, and on it 12dB louder, where the limiter works on nearly every peak.
+// Starts the chain from silence again afterwards, so none of the noise is left in it.
+static void BenchPostProc (uint32_t mhz) {
+    bool wasEnabled = PostProcIsEnabled();
+    uint64_t start, us;
+    int loud, run, block;
+
+    PostProcEnable(true);
+    for (loud = 0; loud < 2; loud++) {
+        // It works in place, so each block is copied in fresh.  The first run times the copy alone,
+        // to take it off the second.
+        PostProcInit(PLAYER_SAMPLE_RATE);
+        us = 0;
+        for (run = 0; run < 2; run++) {
+            start = time_us_64();
+            for (block = 0; block < BENCH_STAGE_BLOCKS; block++) {
+                StageLevel(stageOutput, loud ? 4 : 1);
+                if (run)
+                    PostProcProcess(stageOutput, PLAYER_BLOCK_SAMPLES);
+            }
+            us = time_us_64() - start - us;
+        }
+        PrintStage(loud ? "post-processing, limiting" : "post-processing", us,
+                   (uint64_t)BENCH_STAGE_BLOCKS * PLAYER_BLOCK_SAMPLES, mhz, "");
+    }
+    PostProcInit(PLAYER_SAMPLE_RATE);
+    PostProcEnable(wasEnabled);
+}
+
+
+// SNR in dB of the resampler's output for the tone, against the sine that fits it best: a least
+// squares fit of sin and cos at BENCH_TONE_HZ, which takes care of the filter's delay and gain.
+static double ResamplerSnr (resampler_t * resampler, uint32_t inRate, uint32_t outRate) {
+    double ss = 0, cc = 0, sc = 0, xs = 0, xc = 0, xx = 0, a, b, signal, det;
+    uint32_t n = 0;
+    int block, i, count;
+
+    ResamplerReset(resampler);
+    for (block = 0; block <= BENCH_SNR_BLOCKS; block++) {
+        count = ResamplerProcess(resampler, stageTone, inRate / 50, stageOutput);
+        for (i = 0; i < count; i++, n++) {
+            double x = stageOutput[i], w = BENCH_TWO_PI * BENCH_TONE_HZ * n / outRate;
+            double s = sin(w), c = cos(w);
+            if (block == 0)
+                continue;
+            ss += s * s;
+            cc += c * c;
+            sc += s * c;
+            xs += x * s;
+            xc += x * c;
+            xx += x * x;
+        }
+    }
+
+    det = ss * cc - sc * sc;
+    a = (xs * cc - xc * sc) / det;
+    b = (xc * ss - xs * sc) / det;
+    signal = a * a * ss + 2 * a * b * sc + b * b * cc;
+    return 10 * log10(signal / (xx - signal));
+}
+
+
+// Whether resampling in place (see ResamplerInputOffset) gives the same output as from a separate
+// buffer, over a few blocks so the history is carried between them.
+static bool ResamplerInPlaceMatches (uint32_t inRate, uint32_t outRate) {
+    resampler_t apart, inPlace;
+    int block, count, offset, samples = inRate / 50;
+
+    ResamplerInit(&apart, inRate, outRate);
+    ResamplerInit(&inPlace, inRate, outRate);
+    for (block = 0; block < 3; block++) {
+        count = ResamplerProcess(&apart, stageTone, samples, stageOutput);
+        offset = ResamplerInputOffset(&inPlace, samples);
+        memcpy(stageInPlace + offset, stageTone, samples * sizeof(int16_t));
+        if (ResamplerProcess(&inPlace, stageInPlace + offset, samples, stageInPlace) != count ||
+            memcmp(stageInPlace, stageOutput, count * sizeof(int16_t)) != 0)
+            return false;
+    }
+    return true;
+}
+
+
+// Time the resampler at every ratio it covers, per output sample, on 20ms blocks of the tone, and
+// check its SNR and in-place output.
+static void BenchResampler (uint32_t mhz) {
+    static const uint32_t inRates[] = { 8000, 12000, 16000, 24000 };
+    static const uint32_t outRates[] = { 44100, 48000 };
+    resampler_t resampler;
+    char name[40], note[40];
+    uint64_t start, us, outSamples;
+    int in, out, block, i;
+
+    for (in = 0; in < 4; in++) {
+        for (i = 0; i < (int)inRates[in] / 50; i++)
+            stageTone[i] = (int16_t)lrint(16384 * sin(BENCH_TWO_PI * BENCH_TONE_HZ * i / inRates[in]));
+        for (out = 0; out < 2; out++) {
+            if (!ResamplerInit(&resampler, inRates[in], outRates[out]))
+                continue;
+            outSamples = 0;
+            start = time_us_64();
+            for (block = 0; block < BENCH_STAGE_BLOCKS; block++)
+                outSamples += ResamplerProcess(&resampler, stageTone, inRates[in] / 50, stageOutput);
+            us = time_us_64() - start;
+
+            snprintf(name, sizeof(name), "resampler, %u -> %u", (unsigned)inRates[in], (unsigned)outRates[out]);
+            snprintf(note, sizeof(note), "SNR %.1f dB, in place %s", ResamplerSnr(&resampler, inRates[in], outRates[out]),
+                     ResamplerInPlaceMatches(inRates[in], outRates[out]) ? "matches" : "DIFFERS");
+            PrintStage(name, us, outSamples, mhz, note);
+        }
+    }
+}
+
+
+#if defined(OPUS_CELT_M0PLUS) || defined(OPUS_SILK_M0PLUS)
+// One row of the kernel table: the time per call in us, and in cycles on the Pico, then a note.
+static void PrintKernel (const char * name, uint64_t us, uint32_t mhz, const char * note) {
+    uint32_t ns = (uint32_t)(us * 1000 / BENCH_KERNEL_CALLS);
+
+    printf("%-32s %6u.%02u", name, (unsigned)(ns / 1000), (unsigned)(ns % 1000 / 10));
+    if (mhz)
+        printf(" %9u", (unsigned)(us * mhz / BENCH_KERNEL_CALLS));
+    else
+        printf(" %9s", "-");
+    printf(*note ? "  %s\r\n" : "%s\r\n", note);
+}
+
+
+// A kernel's two rows, Opus' own version and the M0+ one, with how many times faster the M0+ one
+// is and whether it gave the same output.
+static void PrintKernelPair (const char * name, const uint64_t us[2], uint32_t mhz, bool same) {
+    char row[40], note[40];
+
+    snprintf(row, sizeof(row), "%s, Opus", name);
+    PrintKernel(row, us[0], mhz, "");
+    snprintf(row, sizeof(row), "%s, M0+", name);
+    snprintf(note, sizeof(note), "x%.2f, %s", us[1] ? (double)us[0] / us[1] : 0.0, same ? "same output" : "DIFFERS");
+    PrintKernel(row, us[1], mhz, note);
+}
+#endif
+
+
+#ifdef OPUS_CELT_M0PLUS
+// Time CELT's inverse MDCT for a 20ms frame, Opus' own and the M0+ one (see opus_celt_m0plus.c):
+// the long block of a normal frame, and the eight short blocks of a transient, as celt_decoder.c
+// calls them.  Per frame, on noise, BENCH_KERNEL_CALLS times each, and checked for the same output.
+static void BenchCelt (uint32_t mhz) {
+    static kiss_fft_scalar in[960];
+    static kiss_fft_scalar out[2][960 + 120];
+    const CELTMode * mode;
+    uint64_t start, us[2];
+    int error, transient, way, call, b, i;
+
+    mode = opus_custom_mode_create(48000, 960, &error);
+    if (mode == NULL)
+        return;
+    for (i = 0; i < 960; i++)
+        in[i] = (kiss_fft_scalar)stageInput[i % PLAYER_BLOCK_SAMPLES] * 4096;
+
+    for (transient = 0; transient < 2; transient++) {
+        int shift = transient ? mode->maxLM : 0;
+        int blocks = transient ? mode->nbShortMdcts : 1;
+        int size = transient ? mode->shortMdctSize : 0;
+
+        for (way = 0; way < 2; way++) {
+            memset(out[way], 0, sizeof(out[way]));
+            start = time_us_64();
+            for (call = 0; call < BENCH_KERNEL_CALLS; call++) {
+                for (b = 0; b < blocks; b++) {
+                    if (way)
+                        clt_mdct_backward_m0plus(&mode->mdct, in + b, out[way] + size * b, mode->window,
+                                                 mode->overlap, shift, blocks, 0);
+                    else
+                        clt_mdct_backward_c(&mode->mdct, in + b, out[way] + size * b, mode->window,
+                                            mode->overlap, shift, blocks, 0);
+                }
+            }
+            us[way] = time_us_64() - start;
+        }
+
+        PrintKernelPair(transient ? "CELT IMDCT 8x2.5ms" : "CELT IMDCT 20ms", us, mhz,
+                        memcmp(out[0], out[1], sizeof(out[0])) == 0);
+    }
+}
+#endif
+
+
+#ifdef OPUS_SILK_M0PLUS
+// A 20ms SILK frame at fs_kHz, with the pulses from the stage noise and a steady gain, so the state
+// can be decoded over and over: voiced with a 5ms pitch lag, or unvoiced.  8kHz has the order 10
+// filter and 16kHz the order 16 one.
+static void BenchSilkFrame (silk_decoder_state * state, silk_decoder_control * control, opus_int16 * pulses,
+                            int fs_kHz, bool voiced) {
+    static const opus_int16 ltp[LTP_ORDER] = { 1000, 3000, 6000, 3000, 1000 };
+    opus_int16 nlsf[MAX_LPC_ORDER];
+    int i, k;
+
+    silk_init_decoder(state);
+    state->nb_subfr = MAX_NB_SUBFR;
+    silk_decoder_set_fs(state, fs_kHz, 48000);
+    state->indices.signalType = voiced ? TYPE_VOICED : TYPE_UNVOICED;
+    state->prev_gain_Q16 = 1 << 20;
+
+    memset(control, 0, sizeof(*control));
+    for (i = 0; i < state->LPC_order; i++)
+        nlsf[i] = (opus_int16)((i + 1) * 32768 / (state->LPC_order + 1));
+    silk_NLSF2A(control->PredCoef_Q12[0], nlsf, state->LPC_order, 0);
+    memcpy(control->PredCoef_Q12[1], control->PredCoef_Q12[0], sizeof(control->PredCoef_Q12[0]));
+    for (k = 0; k < MAX_NB_SUBFR; k++) {
+        control->pitchL[k] = 5 * fs_kHz;
+        control->Gains_Q16[k] = 1 << 20;
+        memcpy(&control->LTPCoef_Q14[k * LTP_ORDER], ltp, sizeof(ltp));
+    }
+    control->LTP_scale_Q14 = 15565;
+
+    for (i = 0; i < state->frame_length; i++)
+        pulses[i] = (opus_int16)(stageInput[i] >> 11);
+}
+
+
+// Time SILK's synthesis per 20ms frame and its NLSF to LPC conversion per call, Opus' own and the M0+
+// ones (see opus_silk_m0plus.c), at both LPC orders, BENCH_KERNEL_CALLS times each.  Both decode from
+// the same state, so they should end with the same output and state.
+static void BenchSilk (uint32_t mhz) {
+    static silk_decoder_state state[2];
+    static silk_decoder_control control[2];
+    static opus_int16 pulses[MAX_FRAME_LENGTH], xq[2][MAX_FRAME_LENGTH];
+    opus_int16 nlsf[MAX_LPC_ORDER], a[2][MAX_LPC_ORDER];
+    char name[40];
+    uint64_t start, us[2];
+    int wide, voiced, way, call, i;
+
+    for (wide = 0; wide < 2; wide++) {
+        int fs_kHz = wide ? 16 : 8;
+
+        for (voiced = 1; voiced >= 0; voiced--) {
+            BenchSilkFrame(&state[0], &control[0], pulses, fs_kHz, voiced);
+            state[1] = state[0];
+            control[1] = control[0];
+            for (way = 0; way < 2; way++) {
+                start = time_us_64();
+                for (call = 0; call < BENCH_KERNEL_CALLS; call++) {
+                    if (way)
+                        silk_decode_core_m0plus(&state[way], &control[way], xq[way], pulses, 0);
+                    else
+                        silk_decode_core(&state[way], &control[way], xq[way], pulses, 0);
+                }
+                us[way] = time_us_64() - start;
+            }
+            snprintf(name, sizeof(name), "SILK 20ms %dkHz %s", fs_kHz, voiced ? "voiced" : "unvoiced");
+            PrintKernelPair(name, us, mhz, memcmp(xq[0], xq[1], sizeof(xq[0])) == 0 &&
+                            memcmp(&state[0], &state[1], sizeof(state[0])) == 0);
+        }
+
+        for (i = 0; i < state[0].LPC_order; i++)
+            nlsf[i] = (opus_int16)((i + 1) * 32768 / (state[0].LPC_order + 1) + stageInput[i] / 64);
+        for (way = 0; way < 2; way++) {
+            start = time_us_64();
+            for (call = 0; call < BENCH_KERNEL_CALLS; call++) {
+                if (way)
+                    silk_NLSF2A_m0plus(a[way], nlsf, state[0].LPC_order, 0);
+                else
+                    silk_NLSF2A(a[way], nlsf, state[0].LPC_order, 0);
+            }
+            us[way] = time_us_64() - start;
+        }
+        snprintf(name, sizeof(name), "SILK NLSF2A order %d", state[0].LPC_order);
+        PrintKernelPair(name, us, mhz, memcmp(a[0], a[1], state[0].LPC_order * sizeof(opus_int16)) == 0);
+    }
+}
+#endif
+
+
+// Time each stage of the output chain after the decoder.  ns and cycles are per sample: per voice
+// for the mixer, and per output sample for the resampler.
+void BenchRunStages (void) {
+    uint32_t mhz = ClockMhz(), seed = 1;
+    int i;
+
+    for (i = 0; i < PLAYER_BLOCK_SAMPLES; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        stageInput[i] = (int16_t)((int32_t)seed >> 18);    // About -12dBFS.
+    }
+
+    printf("%-32s %9s %9s\r\n", "stage", "ns/smp", "cyc/smp");
+    BenchMixer(mhz);
+    BenchPostProc(mhz);
+    BenchResampler(mhz);
+
+#if defined(OPUS_CELT_M0PLUS) || defined(OPUS_SILK_M0PLUS)
+    printf("\r\n%-32s %9s %9s\r\n", "kernel", "us/call", "cyc/call");
+#endif
+#ifdef OPUS_CELT_M0PLUS
+    BenchCelt(mhz);
+#endif
+#ifdef OPUS_SILK_M0PLUS
+    BenchSilk(mhz);
+#endif
+}
+
+
+// The assets from tools/make_bench_assets.py if they were built in, otherwise the sample.
+void BenchRunDefault (void) {
+#ifdef BENCH_ASSETS
+    BenchRun(BenchAssets, BENCH_ASSET_COUNT);
+#else
+    static const benchAsset_t sample = { "sample", Sample, SAMPLE_LENGTH };
+    BenchRun(&sample, 1);
+#endif
+}
+
+
+// Ask for a run from another task.  The app task runs it next time nothing is playing.
+void BenchRequest (void) {
+    benchRequested = true;
+    PlayerWake();
+}
+
+
+// Run the bench if one was asked for.  Call only while the player is idle: it shares the
+// decoder pool and the scratch arena.  Returns true if it ran.
+bool BenchService (void) {
+    if (!benchRequested)
+        return false;
+    benchRequested = false;
+    BenchRunDefault();
+    BenchRunStages();
+    return true;
+}
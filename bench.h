@@ -0,0 +1,65 @@
+// Bench Header File
+// Decode throughput benchmark.  Each asset is read with ogg_stripper, or the compact stream reader
+// (compact_stream.h), and decoded with opus_decode the way the player does it (mono, at
+// PLAYER_SAMPLE_RATE, through a pool decoder and the scratch arena), as fast as it will go.  A line
+// per asset gives the Opus modes its packets used, the real-time factor, time per packet (and cycles,
+// on the Pico), the most Opus scratch and stack a decode took, and what the container costs in bytes
+// and fetch time.  The Pico (the `bench` console command) and the host build (`-b`) print the same table.
+//
+// BenchRunStages then times the rest of the output chain on synthetic audio, per sample: the mixer
+// for each number of voices, post-processing with and without limiting, and the resampler at each
+// ratio it covers.  The resampler is checked too: its SNR on a 1kHz tone, and whether working in
+// place gives the same output.  With OPUS_CELT_M0PLUS or OPUS_SILK_M0PLUS a last table times the
+// codec kernels they replace per call (CELT's inverse MDCT, SILK's synthesis and NLSF to LPC), Opus'
+// own against the M0+ versions, and checks they give the same output.
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "decode_stats.h"
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#define BENCH_STACK_FILL 0xA5
+#define BENCH_FETCH_PASSES 8    // Times each asset's packets are fetched without decoding, to time the container.
+#define BENCH_STAGE_BLOCKS 2000 // Blocks of PLAYER_BLOCK_SAMPLES each stage is timed over.
+#define BENCH_TONE_HZ 1000      // Test tone for the resampler.  A 20ms block holds a whole number of cycles.
+#define BENCH_SNR_BLOCKS 8      // Blocks of it the SNR is measured over, after one to fill the filter.
+#define BENCH_KERNEL_CALLS 200  // Calls each codec kernel is timed over.
+#ifdef OPUS_SCRATCH_ARENA
+#define BENCH_STACK_PROBE 4096  // Stack painted below the decode call.  Opus' temporaries are in the arena.
+#else
+#define BENCH_STACK_PROBE 32768 // With alloca they're on the stack too.
+#endif
+
+typedef struct {
+    const char * Name;
+    const void * Data;
+    size_t Length;
+} benchAsset_t;
+
+typedef struct {
+    uint32_t Packets;
+    uint32_t Errors;            // Packets opus_decode rejected.
+    uint32_t ModePackets[DECODE_MODE_COUNT];
+    uint32_t Bytes;             // Opus packet bytes, without the container's framing.
+    uint32_t Length;            // The whole asset.
+    int Channels;               // From the ID header.
+    uint64_t Samples;           // Decoded, at PLAYER_SAMPLE_RATE.
+    uint64_t TotalUs;           // Reading and decoding.
+    uint64_t FetchUs;           // All BENCH_FETCH_PASSES of reading alone.
+    uint64_t DecodeUs;          // Just opus_decode.
+    uint32_t WorstUs;           // Slowest opus_decode.
+    size_t ScratchBytes;
+    size_t StackBytes;
+} benchResult_t;
+
+bool BenchRunAsset (const benchAsset_t * asset, benchResult_t * result);
+void BenchRun (const benchAsset_t * assets, int count);
+void BenchRunDefault (void);
+void BenchRunStages (void);
+void BenchRequest (void);
+bool BenchService (void);
+
+#endif
@@ -0,0 +1,233 @@
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "hardware/clocks.h"
+#include "hardware/structs/systick.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "settings.h"
+#include "audio_out.h"
+#include "clock_governor.h"
+
+static const uint32_t candidatePoints[] = CLOCK_GOVERNOR_POINTS;
+#define CANDIDATE_COUNT (sizeof(candidatePoints) / sizeof(candidatePoints[0]))
+
+static uint32_t points[CANDIDATE_COUNT]; // The candidates the PLL can actually hit, slowest first.
+static uint32_t pointCount = 0;
+static uint32_t currentPoint = 0;
+static uint32_t unreachable[CANDIDATE_COUNT]; // Candidates the PLL can't hit, for `governor`.
+static uint32_t unreachableCount = 0;
+
+static bool enabled = CLOCK_GOVERNOR;
+static uint32_t loadAvg = 0;            // Smoothed load, permille of buffer play time.
+static uint32_t lowBuffers = 0;         // Consecutive buffers the load has been low enough to step down.
+static uint32_t idleSince = 0;
+static volatile uint32_t requestedKhz = 0; // Set from the console, applied by the decode loop.
+
+static clockGovernorEvent_t eventLog[CLOCK_GOVERNOR_LOG];
+static uint32_t eventNext = 0;
+
+static const char * const reasonNames[] = { "load", "slack", "load", "idle", "manual" };
+
+
+// set_sys_clock_khz moves clk_peri (the UARTs and SPI) along with clk_sys.  Put it back on PLL_USB,
+// at the 48MHz it's had since ClockGovernorInit, so anything set up against it keeps its rate at every
+// point.  clk_usb comes from PLL_USB too and shouldn't move, but if it ever has, it's put back as well.
+static void FixPeripheralClocks (void) {
+    clock_configure(clk_peri, 0, CLOCKS_CLK_PERI_CTRL_AUXSRC_VALUE_CLKSRC_PLL_USB, 48 * MHZ, 48 * MHZ);
+    if (clock_get_hz(clk_usb) != 48 * MHZ)
+        clock_configure(clk_usb, 0, CLOCKS_CLK_USB_CTRL_AUXSRC_VALUE_CLKSRC_PLL_USB, 48 * MHZ, 48 * MHZ);
+}
+
+
+// Switch clk_sys to a new operating point, then fix up everything derived from it.
+// The FreeRTOS tick comes from SysTick on configTICK_CORE, and SysTick is per-core, so we hop over
+// to that core for the change.  The PLL relock takes a while, with clk_sys on PLL_USB meanwhile, so
+// only the scheduler is held off for it; interrupts carry on.  I2S is held for the switch, since its
+// divider is only right for one clk_sys.
+static void ApplyPoint (uint32_t point, uint8_t reason, int32_t slackUs) {
+    UBaseType_t affinity;
+    clockGovernorEvent_t *event;
+
+    if (point == currentPoint)
+        return;
+
+    affinity = vTaskCoreAffinityGet(NULL);
+    vTaskCoreAffinitySet(NULL, 1 << configTICK_CORE);
+    while (get_core_num() != configTICK_CORE)
+        taskYIELD();
+
+    vTaskSuspendAll();
+    AudioOutHold();
+    set_sys_clock_khz(points[point], true);
+    FixPeripheralClocks();
+    AudioOutRetime();
+    taskENTER_CRITICAL();
+    systick_hw->rvr = (clock_get_hz(clk_sys) / configTICK_RATE_HZ) - 1;
+    systick_hw->cvr = 0;
+    taskEXIT_CRITICAL();
+    xTaskResumeAll();
+
+    vTaskCoreAffinitySet(NULL, affinity);
+
+    event = &eventLog[eventNext++ % CLOCK_GOVERNOR_LOG];
+    event->TimeUs = time_us_64();
+    event->FromKhz = points[currentPoint];
+    event->ToKhz = points[point];
+    event->LoadPermille = (uint16_t)loadAvg;
+    event->Reason = reason;
+    event->SlackUs = slackUs;
+
+    currentPoint = point;
+    lowBuffers = 0;
+}
+
+
+static void ApplyRequest (void) {
+    uint32_t i, khz = requestedKhz;
+    if (khz) {
+        requestedKhz = 0;
+        for (i = 0; i < pointCount; i++) {
+            if (points[i] == khz)
+                ApplyPoint(i, GOVERNOR_MANUAL, 0);
+        }
+    }
+}
+
+
+// Work out which operating points are usable, and start at CLOCK_SPEED_KHZ, which has to be one of
+// them.  With the governor off, CLOCK_SPEED_KHZ is the only point.  Call this once, before the audio
+// starts.  It runs before stdio is up, so candidates the PLL can't hit are only recorded here, and
+// `governor` lists them.  A bad CLOCK_SPEED_KHZ is a build mistake, so it panics.
+void ClockGovernorInit (void) {
+    uint32_t i;
+    uint vco, postdiv1, postdiv2;
+
+#if CLOCK_GOVERNOR
+    // Keep the points the PLL can hit exactly, sorted slowest first.
+    for (i = 0; i < CANDIDATE_COUNT; i++) {
+        if (check_sys_clock_khz(candidatePoints[i], &vco, &postdiv1, &postdiv2)) {
+            uint32_t j;
+            for (j = pointCount; j > 0 && points[j - 1] > candidatePoints[i]; j--)
+                points[j] = points[j - 1];
+            points[j] = candidatePoints[i];
+            pointCount++;
+        } else {
+            unreachable[unreachableCount++] = candidatePoints[i];
+        }
+    }
+#else
+    if (check_sys_clock_khz(CLOCK_SPEED_KHZ, &vco, &postdiv1, &postdiv2))
+        points[pointCount++] = CLOCK_SPEED_KHZ;
+#endif
+
+    for (i = 0; i < pointCount && points[i] != CLOCK_SPEED_KHZ; i++)
+        ;
+    if (i == pointCount)
+        panic("Governor: CLOCK_SPEED_KHZ (%u kHz) isn't a reachable point in CLOCK_GOVERNOR_POINTS.\n",
+              (unsigned)CLOCK_SPEED_KHZ);
+    currentPoint = i;
+    set_sys_clock_khz(points[currentPoint], true);
+    FixPeripheralClocks();
+    idleSince = time_us_32();
+}
+
+
+// Feed the governor one buffer's worth of measurements: how long we were busy producing it, how
+// long it plays for, and the slack left when it was handed over.
+void ClockGovernorUpdate (uint32_t busyUs, uint32_t bufferUs, int32_t slackUs) {
+    uint32_t load, predicted;
+
+    ApplyRequest();
+    idleSince = time_us_32();
+    if (!enabled || bufferUs == 0)
+        return;
+
+    load = (uint32_t)(((uint64_t)busyUs * 1000) / bufferUs);
+    loadAvg = (loadAvg * 7 + load) / 8;
+
+    // Running late is the one thing we can't allow.  Go straight to the top.
+    if (slackUs != AUDIO_OUT_NO_DEADLINE && slackUs < 2 * AUDIO_OUT_GUARD_US) {
+        ApplyPoint(pointCount - 1, GOVERNOR_UP_SLACK, slackUs);
+        return;
+    }
+
+    if (loadAvg > CLOCK_GOVERNOR_UP_PERMILLE) {
+        if (currentPoint + 1 < pointCount)
+            ApplyPoint(currentPoint + 1, GOVERNOR_UP_LOAD, slackUs);
+        return;
+    }
+
+    // Only step down if the load scaled to the next point down stays under the threshold for a while.
+    if (currentPoint > 0) {
+        predicted = (uint32_t)(((uint64_t)loadAvg * points[currentPoint]) / points[currentPoint - 1]);
+        if (predicted < CLOCK_GOVERNOR_DOWN_PERMILLE) {
+            if (++lowBuffers >= CLOCK_GOVERNOR_HOLD_BUFFERS)
+                ApplyPoint(currentPoint - 1, GOVERNOR_DOWN_LOAD, slackUs);
+        } else {
+            lowBuffers = 0;
+        }
+    }
+}
+
+
+// Call from the decode loop when there's nothing to play.  Drops to the slowest point after a second.
+void ClockGovernorIdle (void) {
+    ApplyRequest();
+    if (enabled && currentPoint > 0 && time_us_32() - idleSince > 1000000) {
+        loadAvg = 0;
+        ApplyPoint(0, GOVERNOR_DOWN_IDLE, AUDIO_OUT_NO_DEADLINE);
+    }
+}
+
+
+void ClockGovernorEnable (bool enable) {
+    enabled = enable;
+}
+
+
+// Ask for a fixed operating point.  It's applied by the decode loop on its next pass.
+bool ClockGovernorSetKhz (uint32_t khz) {
+    uint32_t i;
+    for (i = 0; i < pointCount; i++) {
+        if (points[i] == khz) {
+            requestedKhz = khz;
+            return true;
+        }
+    }
+    return false;
+}
+
+
+uint32_t ClockGovernorKhz (void) {
+    return points[currentPoint];
+}
+
+
+void ClockGovernorPrint (void) {
+    uint32_t i, first;
+
+    printf("Governor %s at %u kHz, load %u.%u%%.  Points:", enabled ? "on" : "off",
+           (unsigned)points[currentPoint], (unsigned)(loadAvg / 10), (unsigned)(loadAvg % 10));
+    for (i = 0; i < pointCount; i++)
+        printf(" %u", (unsigned)points[i]);
+    printf("\r\n");
+    if (unreachableCount) {
+        printf("  Not reachable, skipped:");
+        for (i = 0; i < unreachableCount; i++)
+            printf(" %u", (unsigned)unreachable[i]);
+        printf("\r\n");
+    }
+
+    first = eventNext > CLOCK_GOVERNOR_LOG ? eventNext - CLOCK_GOVERNOR_LOG : 0;
+    for (i = first; i < eventNext; i++) {
+        clockGovernorEvent_t *event = &eventLog[i % CLOCK_GOVERNOR_LOG];
+        printf("  %u ms: %u -> %u kHz (%s), load %u.%u%%", (unsigned)(event->TimeUs / 1000),
+               (unsigned)event->FromKhz, (unsigned)event->ToKhz, reasonNames[event->Reason],
+               (unsigned)(event->LoadPermille / 10), (unsigned)(event->LoadPermille % 10));
+        if (event->SlackUs != AUDIO_OUT_NO_DEADLINE)
+            printf(", slack %d us", (int)event->SlackUs);
+        printf("\r\n");
+    }
+}
@@ -0,0 +1,39 @@
+// Clock Governor Header File
+// Steps the system clock between a few operating points based on how much of each buffer's play
+// time the decode loop actually spends working.  I2S is held across every change, then its PIO
+// divider and the FreeRTOS tick are re-derived from the new clk_sys.  clk_peri is kept on PLL_USB,
+// so the peripherals that run from it never see the change.
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifndef CLOCK_GOVERNOR_H
+#define CLOCK_GOVERNOR_H
+
+#define CLOCK_GOVERNOR_LOG 16 // How many recent decisions to remember.
+
+enum {
+    GOVERNOR_UP_LOAD = 0,   // Smoothed load over the up threshold.
+    GOVERNOR_UP_SLACK,      // A buffer came close to (or missed) its play-out time.
+    GOVERNOR_DOWN_LOAD,     // Load would still be under the down threshold one point lower.
+    GOVERNOR_DOWN_IDLE,     // Nothing playing.
+    GOVERNOR_MANUAL         // Set from the console.
+};
+
+typedef struct {
+    uint64_t TimeUs;
+    uint32_t FromKhz;
+    uint32_t ToKhz;
+    uint16_t LoadPermille;  // Smoothed load at the time of the decision.
+    uint8_t Reason;
+    int32_t SlackUs;
+} clockGovernorEvent_t;
+
+void ClockGovernorInit (void);
+void ClockGovernorUpdate (uint32_t busyUs, uint32_t bufferUs, int32_t slackUs);
+void ClockGovernorIdle (void);
+void ClockGovernorEnable (bool enable);
+bool ClockGovernorSetKhz (uint32_t khz);
+uint32_t ClockGovernorKhz (void);
+void ClockGovernorPrint (void);
+
+#endif
@@ -0,0 +1,124 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "compact_stream.h"
+#include "ogg_stripper.h"
+
+
+// Check the header and seek table fit, and get ready to read the first packet.
+bool CompactReaderOpen (compactReader_t * reader, const void * data, size_t length) {
+    compactHeader_t *header = &reader->Header;
+
+    reader->Data = NULL;
+    if (!CompactIsStream(data, length))
+        return false;
+    memcpy(header, data, sizeof(*header));
+    if (header->Version != COMPACT_VERSION ||
+        sizeof(compactHeader_t) + (size_t)header->SeekCount * sizeof(compactSeekPoint_t) > header->DataOffset ||
+        header->DataOffset > length || header->DataLength > length - header->DataOffset) {
+        printf("ERR! Bad compact stream header.\r\n");
+        return false;
+    }
+
+    reader->Data = data;
+    reader->Seek = reader->Data + sizeof(compactHeader_t);
+    reader->End = header->DataOffset + header->DataLength;
+    CompactReaderRewind(reader);
+    return true;
+}
+
+
+static compactSeekPoint_t SeekPoint (const compactReader_t * reader, uint32_t index) {
+    compactSeekPoint_t point;
+    memcpy(&point, reader->Seek + index * sizeof(compactSeekPoint_t), sizeof(point));
+    return point;
+}
+
+
+// Point packet at the next packet, in place, and return its length.  OGG_STRIP_EOF after the last.
+// A packet can be empty, which Opus takes to mean a lost one; that's 0, not the end.
+// A length under COMPACT_SHORT is the first byte itself.  Up to COMPACT_LONG, the first byte's low
+// bits and the second byte add 256s and units to COMPACT_SHORT.  COMPACT_LONG is followed by a
+// little-endian 16-bit length, on top of the longest two-byte one.
+int CompactReaderNextPacket (compactReader_t * reader, const uint8_t ** packet) {
+    const uint8_t *p;
+    size_t left;
+    uint32_t length;
+
+    if (reader->Data == NULL)
+        return OGG_STRIP_NULL_SOURCE;
+    if (reader->Pointer >= reader->End)
+        return OGG_STRIP_EOF;
+
+    p = reader->Data + reader->Pointer;
+    left = reader->End - reader->Pointer;
+    length = p[0];
+    if (length < COMPACT_SHORT) {
+        p += 1;
+    } else if (length < COMPACT_LONG && left >= 2) {
+        length = COMPACT_SHORT + ((length - COMPACT_SHORT) << 8) + p[1];
+        p += 2;
+    } else if (length == COMPACT_LONG && left >= 3) {
+        length = COMPACT_SHORT + ((COMPACT_LONG - COMPACT_SHORT) << 8) + (p[1] | (uint32_t)p[2] << 8);
+        p += 3;
+    } else {
+        reader->Pointer = reader->End;
+        return OGG_STRIP_LEN_SHORT;
+    }
+
+    left -= (size_t)(p - (reader->Data + reader->Pointer));
+    if (length > left) {
+        reader->Pointer = reader->End;
+        return OGG_STRIP_LEN_SHORT;
+    }
+    *packet = p;
+    reader->Pointer = (size_t)(p - reader->Data) + length;
+    reader->Packet++;
+    return (int)length;
+}
+
+
+// The same as OggReaderGetNextPacket, copying the packet out.  Longer packets are cut to maxLength.
+int CompactReaderGetNextPacket (compactReader_t * reader, uint8_t * destination, size_t maxLength) {
+    const uint8_t *packet;
+    int length = CompactReaderNextPacket(reader, &packet);
+
+    if (length > 0) {
+        if ((size_t)length > maxLength)
+            length = (int)maxLength;
+        memcpy(destination, packet, (size_t)length);
+    }
+    return length;
+}
+
+
+// Go to the last seek point at or before sample (counted like a granule position), and return the
+// sample it's at.  Decoding from there needs some pre-roll before the audio is right again: Opus
+// recommends 80ms, which is why the converter puts seek points a second or so apart.
+uint32_t CompactReaderSeek (compactReader_t * reader, uint32_t sample) {
+    uint32_t low = 0, high = reader->Header.SeekCount, middle;
+    compactSeekPoint_t point;
+
+    // The last point whose Sample <= sample.
+    while (low < high) {
+        middle = low + (high - low) / 2;
+        if (SeekPoint(reader, middle).Sample <= sample)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    if (low == 0) {
+        CompactReaderRewind(reader);
+        return 0;
+    }
+    point = SeekPoint(reader, low - 1);
+    reader->Pointer = reader->Header.DataOffset + point.Offset;
+    reader->Packet = low * reader->Header.SeekInterval;
+    return point.Sample;
+}
+
+
+void CompactReaderRewind (compactReader_t * reader) {
+    reader->Pointer = reader->Header.DataOffset;
+    reader->Packet = 0;
+}
@@ -0,0 +1,71 @@
+// Compact Stream Header File
+// A container for Opus packets meant to be read in place from flash, made from Ogg Opus by
+// tools/opus_compact.py.  The stream info the player needs is in a fixed header up front, then a
+// sparse seek table, then the packets back to back, each after its length as a prefix varint: one
+// byte for lengths under 240, which is nearly every packet, two under 4080 and three above (see
+// CompactReaderNextPacket).  There are no pages, lacing or CRCs to read past, and packets can be any
+// length.  The reader hands out pointers into the stream instead of copying, so Opus decodes straight
+// from it.  Errors are ogg_stripper's, so the two can be used the same way.
+// A stream can sit at any address, for instance after an odd-length clip in a bundle packed with
+// --align 1.  The M0+ faults on unaligned word loads, so the header is copied into the reader and
+// seek points are copied out one at a time; the packets are only ever read a byte at a time.
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#ifndef COMPACT_STREAM_H
+#define COMPACT_STREAM_H
+
+#define COMPACT_MAGIC 0x314B504F // "OPK1"
+#define COMPACT_VERSION 1
+#define COMPACT_SHORT 0xF0      // Lengths below this are one byte.
+#define COMPACT_LONG 0xFF       // Two-byte lengths start with COMPACT_SHORT up to this, three-byte with this.
+
+typedef struct {
+    uint32_t Magic;
+    uint8_t Version;
+    uint8_t Channels;
+    uint16_t PreSkip;           // At 48kHz, as in OpusHead.
+    uint32_t InputRate;
+    uint32_t Samples;           // At 48kHz: the last granule position, less the pre-skip.
+    uint32_t PacketCount;
+    uint32_t DataOffset;        // Of the first packet's length, from the start of the stream.
+    uint32_t DataLength;
+    uint16_t SeekInterval;      // Packets between seek points.
+    uint16_t SeekCount;
+} compactHeader_t;
+
+// Seek point n is where packet (n + 1) * SeekInterval starts; the first packet needs no seek point.
+// Sample counts from the start of decoding, pre-skip included, like a granule position.  Offset is
+// from DataOffset.
+typedef struct {
+    uint32_t Sample;
+    uint32_t Offset;
+} compactSeekPoint_t;
+
+typedef struct {
+    const uint8_t * Data;       // NULL if nothing's open.
+    compactHeader_t Header;     // A copy, since the stream might not be aligned.
+    const uint8_t * Seek;       // The compactSeekPoint_t table, likewise.
+    size_t Pointer;             // The next packet's length.
+    size_t End;
+    uint32_t Packet;            // The next packet's number.
+} compactReader_t;
+
+// Whether a clip is a compact stream rather than Ogg.
+static inline bool CompactIsStream (const void * data, size_t length) {
+    uint32_t magic;
+    if (length < sizeof(compactHeader_t))
+        return false;
+    memcpy(&magic, data, sizeof(magic));
+    return magic == COMPACT_MAGIC;
+}
+
+bool CompactReaderOpen (compactReader_t * reader, const void * data, size_t length);
+int CompactReaderNextPacket (compactReader_t * reader, const uint8_t ** packet);
+int CompactReaderGetNextPacket (compactReader_t * reader, uint8_t * destination, size_t maxLength);
+uint32_t CompactReaderSeek (compactReader_t * reader, uint32_t sample);
+void CompactReaderRewind (compactReader_t * reader);
+
+#endif
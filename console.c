@@ -0,0 +1,326 @@
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "asset_bundle.h"
+#include "audio_out.h"
+#include "bench.h"
+#include "clock_governor.h"
+#include "console.h"
+#include "cpu_stats.h"
+#include "decode_stats.h"
+#include "decoder_pool.h"
+#include "flash_stream.h"
+#include "hot_profile.h"
+#include "ogg_data.h"
+#include "opus_scratch.h"
+#include "pcm_cache.h"
+#include "phrase.h"
+#include "player.h"
+#include "postproc.h"
+
+typedef struct {
+    const char * Name;
+    const char * Help;
+    void (*Handler) (const char * args);
+} consoleCommand_t;
+
+static void CommandHelp (const char * args);
+static void CommandTasks (const char * args);
+static void CommandScratch (const char * args);
+static void CommandDecode (const char * args);
+static void CommandUnderruns (const char * args);
+static void CommandGovernor (const char * args);
+static void CommandPlay (const char * args);
+static void CommandCache (const char * args);
+static void CommandDecoders (const char * args);
+static void CommandVolume (const char * args);
+static void CommandQueue (const char * args);
+static void CommandSay (const char * args);
+static void CommandClips (const char * args);
+static void CommandProfile (const char * args);
+static void CommandXip (const char * args);
+static void CommandBench (const char * args);
+
+static const consoleCommand_t consoleCommands[] = {
+    { "help", "List the commands.", CommandHelp },
+    { "tasks", "Per-task CPU usage and stack high-water. 'reset' zeroes.", CommandTasks },
+    { "scratch", "Opus scratch arena high-water mark.", CommandScratch },
+    { "decode", "Decode time histogram and deadline slack per Opus mode. 'reset' zeroes.", CommandDecode },
+    { "underruns", "Underruns, concealment, I2S parking and the last few underruns. 'reset' zeroes.", CommandUnderruns },
+    { "governor", "Clock governor state and recent decisions. 'on', 'off' or a kHz point to pin it.", CommandGovernor },
+    { "play", "Play the sample on a mixer voice, over whatever's playing.  'play [voice] [gain %]'.", CommandPlay },
+    { "queue", "Queue the sample to follow gaplessly on a voice.  'queue [voice]'.", CommandQueue },
+    { "say", "Play a phrase.  'say clip [join-ms clip]...', by ID or bundle name, join negative to crossfade.", CommandSay },
+    { "clips", "List the clips in the asset bundle.", CommandClips },
+    { "cache", "PCM cache contents and hit rate.  'clear' empties it.", CommandCache },
+    { "volume", "Post-processing state.  'volume percent [ramp-ms]' ramps the volume, 'on'/'off' bypass.", CommandVolume },
+    { "decoders", "Decoder pool use, and how often decoders were reset or re-initialised.", CommandDecoders },
+    { "profile", "Dump the PCs sampled during decode, for tools/hot_placement.py.  'reset' clears them.", CommandProfile },
+    { "xip", "XIP cache hit rate and flash stream read-ahead.  'reset' zeroes.", CommandXip },
+    { "bench", "Decode every bench asset flat out and print the throughput table.  Runs once playback stops.", CommandBench },
+};
+
+static char lineBuf[CONSOLE_LINE_LEN];
+static size_t lineLen = 0;
+
+
+static void CommandHelp (const char * args) {
+    size_t i;
+    (void)args;
+    for (i = 0; i < sizeof(consoleCommands) / sizeof(consoleCommands[0]); i++)
+        printf("%-10s %s\r\n", consoleCommands[i].Name, consoleCommands[i].Help);
+}
+
+
+static void CommandTasks (const char * args) {
+    if (strcmp(args, "reset") == 0) {
+        CpuStatsReset();
+        printf("Task stats reset.\r\n");
+    } else {
+        CpuStatsPrint();
+    }
+}
+
+
+static void CommandScratch (const char * args) {
+    (void)args;
+    if (OpusScratchSize())
+        printf("Opus scratch: %u of %u bytes used, guard %s.\r\n", (unsigned)OpusScratchHighWater(),
+               (unsigned)OpusScratchSize(), OpusScratchCheck() ? "intact" : "OVERWRITTEN");
+    else
+        printf("Opus scratch arena not in use (built with alloca).\r\n");
+}
+
+
+static void CommandDecode (const char * args) {
+    if (strcmp(args, "reset") == 0) {
+        DecodeStatsReset();
+        printf("Decode stats reset.\r\n");
+    } else {
+        DecodeStatsPrint();
+    }
+}
+
+
+static void CommandUnderruns (const char * args) {
+    if (strcmp(args, "reset") == 0) {
+        AudioOutResetUnderruns();
+        printf("Underrun stats reset.\r\n");
+    } else {
+        AudioOutPrintUnderruns();
+        printf("%u late packets concealed, %u DTX packets played as silence.\r\n", (unsigned)PlayerLateCount(),
+               (unsigned)PlayerDtxCount());
+    }
+}
+
+
+static void CommandGovernor (const char * args) {
+    unsigned long khz;
+
+    if (strcmp(args, "on") == 0) {
+        ClockGovernorEnable(true);
+    } else if (strcmp(args, "off") == 0) {
+        ClockGovernorEnable(false);
+    } else if (*args) {
+        khz = strtoul(args, NULL, 10);
+        ClockGovernorEnable(false);
+        if (!ClockGovernorSetKhz((uint32_t)khz)) {
+            printf("%lu kHz isn't one of the operating points.\r\n", khz);
+            return;
+        }
+    }
+    ClockGovernorPrint();
+}
+
+
+static void CommandPlay (const char * args) {
+    char * end;
+    unsigned long voice = 1, percent = 100;
+
+    if (*args) {
+        voice = strtoul(args, &end, 10);
+        if (*end)
+            percent = strtoul(end, NULL, 10);
+    }
+    if (percent > 100)
+        percent = 100;
+    if (!PlayerRequest((int)voice, SAMPLE_ID, (int16_t)(percent * MIXER_GAIN_UNITY / 100), false))
+        printf("Voice %lu doesn't exist.  There are %d.\r\n", voice, MIXER_VOICES);
+}
+
+
+static void CommandQueue (const char * args) {
+    unsigned long voice = 0;
+
+    if (*args)
+        voice = strtoul(args, NULL, 10);
+    if (!PlayerRequest((int)voice, SAMPLE_ID, MIXER_GAIN_UNITY, true))
+        printf("Voice %lu doesn't exist.  There are %d.\r\n", voice, MIXER_VOICES);
+}
+
+
+static void CommandSay (const char * args) {
+    phraseFragment_t fragments[PHRASE_MAX_FRAGMENTS];
+    char name[CONSOLE_LINE_LEN];
+    size_t count = 0, length;
+    char * end;
+
+    while (*args && count < PHRASE_MAX_FRAGMENTS) {
+        if (count)
+            fragments[count].JoinMs = (int16_t)strtol(args, &end, 10);
+        else
+            fragments[count].JoinMs = 0;
+        if (count && end == args)
+            break;
+        if (count)
+            args = end;
+        while (*args == ' ')
+            args++;
+        length = strcspn(args, " ");
+        if (!length)
+            break;
+        if (strspn(args, "0123456789") == length) {
+            fragments[count].Id = strtoul(args, NULL, 10);
+        } else {
+            // Not all digits, so the name of a clip in the asset bundle.  "10_sec" is a name.
+            memcpy(name, args, length);
+            name[length] = '\0';
+            fragments[count].Id = AssetBundleId(name);
+        }
+        args += length;
+        count++;
+    }
+
+    if (!count || !PhraseRequest(0, fragments, count))
+        printf("Couldn't start that phrase.\r\n");
+}
+
+
+static void CommandClips (const char * args) {
+    (void)args;
+    AssetBundlePrint(AssetBundleBuiltIn());
+}
+
+
+static void CommandCache (const char * args) {
+    if (strcmp(args, "clear") == 0) {
+        PcmCacheClear();
+        printf("PCM cache will be cleared.\r\n");
+    } else {
+        PcmCachePrint();
+    }
+}
+
+
+static void CommandDecoders (const char * args) {
+    (void)args;
+    DecoderPoolPrint();
+#ifdef OPUS_SILK_ONLY
+    printf("SILK-only build.  %u packets that weren't mono SILK of %d samples or less were concealed.\r\n",
+           (unsigned)PlayerRejectCount(), PLAYER_FRAME_MAX);
+#endif
+}
+
+
+static void CommandVolume (const char * args) {
+    unsigned long percent, rampMs = 50;
+    char * end;
+
+    if (strcmp(args, "on") == 0) {
+        PostProcEnable(true);
+    } else if (strcmp(args, "off") == 0) {
+        PostProcEnable(false);
+    } else if (*args) {
+        percent = strtoul(args, &end, 10);
+        if (*end)
+            rampMs = strtoul(end, NULL, 10);
+        if (percent > 100)
+            percent = 100;
+        PostProcSetGain((int16_t)(percent * 32767 / 100), (uint32_t)rampMs);
+    }
+    PostProcPrint();
+}
+
+
+static void CommandProfile (const char * args) {
+    if (strcmp(args, "reset") == 0) {
+        HotProfileReset();
+        printf("Profile samples cleared.\r\n");
+    } else {
+        HotProfilePrint();
+    }
+}
+
+
+static void CommandXip (const char * args) {
+    if (strcmp(args, "reset") == 0) {
+        FlashStreamResetStats();
+        printf("XIP counters reset.\r\n");
+    } else {
+        FlashStreamPrint();
+    }
+}
+
+
+static void CommandBench (const char * args) {
+    (void)args;
+    BenchRequest();
+    printf("Bench will run when nothing is playing.\r\n");
+}
+
+
+// Split the line into a command and its arguments, then run the command.
+static void RunLine (char * line) {
+    char * args;
+    size_t i;
+
+    while (*line == ' ')
+        line++;
+    if (*line == '\0')
+        return;
+
+    args = strchr(line, ' ');
+    if (args) {
+        *args++ = '\0';
+        while (*args == ' ')
+            args++;
+    } else {
+        args = line + strlen(line);
+    }
+
+    for (i = 0; i < sizeof(consoleCommands) / sizeof(consoleCommands[0]); i++) {
+        if (strcmp(line, consoleCommands[i].Name) == 0) {
+            consoleCommands[i].Handler(args);
+            return;
+        }
+    }
+    printf("Unknown command '%s'.  Try 'help'.\r\n", line);
+}
+
+
+// Handle incoming bytes.  Characters are echoed back; a line runs on CR or LF.
+void ConsoleInput (const uint8_t * data, size_t length) {
+    size_t i;
+    for (i = 0; i < length; i++) {
+        char c = (char)data[i];
+
+        if (c == '\r' || c == '\n') {
+            if (lineLen) {
+                printf("\r\n");
+                lineBuf[lineLen] = '\0';
+                lineLen = 0;
+                RunLine(lineBuf);
+            }
+        } else if (c == '\b' || c == 0x7F) {
+            if (lineLen) {
+                lineLen--;
+                printf("\b \b");
+            }
+        } else if (lineLen < CONSOLE_LINE_LEN - 1) {
+            lineBuf[lineLen++] = c;
+            putchar(c);
+        }
+    }
+}
@@ -0,0 +1,15 @@
+// Console Header File
+// A tiny line-based command console on the CDC port.
+// Feed it whatever comes in over CDC; it echoes, collects a line, and runs the matching command.
+// Command output goes through printf, which is routed to the same port.
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef CONSOLE_H
+#define CONSOLE_H
+
+#define CONSOLE_LINE_LEN 64
+
+void ConsoleInput (const uint8_t * data, size_t length);
+
+#endif
@@ -0,0 +1,178 @@
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdlib.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "cpu_stats.h"
+
+typedef struct {
+    TaskHandle_t Task;
+    uint64_t RunTime[configNUM_CORES];
+} cpuStatsEntry_t;
+
+// One extra slot at the end collects time for tasks that didn't get their own.
+static cpuStatsEntry_t statsEntries[CPU_STATS_MAX_TASKS + 1];
+static TaskHandle_t lastTask[configNUM_CORES];
+static uint64_t lastSwitch[configNUM_CORES];
+static uint64_t windowStart = 0;
+
+// Scratch space for CpuStatsPrint.  Static so it doesn't land on the small CDC task stack.
+static cpuStatsEntry_t printEntries[CPU_STATS_MAX_TASKS + 1];
+
+// Room for this many tasks created while CpuStatsPrint is listing them.
+#define CPU_STATS_SPARE_TASKS 2
+
+
+// Find the entry for a task, claiming a free one if it's new.
+// Runs inside the kernel with the scheduler locks held, so it must stay short.
+static cpuStatsEntry_t * FindEntry (TaskHandle_t task) {
+    size_t i;
+    for (i = 0; i < CPU_STATS_MAX_TASKS; i++) {
+        if (statsEntries[i].Task == task)
+            return &statsEntries[i];
+        if (statsEntries[i].Task == NULL) {
+            statsEntries[i].Task = task;
+            return &statsEntries[i];
+        }
+    }
+    return &statsEntries[CPU_STATS_MAX_TASKS];
+}
+
+
+// Start the measurement window.  Called by the kernel through portCONFIGURE_TIMER_FOR_RUN_TIME_STATS.
+// The RP2040 timer is already running at 1MHz, so there's nothing to set up other than the start time.
+void CpuStatsInit (void) {
+    windowStart = time_us_64();
+}
+
+
+// Called from traceTASK_SWITCHED_IN, after the new task has been made current on this core.
+void CpuStatsTaskSwitchedIn (void) {
+    uint32_t core = get_core_num();
+    uint64_t now = time_us_64();
+
+    if (lastTask[core] != NULL)
+        FindEntry(lastTask[core])->RunTime[core] += now - lastSwitch[core];
+
+    lastTask[core] = xTaskGetCurrentTaskHandle();
+    lastSwitch[core] = now;
+}
+
+
+// Zero all the counters and start a new window.
+void CpuStatsReset (void) {
+    size_t i, core;
+    taskENTER_CRITICAL();
+    for (i = 0; i <= CPU_STATS_MAX_TASKS; i++) {
+        for (core = 0; core < configNUM_CORES; core++)
+            statsEntries[i].RunTime[core] = 0;
+    }
+    windowStart = time_us_64();
+    for (core = 0; core < configNUM_CORES; core++)
+        lastSwitch[core] = windowStart;
+    taskEXIT_CRITICAL();
+}
+
+
+// Print a permille value as a percentage with one decimal.
+static void PrintPercent (uint64_t part, uint64_t whole) {
+    uint32_t permille = whole ? (uint32_t)((part * 1000) / whole) : 0;
+    printf("  %3u.%u%%", permille / 10, permille % 10);
+}
+
+
+static char StateChar (eTaskState state) {
+    switch (state) {
+        case eRunning:   return 'X';
+        case eReady:     return 'R';
+        case eBlocked:   return 'B';
+        case eSuspended: return 'S';
+        case eDeleted:   return 'D';
+        default:         return '?';
+    }
+}
+
+
+// Dump per-task, per-core CPU usage since the last reset, plus each task's stack high-water mark.
+// Every task gets a line.  Those past CPU_STATS_MAX_TASKS have no count of their own, so their
+// time shows up once, on the "other tasks" line.
+void CpuStatsPrint (void) {
+    TaskStatus_t *printStatus;
+    UBaseType_t taskCount, i;
+    size_t j, core;
+    uint64_t now, window;
+    uint64_t idleTime[configNUM_CORES] = {0};
+    bool lumped = false;
+
+    // uxTaskGetSystemState fills in nothing at all if the array is too small, so size it from the task count.
+    taskCount = uxTaskGetNumberOfTasks() + CPU_STATS_SPARE_TASKS;
+    printStatus = pvPortMalloc(taskCount * sizeof(TaskStatus_t));
+    if (printStatus == NULL) {
+        printf("Not enough heap to list %u tasks.\r\n", (unsigned)taskCount);
+        return;
+    }
+    taskCount = uxTaskGetSystemState(printStatus, taskCount, NULL);
+
+    // Snapshot the counters, charging the in-progress slice on each core to whoever is running it.
+    taskENTER_CRITICAL();
+    now = time_us_64();
+    memcpy(printEntries, statsEntries, sizeof(printEntries));
+    for (core = 0; core < configNUM_CORES; core++) {
+        for (j = 0; j <= CPU_STATS_MAX_TASKS; j++) {
+            if (j == CPU_STATS_MAX_TASKS || printEntries[j].Task == lastTask[core]) {
+                printEntries[j].RunTime[core] += now - lastSwitch[core];
+                break;
+            }
+        }
+    }
+    window = now - windowStart;
+    taskEXIT_CRITICAL();
+
+    printf("Task              Pri St");
+    for (core = 0; core < configNUM_CORES; core++)
+        printf("   Core%u", (unsigned)core);
+    printf("  Stack free\r\n");
+
+    for (i = 0; i < taskCount; i++) {
+        TaskStatus_t *status = &printStatus[i];
+        cpuStatsEntry_t *entry = NULL;
+
+        for (j = 0; j < CPU_STATS_MAX_TASKS; j++) {
+            if (printEntries[j].Task == status->xHandle) {
+                entry = &printEntries[j];
+                break;
+            }
+        }
+
+        printf("%-16s  %3u  %c", status->pcTaskName, (unsigned)status->uxCurrentPriority,
+               StateChar(status->eCurrentState));
+        for (core = 0; core < configNUM_CORES; core++) {
+            if (entry == NULL) {
+                printf("   other");
+                continue;
+            }
+            PrintPercent(entry->RunTime[core], window);
+            if (strncmp(status->pcTaskName, "IDLE", 4) == 0)
+                idleTime[core] += entry->RunTime[core];
+        }
+        printf("  %u words\r\n", (unsigned)uxTaskGetStackHighWaterMark(status->xHandle));
+        lumped |= entry == NULL;
+    }
+    vPortFree(printStatus);
+
+    for (core = 0; core < configNUM_CORES; core++)
+        lumped |= printEntries[CPU_STATS_MAX_TASKS].RunTime[core] != 0;
+    if (lumped) {
+        printf("(other tasks)          ");
+        for (core = 0; core < configNUM_CORES; core++)
+            PrintPercent(printEntries[CPU_STATS_MAX_TASKS].RunTime[core], window);
+        printf("\r\n");
+    }
+
+    printf("Load                   ");
+    for (core = 0; core < configNUM_CORES; core++)
+        PrintPercent(window > idleTime[core] ? window - idleTime[core] : 0, window);
+    printf("  over %u ms\r\n", (unsigned)(window / 1000));
+}
@@ -0,0 +1,18 @@
+// CPU Stats Header File
+// Per-task, per-core run time accounting on top of the FreeRTOS trace hooks.
+// FreeRTOS only keeps one run time counter per task, so it can't tell which core a task ran on.
+// traceTASK_SWITCHED_IN (see FreeRTOSConfig.h) lands here on every context switch instead, and we
+// charge the time since the previous switch on that core to the task that was running.
+#include <stdint.h>
+
+#ifndef CPU_STATS_H
+#define CPU_STATS_H
+
+#define CPU_STATS_MAX_TASKS 12 // Tasks beyond this (including the kernel's own) share one "other tasks" count.
+
+void CpuStatsInit (void);
+void CpuStatsTaskSwitchedIn (void);
+void CpuStatsReset (void);
+void CpuStatsPrint (void);
+
+#endif
@@ -0,0 +1,22 @@
+// Opus platform overrides.
+// Opus' os_support.h includes this file when CUSTOM_SUPPORT is defined.  We only use it to hand
+// Opus the shared scratch arena as its pseudostack (see opus_scratch.h).
+#ifndef CUSTOM_SUPPORT_H
+#define CUSTOM_SUPPORT_H
+
+#include <stddef.h>
+#include "settings.h"
+#include "opus_scratch.h"
+
+#ifdef OPUS_SCRATCH_ARENA
+    #ifndef GLOBAL_STACK_SIZE
+        #define GLOBAL_STACK_SIZE OPUS_SCRATCH_SIZE
+    #endif
+
+    #define OVERRIDE_OPUS_ALLOC_SCRATCH
+    static inline void * opus_alloc_scratch (size_t size) {
+        return OpusScratchGet(size);
+    }
+#endif
+
+#endif
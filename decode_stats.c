@@ -0,0 +1,105 @@
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "decode_stats.h"
+
+typedef struct {
+    uint32_t Packets;
+    uint32_t Histogram[DECODE_STATS_BUCKETS];
+    uint64_t TotalUs;
+    uint32_t WorstUs;
+    uint32_t Buffers;
+    uint32_t Late;
+    int32_t MinSlackUs;
+} decodeModeStats_t;
+
+// One row per mode, then one for concealment.
+#define DECODE_STATS_PLC DECODE_MODE_COUNT
+
+static decodeModeStats_t modeStats[DECODE_MODE_COUNT + 1];
+static volatile bool resetRequested = true;
+
+static const char * const modeNames[DECODE_MODE_COUNT + 1] = { "SILK", "Hybrid", "CELT", "PLC" };
+
+
+// The stats are written only by the decode loop.  A reset from anywhere else just raises a flag,
+// and the next record does the actual clearing, so the hot path never needs a lock.
+static inline void CheckReset (void) {
+    int mode;
+    if (resetRequested) {
+        memset(modeStats, 0, sizeof(modeStats));
+        for (mode = 0; mode <= DECODE_MODE_COUNT; mode++)
+            modeStats[mode].MinSlackUs = INT32_MAX;
+        resetRequested = false;
+    }
+}
+
+
+// Record how long one opus_decode call took.
+void DecodeStatsRecordDecode (int mode, uint32_t decodeUs) {
+    decodeModeStats_t *stats = &modeStats[mode];
+    uint32_t bucket = 31 - __builtin_clz(decodeUs | 1);
+
+    CheckReset();
+    if (bucket >= DECODE_STATS_BUCKETS)
+        bucket = DECODE_STATS_BUCKETS - 1;
+
+    stats->Packets++;
+    stats->Histogram[bucket]++;
+    stats->TotalUs += decodeUs;
+    if (decodeUs > stats->WorstUs)
+        stats->WorstUs = decodeUs;
+}
+
+
+// Record how long one concealment (a NULL packet decode) took.
+void DecodeStatsRecordConceal (uint32_t decodeUs) {
+    DecodeStatsRecordDecode(DECODE_STATS_PLC, decodeUs);
+}
+
+
+// Record the slack left when a buffer decoded from this mode was handed to I2S.
+// Negative slack means the buffer missed its play-out time.
+void DecodeStatsRecordSlack (int mode, int32_t slackUs) {
+    decodeModeStats_t *stats = &modeStats[mode];
+
+    CheckReset();
+    stats->Buffers++;
+    if (slackUs < 0)
+        stats->Late++;
+    if (slackUs < stats->MinSlackUs)
+        stats->MinSlackUs = slackUs;
+}
+
+
+void DecodeStatsReset (void) {
+    resetRequested = true;
+}
+
+
+void DecodeStatsPrint (void) {
+    int mode, bucket, last;
+
+    for (mode = 0; mode <= DECODE_MODE_COUNT; mode++) {
+        decodeModeStats_t *stats = &modeStats[mode];
+        if (resetRequested || stats->Packets == 0) {
+            if (mode != DECODE_STATS_PLC)
+                printf("%s: no packets.\r\n", modeNames[mode]);
+            continue;
+        }
+
+        printf("%s: %u packets, avg %u us, worst %u us.\r\n", modeNames[mode], (unsigned)stats->Packets,
+               (unsigned)(stats->TotalUs / stats->Packets), (unsigned)stats->WorstUs);
+        if (stats->Buffers)
+            printf("  %u buffers, min slack %d us, %u late.\r\n", (unsigned)stats->Buffers,
+                   (int)stats->MinSlackUs, (unsigned)stats->Late);
+
+        for (last = DECODE_STATS_BUCKETS - 1; last > 0 && stats->Histogram[last] == 0; last--);
+        for (bucket = 0; bucket <= last; bucket++) {
+            if (stats->Histogram[bucket])
+                printf("  %6u us%s %u\r\n", 1u << bucket, bucket == DECODE_STATS_BUCKETS - 1 ? "+:" : ": ",
+                       (unsigned)stats->Histogram[bucket]);
+        }
+    }
+}
@@ -0,0 +1,37 @@
+// Decode Stats Header File
+// Always-on timing for the decode loop: a log2 histogram of opus_decode time per packet, and the
+// slack left against the play-out deadline when each buffer is handed to I2S.  Everything is split
+// by the Opus mode in the packet's TOC byte.  Concealment (PLC) has a row of its own, so it doesn't
+// hide among real decodes.  Recording is a couple of adds and a CLZ.
+#include <stdint.h>
+
+#ifndef DECODE_STATS_H
+#define DECODE_STATS_H
+
+enum {
+    DECODE_MODE_SILK = 0,
+    DECODE_MODE_HYBRID,
+    DECODE_MODE_CELT,
+    DECODE_MODE_COUNT
+};
+
+#define DECODE_STATS_BUCKETS 16 // Bucket n holds times in [2^n, 2^(n+1)) microseconds.  The last one is open.
+
+// Opus mode from the TOC byte (RFC 6716, section 3.1).  Configs 0-11 are SILK, 12-15 hybrid, the rest CELT.
+static inline int DecodeStatsMode (const uint8_t * packet) {
+    uint8_t config = packet[0] >> 3;
+    if (config < 12)
+        return DECODE_MODE_SILK;
+    else if (config < 16)
+        return DECODE_MODE_HYBRID;
+    else
+        return DECODE_MODE_CELT;
+}
+
+void DecodeStatsRecordDecode (int mode, uint32_t decodeUs);
+void DecodeStatsRecordConceal (uint32_t decodeUs);
+void DecodeStatsRecordSlack (int mode, int32_t slackUs);
+void DecodeStatsReset (void);
+void DecodeStatsPrint (void);
+
+#endif
@@ -0,0 +1,95 @@
+#include <stdio.h>
+#include "pico/stdlib.h"
+
+#include "FreeRTOS.h"
+
+#include "decoder_pool.h"
+
+static decoderPoolEntry_t poolEntries[DECODER_POOL_SIZE];
+static uint32_t resets = 0, inits = 0, misses = 0;
+
+
+// Allocate every decoder up front, from the FreeRTOS heap, which is where the spare SRAM is.
+void DecoderPoolInit (void) {
+    int i;
+    for (i = 0; i < DECODER_POOL_SIZE; i++) {
+        poolEntries[i].Decoder = pvPortMalloc(opus_decoder_get_size(DECODER_POOL_MAX_CHANNELS));
+        if (poolEntries[i].Decoder == NULL)
+            panic("No room for decoder %d.\n", i);
+    }
+}
+
+
+// Get a decoder ready to start a new stream in the given format, or NULL if they're all in use.
+// Prefers one already in that format, since a reset is much cheaper than an init.
+OpusDecoder * DecoderPoolAcquire (int32_t rate, int channels) {
+    decoderPoolEntry_t *entry = NULL;
+    int i, error;
+
+    if (channels > DECODER_POOL_MAX_CHANNELS)
+        return NULL;
+
+    for (i = 0; i < DECODER_POOL_SIZE; i++) {
+        if (!poolEntries[i].InUse) {
+            if (poolEntries[i].Rate == rate && poolEntries[i].Channels == channels) {
+                entry = &poolEntries[i];
+                break;
+            }
+            if (entry == NULL)
+                entry = &poolEntries[i];
+        }
+    }
+    if (entry == NULL) {
+        misses++;
+        return NULL;
+    }
+
+    if (entry->Rate == rate && entry->Channels == channels) {
+        opus_decoder_ctl(entry->Decoder, OPUS_RESET_STATE);
+        resets++;
+    } else {
+        error = opus_decoder_init(entry->Decoder, rate, channels);
+        if (error != OPUS_OK) {
+            printf("Couldn't set up a decoder for %d Hz x %d: %d\r\n", (int)rate, channels, error);
+            entry->Rate = 0;
+            return NULL;
+        }
+        entry->Rate = rate;
+        entry->Channels = channels;
+        inits++;
+    }
+    entry->InUse = true;
+    return entry->Decoder;
+}
+
+
+void DecoderPoolRelease (OpusDecoder * decoder) {
+    int i;
+    for (i = 0; i < DECODER_POOL_SIZE; i++) {
+        if (poolEntries[i].Decoder == decoder)
+            poolEntries[i].InUse = false;
+    }
+}
+
+
+int DecoderPoolFree (void) {
+    int i, free = 0;
+    for (i = 0; i < DECODER_POOL_SIZE; i++) {
+        if (!poolEntries[i].InUse)
+            free++;
+    }
+    return free;
+}
+
+
+void DecoderPoolPrint (void) {
+    int i;
+    printf("Decoder pool: %d of %d free, %u bytes each.  %u resets, %u inits, %u times none free.\r\n",
+           DecoderPoolFree(), DECODER_POOL_SIZE, (unsigned)opus_decoder_get_size(DECODER_POOL_MAX_CHANNELS),
+           (unsigned)resets, (unsigned)inits, (unsigned)misses);
+    for (i = 0; i < DECODER_POOL_SIZE; i++) {
+        if (poolEntries[i].Rate)
+            printf("  %d: %d Hz x %d%s\r\n", i, (int)poolEntries[i].Rate, poolEntries[i].Channels,
+                   poolEntries[i].InUse ? ", in use" : "");
+    }
+}
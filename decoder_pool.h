@@ -0,0 +1,31 @@
+// Decoder Pool Header File
+// A fixed set of Opus decoders, allocated once at start-up and handed out to clips as they open.
+// A decoder already set up for the rate and channel count asked for is just reset
+// (OPUS_RESET_STATE); one that isn't is re-initialised in place.  Either way there's no heap
+// traffic between clips.  Each decoder is sized for DECODER_POOL_MAX_CHANNELS, so any of them can
+// take any format.
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "opus.h"
+#include "settings.h"
+
+#ifndef DECODER_POOL_H
+#define DECODER_POOL_H
+
+#define DECODER_POOL_MAX_CHANNELS 1 // The player always decodes to mono.  Raise this to hand out stereo decoders.
+
+typedef struct {
+    OpusDecoder * Decoder;
+    int32_t Rate;       // Format it's currently set up for.  0 before the first use.
+    int Channels;
+    bool InUse;
+} decoderPoolEntry_t;
+
+void DecoderPoolInit (void);
+OpusDecoder * DecoderPoolAcquire (int32_t rate, int channels);
+void DecoderPoolRelease (OpusDecoder * decoder);
+int DecoderPoolFree (void);
+void DecoderPoolPrint (void);
+
+#endif
@@ -0,0 +1,234 @@
+#include <stdio.h>
+#include <string.h>
+
+#ifndef FLASH_STREAM_SYNC
+    #include "pico/stdlib.h"
+    #include "hardware/dma.h"
+    #include "hardware/regs/addressmap.h"
+    #include "hardware/structs/xip_ctrl.h"
+#endif
+
+#include "flash_stream.h"
+
+static uint32_t streamedBytes = 0;
+static uint32_t transfers = 0;
+static uint32_t stalls = 0;    // Reads that had to wait for a transfer.
+static uint32_t restarts = 0;  // Reads outside what the ring had or was fetching.
+
+
+// Where in the ring a source byte goes.  The ring is indexed by absolute address, so a word-aligned
+// source address always lands on a word-aligned ring slot and transfers can use whole words.
+static inline size_t RingIndex (const flashStream_t * stream, size_t offset) {
+    return (size_t)((uintptr_t)(stream->Source + offset) & (FLASH_STREAM_RING - 1));
+}
+
+
+// The three operations the ring needs from the transport.
+#ifndef FLASH_STREAM_SYNC
+
+static void StartTransfer (flashStream_t * stream, size_t offset, size_t length) {
+    const uint8_t * from = stream->Source + offset;
+    uint8_t * to = &stream->Ring[RingIndex(stream, offset)];
+    bool words = ((uintptr_t)from & 3) == 0 && (length & 3) == 0;
+    dma_channel_config config = dma_channel_get_default_config((uint)stream->Channel);
+
+    channel_config_set_transfer_data_size(&config, words ? DMA_SIZE_32 : DMA_SIZE_8);
+    channel_config_set_read_increment(&config, true);
+    channel_config_set_write_increment(&config, true);
+    dma_channel_configure((uint)stream->Channel, &config, to, from, words ? length / 4 : length, true);
+}
+
+
+static bool TransferDone (flashStream_t * stream, bool wait) {
+    if (wait)
+        dma_channel_wait_for_finish_blocking((uint)stream->Channel);
+    return !dma_channel_is_busy((uint)stream->Channel);
+}
+
+
+static void AbortTransfer (flashStream_t * stream) {
+    dma_channel_abort((uint)stream->Channel);
+}
+
+#else
+
+static void StartTransfer (flashStream_t * stream, size_t offset, size_t length) {
+    memcpy(&stream->Ring[RingIndex(stream, offset)], stream->Source + offset, length);
+}
+
+
+static bool TransferDone (flashStream_t * stream, bool wait) {
+    (void)stream;
+    (void)wait;
+    return true;
+}
+
+
+static void AbortTransfer (flashStream_t * stream) {
+    (void)stream;
+}
+
+#endif
+
+
+// Account for a finished transfer.  With wait set, block until it has finished.
+static void Complete (flashStream_t * stream, bool wait) {
+    if (stream->Pending && TransferDone(stream, wait)) {
+        stream->Tail += stream->Pending;
+        stream->Pending = 0;
+    }
+}
+
+
+// Start fetching the next chunk if nothing is in flight and there's room.  While there's data in hand
+// it waits for a decent amount of room, rather than chasing the reader a few bytes at a time.
+// A transfer stops at the end of the ring, and is cut to whole words where it can be so it runs as
+// word reads.
+static void Kick (flashStream_t * stream) {
+    size_t length, space = FLASH_STREAM_RING - (stream->Tail - stream->Head);
+    uintptr_t address;
+
+    if (stream->Pending || stream->Tail >= stream->Length)
+        return;
+    if (space < FLASH_STREAM_CHUNK / 4 && stream->Tail > stream->Head)
+        return;
+
+    length = FLASH_STREAM_RING - RingIndex(stream, stream->Tail);
+    if (length > space)
+        length = space;
+    if (length > FLASH_STREAM_CHUNK)
+        length = FLASH_STREAM_CHUNK;
+    if (length > stream->Length - stream->Tail)
+        length = stream->Length - stream->Tail;
+
+    address = (uintptr_t)(stream->Source + stream->Tail);
+    if (address & 3) {
+        if (length > 4 - (address & 3))
+            length = 4 - (address & 3);
+    } else if (length > 3) {
+        length &= ~(size_t)3;
+    }
+
+    StartTransfer(stream, stream->Tail, length);
+    stream->Pending = length;
+    transfers++;
+    streamedBytes += (uint32_t)length;
+}
+
+
+// Drop everything and carry on from offset.
+static void Restart (flashStream_t * stream, size_t offset) {
+    if (stream->Pending || stream->Tail > stream->Head)
+        restarts++;
+    if (stream->Pending) {
+        AbortTransfer(stream);
+        stream->Pending = 0;
+    }
+    stream->Head = stream->Tail = offset;
+}
+
+
+// Translate an address in the cached flash window to the same byte through the alias that neither
+// looks in nor fills the XIP cache.  Anything else, such as data already in SRAM, is left alone.
+const void * FlashStreamUncached (const void * address) {
+#ifndef FLASH_STREAM_SYNC
+    uintptr_t a = (uintptr_t)address;
+    if (a >= XIP_MAIN_BASE && a < XIP_MAIN_BASE + PICO_FLASH_SIZE_BYTES)
+        return (const void *)(a - XIP_MAIN_BASE + XIP_NOCACHE_NOALLOC_BASE);
+#endif
+    return address;
+}
+
+
+// Claim a DMA channel for the stream.  Call once before using it.
+void FlashStreamInit (flashStream_t * stream) {
+#ifndef FLASH_STREAM_SYNC
+    stream->Channel = dma_claim_unused_channel(true);
+#else
+    stream->Channel = -1;
+#endif
+    stream->Source = NULL;
+    stream->Length = stream->Head = stream->Tail = stream->Pending = 0;
+}
+
+
+// Point the stream at some data.  Read-ahead starts from wherever the first read is.
+void FlashStreamOpen (flashStream_t * stream, const void * source, size_t length) {
+    FlashStreamClose(stream);
+    stream->Source = (const uint8_t *)FlashStreamUncached(source);
+    stream->Length = length;
+}
+
+
+// Stop any read-ahead.  The stream can be opened again afterwards.
+void FlashStreamClose (flashStream_t * stream) {
+    if (stream->Pending)
+        AbortTransfer(stream);
+    stream->Pending = 0;
+    stream->Head = stream->Tail = 0;
+    stream->Length = 0;
+}
+
+
+// Copy length bytes from offset in the source.  The caller keeps the range inside the source.
+// Reading at or a little past the last read is served from the ring; reading anywhere else
+// restarts the read-ahead there.  Bytes before offset are given up, so reads should move forwards.
+void FlashStreamRead (flashStream_t * stream, size_t offset, void * destination, size_t length) {
+    uint8_t * to = (uint8_t *)destination;
+    size_t count, index;
+
+    if (offset < stream->Head || offset > stream->Tail + stream->Pending)
+        Restart(stream, offset);
+
+    while (length) {
+        Complete(stream, false);
+        if (offset >= stream->Tail) {
+            if (!stream->Pending)
+                Kick(stream);
+            if (!stream->Pending)
+                break;  // Past the end, or closed.
+            stalls++;
+            Complete(stream, true);
+            continue;
+        }
+
+        index = RingIndex(stream, offset);
+        count = stream->Tail - offset;
+        if (count > length)
+            count = length;
+        if (count > FLASH_STREAM_RING - index)
+            count = FLASH_STREAM_RING - index;
+        memcpy(to, &stream->Ring[index], count);
+        to += count;
+        offset += count;
+        length -= count;
+        stream->Head = offset;
+        Kick(stream);
+    }
+}
+
+
+// Clear the stream counters and the XIP cache's own hit counters.
+void FlashStreamResetStats (void) {
+    streamedBytes = transfers = stalls = restarts = 0;
+#ifndef FLASH_STREAM_SYNC
+    xip_ctrl_hw->ctr_hit = 0;
+    xip_ctrl_hw->ctr_acc = 0;
+#endif
+}
+
+
+void FlashStreamPrint (void) {
+#ifndef FLASH_STREAM_SYNC
+    uint32_t hits = xip_ctrl_hw->ctr_hit;
+    uint32_t accesses = xip_ctrl_hw->ctr_acc;
+
+    printf("XIP cache: %u hits of %u accesses", (unsigned)hits, (unsigned)accesses);
+    if (accesses)
+        printf(" (%u.%u%%)", (unsigned)((uint64_t)hits * 100 / accesses),
+               (unsigned)((uint64_t)hits * 1000 / accesses % 10));
+    printf(".\r\n");
+#endif
+    printf("Flash streams: %u bytes in %u transfers, %u stalls, %u restarts.\r\n", (unsigned)streamedBytes,
+           (unsigned)transfers, (unsigned)stalls, (unsigned)restarts);
+}
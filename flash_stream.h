@@ -0,0 +1,36 @@
+// Flash Stream Header File
+// Reads asset data out of flash without going through the XIP cache, so packet reads don't evict
+// the decoder's code from it.  Each stream reads through the non-caching flash alias by DMA into a
+// small SRAM ring, keeping a chunk in flight ahead of the reader so the fetch overlaps decoding.
+// Used by ogg_stripper when built with OGG_STRIP_FLASH_DMA.
+// The ring bookkeeping doesn't touch the hardware.  Define FLASH_STREAM_SYNC to have transfers done
+// with memcpy instead, e.g. to run it off the Pico.
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef FLASH_STREAM_H
+#define FLASH_STREAM_H
+
+#define FLASH_STREAM_RING 1024  // Bytes of read-ahead per stream.  A power of two.
+#define FLASH_STREAM_CHUNK 256  // Most to fetch in one transfer.  Smaller keeps the first read after a seek quick.
+
+typedef struct {
+    const uint8_t * Source;     // Through the non-caching alias.
+    size_t Length;
+    size_t Head;                // Source offset of the oldest byte still wanted.  Nothing before it is kept.
+    size_t Tail;                // Source offset just past the last byte that has landed in the ring.
+    size_t Pending;             // Bytes in the transfer in flight, which land at Tail.
+    int Channel;                // DMA channel, or -1 without one.
+    uint8_t Ring[FLASH_STREAM_RING] __attribute__((aligned(4)));
+} flashStream_t;
+
+const void * FlashStreamUncached (const void * address);
+void FlashStreamInit (flashStream_t * stream);
+void FlashStreamOpen (flashStream_t * stream, const void * source, size_t length);
+void FlashStreamClose (flashStream_t * stream);
+void FlashStreamRead (flashStream_t * stream, size_t offset, void * destination, size_t length);
+void FlashStreamResetStats (void);
+void FlashStreamPrint (void);
+
+#endif
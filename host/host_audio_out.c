@@ -0,0 +1,77 @@
+// audio_out.h for the host build.  There's no I2S and no deadline: each buffer goes straight to the
+// sink when it's given, so the player runs as fast as it can decode.
+#include <stdio.h>
+
+#include "audio_out.h"
+#include "host_sink.h"
+
+static int16_t samples[SAMPLES_PER_BUFFER];
+static mem_buffer_t memBuffer = { sizeof(samples), (uint8_t *)samples };
+static audio_buffer_t audioBuffer = { &memBuffer, 0, SAMPLES_PER_BUFFER };
+static hostSink_t * currentSink = NULL;
+static uint32_t concealments = 0;
+
+
+void AudioOutSetSink (hostSink_t * sink) {
+    currentSink = sink;
+}
+
+
+void AudioOutInit (void) {
+}
+
+
+void AudioOutService (void) {
+}
+
+
+bool AudioOutParked (void) {
+    return false;
+}
+
+
+void AudioOutRetime (void) {
+}
+
+
+audio_buffer_t * AudioOutTake (void) {
+    audioBuffer.sample_count = 0;
+    return &audioBuffer;
+}
+
+
+int32_t AudioOutGive (audio_buffer_t * buffer) {
+    if (currentSink != NULL)
+        HostSinkWrite(currentSink, (const int16_t *)buffer->buffer->bytes, buffer->sample_count);
+    return AUDIO_OUT_NO_DEADLINE;
+}
+
+
+uint32_t AudioOutBufferUs (uint32_t sampleCount) {
+    return (uint32_t)((uint64_t)sampleCount * 1000000 / AUDIO_OUT_SAMPLE_RATE);
+}
+
+
+uint32_t AudioOutQueuedUs (void) {
+    return 0;
+}
+
+
+void AudioOutCountConcealment (void) {
+    concealments++;
+}
+
+
+uint32_t AudioOutUnderrunCount (void) {
+    return 0;
+}
+
+
+void AudioOutResetUnderruns (void) {
+    concealments = 0;
+}
+
+
+void AudioOutPrintUnderruns (void) {
+    printf("%u concealed frames.\r\n", (unsigned)concealments);
+}
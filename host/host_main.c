@@ -0,0 +1,198 @@
+/**
+ * PicoPlayOpus host build
+ * Runs the player core (ogg_stripper, Opus, the player, mixer, post-processing and resampler) on
+ * Linux, the same way App_Task does, with the audio going to a WAV file or nowhere.  It runs flat out,
+ * so it's a way to time the decoder with ordinary profilers, and to check a change doesn't alter
+ * the output.  With -b it runs the decode benchmark (bench.h) instead.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "pico/stdlib.h"
+
+#include "audio_out.h"
+#include "bench.h"
+#include "decode_stats.h"
+#include "decoder_pool.h"
+#include "host_sink.h"
+#include "host_vectors.h"
+#include "ogg_data.h"
+#include "opus_scratch.h"
+#include "pcm_cache.h"
+#include "player.h"
+#include "postproc.h"
+#include "render.h"
+#include "resampler.h"
+
+#define HOST_MAX_CLIPS 64
+
+
+static void Usage (const char * name) {
+    fprintf(stderr, "Usage: %s [-o out.wav] [-n] [-r repeat] [-b] [clip.opus ...]\n"
+                    "       %s -t [-R rate] [-o out.pcm] testvector.bit ...\n"
+                    "  -o  Write the output to a WAV file (the default is out.wav).\n"
+                    "  -n  Throw the output away, to time the decoding alone.\n"
+                    "  -r  Play the clips this many times over.\n"
+                    "  -b  Run the decode benchmark over the clips instead of playing them, then time the\n"
+                    "      output stages.\n"
+                    "  -t  Decode Opus test vectors (opus_demo .bit files) to mono at -R Hz (default %d),\n"
+                    "      checking the range coder state.  -o writes raw PCM for opus_compare.\n"
+                    "With no clips, the built-in sample is played.  The PCM hash printed at the end\n"
+                    "is what tools/conformance.py compares.\n", name, name, PLAYER_SAMPLE_RATE);
+    exit(2);
+}
+
+
+// Read a whole file into memory.  The player reads clips in place, so they're kept until exit.
+static const char * LoadClip (const char * path, size_t * length) {
+    FILE * file = fopen(path, "rb");
+    char * data;
+    long size;
+
+    if (file == NULL || fseek(file, 0, SEEK_END) != 0 || (size = ftell(file)) <= 0) {
+        fprintf(stderr, "Can't read %s.\n", path);
+        exit(1);
+    }
+    rewind(file);
+    data = malloc((size_t)size);
+    if (data == NULL || fread(data, 1, (size_t)size, file) != (size_t)size) {
+        fprintf(stderr, "Can't read %s.\n", path);
+        exit(1);
+    }
+    fclose(file);
+    *length = (size_t)size;
+    return data;
+}
+
+
+int main (int argc, char ** argv) {
+    const char * clips[HOST_MAX_CLIPS];
+    benchAsset_t assets[HOST_MAX_CLIPS];
+    size_t lengths[HOST_MAX_CLIPS];
+    const char * outPath = NULL;
+    bool discard = false, bench = false, vectors = false, passed = true;
+    int32_t vectorRate = PLAYER_SAMPLE_RATE;
+    int repeat = 1, clipCount = 0, option, i, r;
+    hostSink_t sink;
+    resampler_t resampler;
+    audio_buffer_t * buffer;
+    uint64_t start, elapsedUs, samples = 0;
+    double seconds;
+
+    while ((option = getopt(argc, argv, "o:nr:btR:")) != -1) {
+        switch (option) {
+            case 'o': outPath = optarg; break;
+            case 'n': discard = true; break;
+            case 'r': repeat = atoi(optarg); break;
+            case 'b': bench = true; break;
+            case 't': vectors = true; break;
+            case 'R': vectorRate = atoi(optarg); break;
+            default: Usage(argv[0]);
+        }
+    }
+    if (repeat < 1)
+        Usage(argv[0]);
+
+    // Test vectors are read from their files as they're decoded.
+    if (vectors) {
+        if (optind == argc || (outPath != NULL && argc - optind > 1))
+            Usage(argv[0]);
+        OpusScratchInit();
+        DecoderPoolInit();
+        for (i = optind; i < argc; i++)
+            passed &= HostVectorDecode(argv[i], outPath, vectorRate);
+        return passed ? 0 : 1;
+    }
+
+    if (optind == argc) {
+        clips[clipCount] = Sample;
+        lengths[clipCount++] = SAMPLE_LENGTH;
+    }
+    for (i = optind; i < argc; i++) {
+        if (clipCount == HOST_MAX_CLIPS)
+            Usage(argv[0]);
+        clips[clipCount] = LoadClip(argv[i], &lengths[clipCount]);
+        clipCount++;
+    }
+
+    if (bench) {
+        OpusScratchInit();
+        DecoderPoolInit();
+        if (optind == argc) {
+            BenchRunDefault();
+            BenchRunStages();
+            return 0;
+        }
+        // Named after the file, without its directory or extension.  A compact stream keeps its .opk,
+        // to tell it apart from the Ogg it came from.
+        for (i = 0; i < clipCount; i++) {
+            char * slash = strrchr(argv[optind + i], '/');
+            char * dot = strrchr(argv[optind + i], '.');
+            if (dot != NULL && (slash == NULL || dot > slash) && strcmp(dot, ".opk") != 0)
+                *dot = '\0';
+            assets[i].Name = slash != NULL ? slash + 1 : argv[optind + i];
+            assets[i].Data = clips[i];
+            assets[i].Length = lengths[i];
+        }
+        BenchRun(assets, clipCount);
+        BenchRunStages();
+        return 0;
+    }
+
+    if (outPath == NULL)
+        outPath = "out.wav";
+    if (discard)
+        HostSinkOpenNull(&sink, AUDIO_OUT_SAMPLE_RATE);
+    else if (!HostSinkOpenWav(&sink, outPath, AUDIO_OUT_SAMPLE_RATE)) {
+        fprintf(stderr, "Can't write %s.\n", outPath);
+        return 1;
+    }
+    AudioOutSetSink(&sink);
+
+    AudioOutInit();
+    OpusScratchInit();
+    PlayerInit();
+    PostProcInit(PLAYER_SAMPLE_RATE);
+    if (!ResamplerInit(&resampler, PLAYER_SAMPLE_RATE, AUDIO_OUT_SAMPLE_RATE))
+        panic("Can't resample %u Hz to %u Hz.\n", PLAYER_SAMPLE_RATE, AUDIO_OUT_SAMPLE_RATE);
+
+    // The clips play back to back on one voice, through its play queue.  Files have no clip ID, so
+    // they bypass the PCM cache; the built-in sample uses its own, as on the Pico.
+    for (r = 0; r < repeat; r++) {
+        for (i = 0; i < clipCount; i++) {
+            uint32_t id = clips[i] == Sample ? SAMPLE_ID : PCM_CACHE_NO_ID;
+            bool queued = r == 0 && i == 0 ? PlayerStart(0, id, clips[i], lengths[i], MIXER_GAIN_UNITY, 0)
+                                           : PlayerQueue(0, id, clips[i], lengths[i]);
+            if (!queued) {
+                fprintf(stderr, "Only the first %d plays fit in the queue.\n", r * clipCount + i);
+                break;
+            }
+        }
+        if (i < clipCount)
+            break;
+    }
+
+    // The decode loop from App_Task, without the deadlines: render blocks until nothing is playing.
+    start = time_us_64();
+    do {
+        PlayerService();
+        buffer = AudioOutTake();
+        buffer->sample_count = RenderBlock(&resampler, (int16_t *)buffer->buffer->bytes, PLAYER_BLOCK_SAMPLES, false);
+        samples += buffer->sample_count;
+        AudioOutGive(buffer);
+    } while (buffer->sample_count);
+    elapsedUs = time_us_64() - start;
+
+    HostSinkClose(&sink);
+
+    seconds = (double)samples / AUDIO_OUT_SAMPLE_RATE;
+    printf("%.2fs of audio in %.3fs (%.1fx real time).\n", seconds, elapsedUs / 1e6,
+           elapsedUs ? seconds * 1e6 / elapsedUs : 0.0);
+    printf("Opus scratch high-water: %u of %u bytes.\n",
+           (unsigned)OpusScratchHighWater(), (unsigned)OpusScratchSize());
+    DecodeStatsPrint();
+    printf("PCM: %llu samples, hash %016llx.\n", (unsigned long long)sink.Samples, (unsigned long long)sink.Hash);
+    return 0;
+}
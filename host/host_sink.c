@@ -0,0 +1,107 @@
+#include <string.h>
+
+#include "host_sink.h"
+
+#define WAV_HEADER_LEN 44
+
+
+static void Put16 (uint8_t * to, uint32_t value) {
+    to[0] = (uint8_t)value;
+    to[1] = (uint8_t)(value >> 8);
+}
+
+
+static void Put32 (uint8_t * to, uint32_t value) {
+    Put16(to, value);
+    Put16(to + 2, value >> 16);
+}
+
+
+// A canonical 44-byte PCM header for what's been written so far.
+static void WriteHeader (hostSink_t * sink) {
+    uint8_t header[WAV_HEADER_LEN];
+    uint32_t dataBytes = (uint32_t)(sink->Samples * 2);
+
+    memcpy(header, "RIFF", 4);
+    Put32(header + 4, 36 + dataBytes);
+    memcpy(header + 8, "WAVEfmt ", 8);
+    Put32(header + 16, 16);
+    Put16(header + 20, 1);              // PCM
+    Put16(header + 22, 1);              // Mono
+    Put32(header + 24, sink->Rate);
+    Put32(header + 28, sink->Rate * 2); // Bytes per second
+    Put16(header + 32, 2);              // Bytes per frame
+    Put16(header + 34, 16);
+    memcpy(header + 36, "data", 4);
+    Put32(header + 40, dataBytes);
+
+    fseek(sink->File, 0, SEEK_SET);
+    fwrite(header, 1, sizeof(header), sink->File);
+    fseek(sink->File, 0, SEEK_END);
+}
+
+
+// Open a WAV file to write to.  The header is filled in properly on HostSinkClose.
+bool HostSinkOpenWav (hostSink_t * sink, const char * path, uint32_t rate) {
+    if (!HostSinkOpenRaw(sink, path, rate))
+        return false;
+    sink->Wav = true;
+    WriteHeader(sink);
+    return true;
+}
+
+
+// Open a file for headerless samples.
+bool HostSinkOpenRaw (hostSink_t * sink, const char * path, uint32_t rate) {
+    HostSinkOpenNull(sink, rate);
+    sink->File = fopen(path, "wb");
+    return sink->File != NULL;
+}
+
+
+void HostSinkOpenNull (hostSink_t * sink, uint32_t rate) {
+    sink->File = NULL;
+    sink->Wav = false;
+    sink->Rate = rate;
+    sink->Samples = 0;
+    sink->Hash = HOST_SINK_HASH_BASIS;
+}
+
+
+// FNV-1a, 64-bit.  Start from HOST_SINK_HASH_BASIS.
+uint64_t HostSinkHash (uint64_t hash, const uint8_t * bytes, size_t length) {
+    while (length--) {
+        hash ^= *bytes++;
+        hash *= HOST_SINK_HASH_PRIME;
+    }
+    return hash;
+}
+
+
+// Samples are written, and hashed, little-endian whatever the host is.
+void HostSinkWrite (hostSink_t * sink, const int16_t * pcm, uint32_t samples) {
+    uint8_t bytes[512];
+    uint32_t i, count;
+
+    sink->Samples += samples;
+    while (samples) {
+        count = samples < sizeof(bytes) / 2 ? samples : sizeof(bytes) / 2;
+        for (i = 0; i < count; i++)
+            Put16(bytes + i * 2, (uint16_t)pcm[i]);
+        sink->Hash = HostSinkHash(sink->Hash, bytes, count * 2);
+        if (sink->File != NULL)
+            fwrite(bytes, 2, count, sink->File);
+        pcm += count;
+        samples -= count;
+    }
+}
+
+
+void HostSinkClose (hostSink_t * sink) {
+    if (sink->File == NULL)
+        return;
+    if (sink->Wav)
+        WriteHeader(sink);
+    fclose(sink->File);
+    sink->File = NULL;
+}
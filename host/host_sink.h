@@ -0,0 +1,33 @@
+// Host Sink Header File
+// Where the host build's audio goes instead of I2S: a 16-bit mono WAV file, or nowhere, to time the
+// decoding on its own.  Raw files, without a header, are for opus_compare.  host_audio_out.c hands
+// every finished buffer to the current sink.  Either way the sink keeps a hash of everything
+// written, which tools/conformance.py checks against golden values.
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#ifndef HOST_SINK_H
+#define HOST_SINK_H
+
+#define HOST_SINK_HASH_BASIS 0xCBF29CE484222325ull
+#define HOST_SINK_HASH_PRIME 0x100000001B3ull
+
+typedef struct {
+    FILE * File;        // NULL for the null sink.
+    bool Wav;           // File has a WAV header to fill in on close.  Otherwise it's raw samples.
+    uint32_t Rate;
+    uint64_t Samples;   // Written so far.
+    uint64_t Hash;      // FNV-1a of the samples as little-endian bytes, to compare output between builds.
+} hostSink_t;
+
+bool HostSinkOpenWav (hostSink_t * sink, const char * path, uint32_t rate);
+bool HostSinkOpenRaw (hostSink_t * sink, const char * path, uint32_t rate);
+void HostSinkOpenNull (hostSink_t * sink, uint32_t rate);
+void HostSinkWrite (hostSink_t * sink, const int16_t * pcm, uint32_t samples);
+void HostSinkClose (hostSink_t * sink);
+uint64_t HostSinkHash (uint64_t hash, const uint8_t * bytes, size_t length);
+
+void AudioOutSetSink (hostSink_t * sink);
+
+#endif
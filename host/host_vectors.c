@@ -0,0 +1,96 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "decoder_pool.h"
+#include "host_sink.h"
+#include "host_vectors.h"
+#include "opus_scratch.h"
+
+static uint8_t packet[HOST_VECTORS_MAX_PACKET];
+static int16_t pcm[48 * HOST_VECTORS_MAX_MS];
+
+
+static bool ReadBigEndian (FILE * file, uint32_t * value) {
+    uint8_t bytes[4];
+    if (fread(bytes, 1, sizeof(bytes), file) != sizeof(bytes))
+        return false;
+    *value = (uint32_t)bytes[0] << 24 | (uint32_t)bytes[1] << 16 | (uint32_t)bytes[2] << 8 | bytes[3];
+    return true;
+}
+
+
+// Decode one .bit file to mono at rate, into outPath (16-bit little-endian, or NULL for none).  Each
+// record is a big-endian length and final range, then the packet; a zero length is a lost packet,
+// concealed for as long as the last one.  Prints a summary and returns true if every range matched.
+bool HostVectorDecode (const char * bitPath, const char * outPath, int32_t rate) {
+    FILE * in = fopen(bitPath, "rb");
+    hostSink_t sink;
+    OpusDecoder * decoder;
+    uint32_t length, range, decodedRange;
+    opus_int32 duration;
+    uint32_t packets = 0, lost = 0, mismatches = 0, errors = 0;
+    int samples;
+
+    if (in == NULL) {
+        fprintf(stderr, "Can't read %s.\n", bitPath);
+        return false;
+    }
+    if (outPath == NULL)
+        HostSinkOpenNull(&sink, (uint32_t)rate);
+    else if (!HostSinkOpenRaw(&sink, outPath, (uint32_t)rate)) {
+        fprintf(stderr, "Can't write %s.\n", outPath);
+        fclose(in);
+        return false;
+    }
+    decoder = DecoderPoolAcquire(rate, 1);
+    if (decoder == NULL) {
+        fprintf(stderr, "No decoder for %d Hz.\n", (int)rate);
+        HostSinkClose(&sink);
+        fclose(in);
+        return false;
+    }
+
+    while (ReadBigEndian(in, &length) && ReadBigEndian(in, &range)) {
+        if (length > sizeof(packet) || fread(packet, 1, length, in) != length) {
+            fprintf(stderr, "%s: bad packet %u.\n", bitPath, (unsigned)packets);
+            errors++;
+            break;
+        }
+
+        OpusScratchAcquire();
+        if (length == 0) {
+            opus_decoder_ctl(decoder, OPUS_GET_LAST_PACKET_DURATION(&duration));
+            samples = opus_decode(decoder, NULL, 0, pcm, duration, 0);
+            lost++;
+        } else {
+            samples = opus_decode(decoder, packet, (opus_int32)length, pcm, rate / 1000 * HOST_VECTORS_MAX_MS, 0);
+        }
+        OpusScratchRelease();
+
+        if (samples < 0) {
+            errors++;
+        } else {
+            opus_decoder_ctl(decoder, OPUS_GET_FINAL_RANGE(&decodedRange));
+            if (length && decodedRange != range) {
+                if (!mismatches)
+                    fprintf(stderr, "%s: range mismatch in packet %u.\n", bitPath, (unsigned)packets);
+                mismatches++;
+            }
+            HostSinkWrite(&sink, pcm, (uint32_t)samples);
+        }
+        packets++;
+    }
+
+    DecoderPoolRelease(decoder);
+    fclose(in);
+    HostSinkClose(&sink);
+    if (!OpusScratchCheck()) {
+        fprintf(stderr, "Opus scratch arena overflowed.\n");
+        errors++;
+    }
+
+    printf("%s: %u packets, %u lost, %u range mismatches, %u errors.\n", bitPath, (unsigned)packets,
+           (unsigned)lost, (unsigned)mismatches, (unsigned)errors);
+    printf("PCM: %llu samples, hash %016llx.\n", (unsigned long long)sink.Samples, (unsigned long long)sink.Hash);
+    return mismatches == 0 && errors == 0;
+}
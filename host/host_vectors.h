@@ -0,0 +1,17 @@
+// Host Vectors Header File
+// Decodes the official Opus test vectors (the testvectorNN.bit files from opus-codec.org, in
+// opus_demo's format) with this project's build of Opus and a decoder from the pool, as the player
+// would.  The final range coder state of every packet is checked against the encoder's, which is
+// bit-exact for the entropy decoding, and the PCM is written raw for opus_compare to judge.
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifndef HOST_VECTORS_H
+#define HOST_VECTORS_H
+
+#define HOST_VECTORS_MAX_PACKET (1275 * 6)  // Six frames of the largest Opus frame.
+#define HOST_VECTORS_MAX_MS 120
+
+bool HostVectorDecode (const char * bitPath, const char * outPath, int32_t rate);
+
+#endif
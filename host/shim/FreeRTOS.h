@@ -0,0 +1,25 @@
+// Host stand-in for the FreeRTOS pieces the player core uses.  There's one thread, so the heap is
+// just malloc.
+#include <stdint.h>
+#include <stdlib.h>
+
+#ifndef HOST_FREERTOS_H
+#define HOST_FREERTOS_H
+
+typedef uint32_t TickType_t;
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+
+#define configMINIMAL_STACK_SIZE 256
+#define tskIDLE_PRIORITY 0
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+
+static inline void * pvPortMalloc (size_t size) {
+    return malloc(size);
+}
+
+static inline void vPortFree (void * block) {
+    free(block);
+}
+
+#endif
@@ -0,0 +1 @@
+// Host stand-in.  Only hot_profile.c includes this, and on the host it's built without OPUS_HOT_PROFILE.
@@ -0,0 +1,19 @@
+// Host stand-in for pico-extras' audio buffer types.  Only the fields the player core touches.
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef HOST_PICO_AUDIO_I2S_H
+#define HOST_PICO_AUDIO_I2S_H
+
+typedef struct mem_buffer {
+    size_t size;
+    uint8_t * bytes;
+} mem_buffer_t;
+
+typedef struct audio_buffer {
+    mem_buffer_t * buffer;
+    uint32_t sample_count;
+    uint32_t max_sample_count;
+} audio_buffer_t;
+
+#endif
@@ -0,0 +1,30 @@
+// Host stand-in for the bits of pico/platform.h the player core uses.
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifndef HOST_PICO_PLATFORM_H
+#define HOST_PICO_PLATFORM_H
+
+typedef unsigned int uint;
+
+#define __not_in_flash(group)
+#define __not_in_flash_func(f) f
+#define __time_critical_func(f) f
+#define __scratch_x(group)
+#define __scratch_y(group)
+#define __unused __attribute__((unused))
+
+static inline void panic (const char * format, ...) {
+    va_list ap;
+    va_start(ap, format);
+    vfprintf(stderr, format, ap);
+    va_end(ap);
+    exit(1);
+}
+
+static inline uint get_core_num (void) {
+    return 0;
+}
+
+#endif
@@ -0,0 +1,21 @@
+// Host stand-in for pico/stdlib.h.  Time comes from the monotonic clock.
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "pico/platform.h"
+
+#ifndef HOST_PICO_STDLIB_H
+#define HOST_PICO_STDLIB_H
+
+static inline uint64_t time_us_64 (void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000u + (uint64_t)now.tv_nsec / 1000u;
+}
+
+static inline uint32_t time_us_32 (void) {
+    return (uint32_t)time_us_64();
+}
+
+#endif
@@ -0,0 +1,24 @@
+// Host stand-in for FreeRTOS task.h.  The host build runs everything on one thread, so there's no
+// one to notify.
+#include "FreeRTOS.h"
+
+#ifndef HOST_TASK_H
+#define HOST_TASK_H
+
+typedef void * TaskHandle_t;
+
+static inline TaskHandle_t xTaskGetCurrentTaskHandle (void) {
+    return NULL;
+}
+
+static inline BaseType_t xTaskNotifyGive (TaskHandle_t task) {
+    (void)task;
+    return 1;
+}
+
+static inline void vTaskCoreAffinitySet (TaskHandle_t task, UBaseType_t mask) {
+    (void)task;
+    (void)mask;
+}
+
+#endif
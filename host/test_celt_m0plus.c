@@ -0,0 +1,81 @@
+/**
+ * opus_celt_m0plus.c host test
+ * Runs clt_mdct_backward_m0plus and Opus' own clt_mdct_backward_c on the same input and checks the
+ * outputs are bit for bit the same.  It covers every transform of CELT's 48kHz mode, as the decoder
+ * calls them: the long MDCT of each frame size with a stride of 1, and the short blocks of a
+ * transient with the stride of their interleaving.  The 20ms sizes are the ones the M0+ versions
+ * replace; the rest go through to clt_mdct_backward_c and should match trivially.  The inputs are
+ * random at every magnitude, full scale included, so the wrap-around has to match too.  Exits
+ * non-zero if any output differs.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "opus_custom.h"
+#include "modes.h"
+#include "opus_celt_m0plus.h"
+
+#define TRIALS 500
+#define MAX_REPORTS 20
+
+static uint32_t seed = 1;
+static int failures = 0;
+
+
+// A random value at a random magnitude, as in test_m0plus.c.
+static opus_int32 Random (void) {
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return (opus_int32)seed >> (seed % 31);
+}
+
+
+// One transform, both ways, from the same input and the same starting output buffer.
+static void Check (const CELTMode * mode, int shift, int stride) {
+    static kiss_fft_scalar in[960];
+    static kiss_fft_scalar want[960 + 240], got[960 + 240];
+    int n2 = mode->mdct.n >> (shift + 1);
+    int trial, i;
+
+    for (trial = 0; trial < TRIALS; trial++) {
+        for (i = 0; i < n2 * stride; i++)
+            in[i] = trial % 4 ? Random() >> (trial % 4 * 4) : Random();
+        for (i = 0; i < (int)(sizeof(want) / sizeof(want[0])); i++)
+            want[i] = got[i] = Random();
+
+        clt_mdct_backward_c(&mode->mdct, in, want, mode->window, mode->overlap, shift, stride, 0);
+        clt_mdct_backward_m0plus(&mode->mdct, in, got, mode->window, mode->overlap, shift, stride, 0);
+
+        if (memcmp(want, got, sizeof(want)) != 0) {
+            for (i = 0; want[i] == got[i]; i++)
+                ;
+            if (failures++ < MAX_REPORTS)
+                printf("shift %d, stride %d, trial %d: output %d is %d, clt_mdct_backward_c gave %d.\n",
+                       shift, stride, trial, i, (int)got[i], (int)want[i]);
+        }
+    }
+}
+
+
+int main (void) {
+    int error = 0, shift;
+    const CELTMode * mode = opus_custom_mode_create(48000, 960, &error);
+
+    if (mode == NULL) {
+        printf("No 48kHz CELT mode (error %d).\n", error);
+        return 1;
+    }
+    for (shift = 0; shift <= mode->maxLM; shift++)
+        Check(mode, shift, 1);
+    Check(mode, mode->maxLM, mode->nbShortMdcts);
+
+    if (failures) {
+        printf("%d transforms differ from clt_mdct_backward_c.\n", failures);
+        return 1;
+    }
+    printf("clt_mdct_backward_m0plus matches clt_mdct_backward_c.\n");
+    return 0;
+}
@@ -0,0 +1,82 @@
+/**
+ * flash_stream host test
+ * Runs the ring bookkeeping in flash_stream.c, built with FLASH_STREAM_SYNC so transfers are a
+ * memcpy, against a plain copy of the source: forward reads of packet sizes with small skips like
+ * the Ogg reader makes, then reads anywhere at all, including backwards and bigger than the ring.
+ * Each is done at all four source alignments, since the ring is indexed by address.  Exits non-zero
+ * at the first read that comes back wrong.
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "flash_stream.h"
+
+#define SOURCE_LENGTH 20000
+#define RANDOM_READS 5000
+
+static uint8_t source[SOURCE_LENGTH + 4];
+static uint8_t buffer[2 * FLASH_STREAM_RING];
+static flashStream_t stream;
+static uint32_t seed = 1;
+
+
+static uint32_t Random (uint32_t range) {
+    seed = seed * 1664525u + 1013904223u;
+    return (seed >> 8) % range;
+}
+
+
+// Read length bytes at offset through the stream and compare them with the source.
+static bool Check (const uint8_t * data, size_t offset, size_t length) {
+    FlashStreamRead(&stream, offset, buffer, length);
+    if (memcmp(buffer, data + offset, length) != 0) {
+        printf("Reading %u bytes at %u came back wrong.\n", (unsigned)length, (unsigned)offset);
+        return false;
+    }
+    return true;
+}
+
+
+int main (void) {
+    const uint8_t *data;
+    size_t offset, length;
+    int align, i;
+
+    for (i = 0; i < (int)sizeof(source); i++)
+        source[i] = (uint8_t)Random(256);
+    FlashStreamInit(&stream);
+
+    for (align = 0; align < 4; align++) {
+        data = source + align;
+        FlashStreamOpen(&stream, data, SOURCE_LENGTH);
+
+        for (offset = 0; offset < SOURCE_LENGTH; offset += length) {
+            if (Random(8) == 0)
+                offset += Random(64);
+            length = 1 + Random(300);
+            if (offset >= SOURCE_LENGTH)
+                break;
+            if (length > SOURCE_LENGTH - offset)
+                length = SOURCE_LENGTH - offset;
+            if (!Check(data, offset, length))
+                return 1;
+        }
+
+        for (i = 0; i < RANDOM_READS; i++) {
+            offset = Random(SOURCE_LENGTH);
+            length = 1 + Random(sizeof(buffer));
+            if (length > SOURCE_LENGTH - offset)
+                length = SOURCE_LENGTH - offset;
+            if (!Check(data, offset, length))
+                return 1;
+        }
+
+        FlashStreamClose(&stream);
+    }
+
+    FlashStreamPrint();
+    printf("Flash stream reads match the source.\n");
+    return 0;
+}
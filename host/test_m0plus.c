@@ -0,0 +1,103 @@
+/**
+ * opus_m0plus.h host test
+ * Checks each macro in opus_m0plus.h against the generic 32-bit Opus macro it replaces, wrap-around
+ * included, over edge values and a few million random ones of every magnitude.  A 64-bit host has
+ * OPUS_FAST_INT64 set, which would leave opus_m0plus.h out, so this is built with OPUS_M0PLUS_FORCE
+ * to get the M0+ versions anyway, and with -fwrapv because the generic macros rely on signed
+ * overflow wrapping the way it does on the Pico.  Exits non-zero if any result differs.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "opus_m0plus.h"
+
+#ifndef OPUS_M0PLUS_FORCE
+    #error "Build with OPUS_M0PLUS_FORCE, or on a 64-bit host this tests nothing."
+#endif
+
+// The !OPUS_FAST_INT64 definitions from silk/macros.h, silk/SigProc_FIX.h and celt/fixed_generic.h,
+// copied as they are.  The helpers they use (silk_MLA, silk_RSHIFT_ROUND, MULT16_16 and so on) are
+// Opus' own and opus_m0plus.h leaves them alone.
+#define generic_silk_SMULWB(a32, b32)        ((((a32) >> 16) * (opus_int32)((opus_int16)(b32))) + ((((a32) & 0x0000FFFF) * (opus_int32)((opus_int16)(b32))) >> 16))
+#define generic_silk_SMLAWB(a32, b32, c32)   ((opus_int32)((a32) + generic_silk_SMULWB((b32), (c32))))
+#define generic_silk_SMULWT(a32, b32)        (((a32) >> 16) * ((b32) >> 16) + ((((a32) & 0x0000FFFF) * ((b32) >> 16)) >> 16))
+#define generic_silk_SMLAWT(a32, b32, c32)   ((opus_int32)((a32) + generic_silk_SMULWT((b32), (c32))))
+#define generic_silk_SMULWW(a32, b32)        (opus_int32)silk_MLA(generic_silk_SMULWB((a32), (b32)), (a32), silk_RSHIFT_ROUND((b32), 16))
+#define generic_silk_SMLAWW(a32, b32, c32)   (opus_int32)silk_MLA(generic_silk_SMLAWB((a32), (b32), (c32)), (b32), silk_RSHIFT_ROUND((c32), 16))
+#define generic_silk_SMMUL(a32, b32)         (opus_int32)silk_RSHIFT64(silk_SMULL((a32), (b32)), 32)
+#define generic_MULT16_32_Q15(a, b)          ADD32(SHL(MULT16_16((a), SHR((b), 16)), 1), SHR(MULT16_16SU((a), ((b) & 0x0000ffff)), 15))
+#define generic_MULT16_32_Q16(a, b)          ADD32(MULT16_16((a), SHR((b), 16)), SHR(MULT16_16SU((a), ((b) & 0x0000ffff)), 16))
+
+#define RANDOM_CASES 4000000
+#define MAX_REPORTS 20
+
+static const opus_int32 edges[] = {
+    0, 1, -1, 2, -2, 0x7FFF, -0x7FFF, 0x8000, -0x8000, 0xFFFF, -0xFFFF, 0x10000, -0x10000, 0x10001,
+    0x7FFF0000, 0x7FFFFFFF, -0x7FFFFFFF, (opus_int32)0x80000000, (opus_int32)0x80008000, (opus_int32)0xFFFF8000,
+    0x12345678, -0x12345678, 0x00018000, 0x3FFFFFFF, -0x40000000
+};
+#define EDGE_COUNT ((int)(sizeof(edges) / sizeof(edges[0])))
+
+static uint32_t seed = 1;
+static int failures = 0;
+
+
+// A random value at a random magnitude, so small operands get as much testing as large ones.
+static opus_int32 Random (void) {
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return (opus_int32)seed >> (seed % 31);
+}
+
+
+static void Report (const char * name, opus_int32 a, opus_int32 b, opus_int32 c, opus_int32 got, opus_int32 want) {
+    if (failures++ < MAX_REPORTS)
+        printf("%s(%d, %d, %d) gave %d, the generic macro %d.\n", name, (int)a, (int)b, (int)c, (int)got, (int)want);
+}
+
+
+#define COMPARE2(name, a, b) do { \
+        opus_int32 got = (opus_int32)(name((a), (b))), want = (opus_int32)(generic_##name((a), (b))); \
+        if (got != want) Report(#name, (a), (b), 0, got, want); \
+    } while (0)
+
+#define COMPARE3(name, a, b, c) do { \
+        opus_int32 got = (opus_int32)(name((a), (b), (c))), want = (opus_int32)(generic_##name((a), (b), (c))); \
+        if (got != want) Report(#name, (a), (b), (c), got, want); \
+    } while (0)
+
+
+static void Check (opus_int32 a, opus_int32 b, opus_int32 c) {
+    opus_val16 a16 = (opus_val16)a;
+
+    COMPARE2(silk_SMULWB, a, b);
+    COMPARE3(silk_SMLAWB, c, a, b);
+    COMPARE2(silk_SMULWT, a, b);
+    COMPARE3(silk_SMLAWT, c, a, b);
+    COMPARE2(silk_SMULWW, a, b);
+    COMPARE3(silk_SMLAWW, c, a, b);
+    COMPARE2(silk_SMMUL, a, b);
+    COMPARE2(MULT16_32_Q15, a16, b);
+    COMPARE2(MULT16_32_Q16, a16, b);
+}
+
+
+int main (void) {
+    int i, j, k;
+
+    for (i = 0; i < EDGE_COUNT; i++)
+        for (j = 0; j < EDGE_COUNT; j++)
+            for (k = 0; k < EDGE_COUNT; k++)
+                Check(edges[i], edges[j], edges[k]);
+    for (i = 0; i < RANDOM_CASES; i++)
+        Check(Random(), Random(), Random());
+
+    if (failures) {
+        printf("%d results differ from the generic macros.\n", failures);
+        return 1;
+    }
+    printf("opus_m0plus.h matches the generic macros.\n");
+    return 0;
+}
@@ -0,0 +1,159 @@
+/**
+ * opus_silk_m0plus.c host test
+ * Runs silk_decode_core_m0plus and silk_NLSF2A_m0plus next to Opus' own silk_decode_core and
+ * silk_NLSF2A on the same input, and checks they give bit for bit the same results.
+ * silk_decode_core is given random decoder states at 8, 12 and 16kHz (LPC orders 10 and 16), with 2 or
+ * 4 subframes.  They mix voiced, unvoiced and inactive frames, and gains that change or stay put.
+ * Some follow a lost voiced frame.  The output, the decoder state and the control struct must all
+ * match.  silk_NLSF2A is given random NLSFs at both orders, some bunched close enough to need its
+ * stabilising loop.  Exits non-zero if anything differs.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "main.h"
+#include "opus_silk_m0plus.h"
+
+#define TRIALS 2000
+#define MAX_REPORTS 20
+
+static uint32_t seed = 1;
+static int failures = 0;
+
+// Kept off the stack: silk_decoder_state is several K.
+static silk_decoder_state wantState, gotState;
+static silk_decoder_control wantControl, gotControl;
+
+
+static uint32_t Random (void) {
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return seed;
+}
+
+
+// A random value from low to high, inclusive.
+static opus_int32 Between (opus_int32 low, opus_int32 high) {
+    return low + (opus_int32)(Random() % (uint32_t)(high - low + 1));
+}
+
+
+static int CompareInt16 (const void * a, const void * b) {
+    return *(const opus_int16 *)a - *(const opus_int16 *)b;
+}
+
+
+// Random NLSFs for an order, rising, at least gap apart.  A small gap puts resonances close together.
+static void RandomNlsf (opus_int16 * nlsf, int order, int gap) {
+    int i;
+    for (i = 0; i < order; i++)
+        nlsf[i] = (opus_int16)Between(1, 32767 - gap * order);
+    qsort(nlsf, order, sizeof(opus_int16), CompareInt16);
+    for (i = 0; i < order; i++)
+        nlsf[i] = (opus_int16)(nlsf[i] + gap * i);
+}
+
+
+static void Report (const char * what, int trial, const char * detail) {
+    if (failures++ < MAX_REPORTS)
+        printf("%s, trial %d: %s differs.\n", what, trial, detail);
+}
+
+
+static void CheckNlsf2a (int trial) {
+    opus_int16 nlsf[MAX_LPC_ORDER], want[MAX_LPC_ORDER], got[MAX_LPC_ORDER];
+    int order = trial & 1 ? 16 : 10;
+
+    RandomNlsf(nlsf, order, trial % 4 == 3 ? Between(0, 20) : Between(50, 800));
+    silk_NLSF2A(want, nlsf, order, 0);
+    silk_NLSF2A_m0plus(got, nlsf, order, 0);
+    if (memcmp(want, got, order * sizeof(opus_int16)) != 0)
+        Report(order == 16 ? "NLSF2A, order 16" : "NLSF2A, order 10", trial, "a_Q12");
+}
+
+
+// A decoder state and control for one frame at fs_kHz, as silk_decode_frame would pass them in.
+static void RandomFrame (silk_decoder_state * state, silk_decoder_control * control, opus_int16 * pulses,
+                         int fs_kHz, int subframes) {
+    static const opus_int16 ltpScales[3] = { 15565, 12288, 8192 };
+    opus_int16 nlsf[MAX_LPC_ORDER];
+    int i, k, lag;
+
+    silk_init_decoder(state);
+    state->nb_subfr = subframes;
+    silk_decoder_set_fs(state, fs_kHz, 48000);
+
+    state->indices.signalType = (opus_int8)Between(TYPE_NO_VOICE_ACTIVITY, TYPE_VOICED);
+    state->indices.quantOffsetType = (opus_int8)Between(0, 1);
+    state->indices.NLSFInterpCoef_Q2 = (opus_int8)Between(0, 4);
+    state->indices.Seed = (opus_int8)Between(0, 3);
+    state->prev_gain_Q16 = Between(1 << 16, 1 << 26);
+    state->lossCnt = Between(0, 1);
+    state->prevSignalType = Between(TYPE_NO_VOICE_ACTIVITY, TYPE_VOICED);
+    state->lagPrev = Between(2 * fs_kHz, 18 * fs_kHz);
+    for (i = 0; i < MAX_LPC_ORDER; i++)
+        state->sLPC_Q14_buf[i] = Between(-(1 << 20), 1 << 20);
+    for (i = 0; i < (int)(sizeof(state->outBuf) / sizeof(state->outBuf[0])); i++)
+        state->outBuf[i] = (opus_int16)Between(-20000, 20000);
+
+    // The subframes' lags are near each other, as silk_decode_pitch's contours make them.  Further
+    // apart, the LTP would read history neither version has filled in.
+    memset(control, 0, sizeof(*control));
+    lag = Between(2 * fs_kHz + 10, 18 * fs_kHz - 10);
+    for (k = 0; k < subframes; k++) {
+        control->pitchL[k] = lag + Between(-10, 10);
+        control->Gains_Q16[k] = Random() & 1 ? state->prev_gain_Q16 : Between(1 << 16, 1 << 26);
+    }
+    for (i = 0; i < 2; i++) {
+        RandomNlsf(nlsf, state->LPC_order, Between(50, 800));
+        silk_NLSF2A(control->PredCoef_Q12[i], nlsf, state->LPC_order, 0);
+    }
+    for (i = 0; i < subframes * LTP_ORDER; i++)
+        control->LTPCoef_Q14[i] = (opus_int16)Between(-3000, 12000);
+    control->LTP_scale_Q14 = ltpScales[Between(0, 2)];
+
+    for (i = 0; i < state->frame_length; i++)
+        pulses[i] = (opus_int16)(Random() % 8 ? Between(-3, 3) : Between(-60, 60));
+}
+
+
+static void CheckDecodeCore (int trial) {
+    static const int rates[3] = { 8, 12, 16 };
+    opus_int16 pulses[MAX_FRAME_LENGTH], want[MAX_FRAME_LENGTH], got[MAX_FRAME_LENGTH];
+    const char * what;
+
+    RandomFrame(&wantState, &wantControl, pulses, rates[trial % 3], trial % 5 == 4 ? 2 : 4);
+    memcpy(&gotState, &wantState, sizeof(gotState));
+    memcpy(&gotControl, &wantControl, sizeof(gotControl));
+    what = wantState.LPC_order == 16 ? "decode_core, order 16" : "decode_core, order 10";
+
+    silk_decode_core(&wantState, &wantControl, want, pulses, 0);
+    silk_decode_core_m0plus(&gotState, &gotControl, got, pulses, 0);
+    if (memcmp(want, got, wantState.frame_length * sizeof(opus_int16)) != 0)
+        Report(what, trial, "xq");
+    if (memcmp(&wantState, &gotState, sizeof(wantState)) != 0)
+        Report(what, trial, "decoder state");
+    if (memcmp(&wantControl, &gotControl, sizeof(wantControl)) != 0)
+        Report(what, trial, "decoder control");
+}
+
+
+int main (void) {
+    int trial;
+
+    for (trial = 0; trial < TRIALS; trial++) {
+        CheckNlsf2a(trial);
+        CheckDecodeCore(trial);
+    }
+
+    if (failures) {
+        printf("%d results differ from silk_decode_core and silk_NLSF2A.\n", failures);
+        return 1;
+    }
+    printf("silk_decode_core_m0plus and silk_NLSF2A_m0plus match silk_decode_core and silk_NLSF2A.\n");
+    return 0;
+}
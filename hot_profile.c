@@ -0,0 +1,98 @@
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "hardware/irq.h"
+#include "hardware/timer.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "hot_profile.h"
+
+#ifdef OPUS_HOT_PROFILE
+
+static uint32_t samplePcs[HOT_PROFILE_SAMPLES];
+static volatile uint32_t sampleCount = 0;
+static volatile bool gated = false;
+static int alarmNum = -1;
+
+void HotProfileSample (uint32_t * frame);
+
+
+// The alarm's interrupt handler.  Finds the exception frame the interrupted code left, on the
+// process stack if it was a task or the main stack if it was another handler, and hands it to
+// HotProfileSample.  Branching rather than calling keeps EXC_RETURN in lr, so the C function's
+// return is the exception return.
+static void __attribute__((naked)) __not_in_flash_func(HotProfileIrq) (void) {
+    __asm volatile (
+        "movs r0, #4          \n"
+        "mov r1, lr           \n"
+        "tst r0, r1           \n"
+        "beq 1f               \n"
+        "mrs r0, psp          \n"
+        "b 2f                 \n"
+        "1: mrs r0, msp       \n"
+        "2: ldr r1, =HotProfileSample \n"
+        "bx r1                \n"
+        ".align 2             \n"
+        ".ltorg               \n"
+    );
+}
+
+
+// Record the stacked PC (word 6 of the frame) if a decode is running, and set the next alarm.
+void __not_in_flash_func(HotProfileSample) (uint32_t * frame) {
+    uint32_t count = sampleCount;
+
+    hw_clear_bits(&timer_hw->intr, 1u << alarmNum);
+    if (gated && count < HOT_PROFILE_SAMPLES) {
+        samplePcs[count] = frame[6];
+        sampleCount = count + 1;
+    }
+    timer_hw->alarm[alarmNum] = timer_hw->timerawl + HOT_PROFILE_PERIOD_US;
+}
+
+
+// Start sampling.  Call from the task that decodes: the alarm interrupt fires on the core that
+// sets it up, so the task is pinned to this core to stay in view.
+void HotProfileInit (void) {
+    uint core = get_core_num();
+
+    vTaskCoreAffinitySet(NULL, 1 << core);
+    alarmNum = hardware_alarm_claim_unused(true);
+    irq_set_exclusive_handler(TIMER_IRQ_0 + alarmNum, HotProfileIrq);
+    hw_set_bits(&timer_hw->inte, 1u << alarmNum);
+    irq_set_enabled(TIMER_IRQ_0 + alarmNum, true);
+    timer_hw->alarm[alarmNum] = timer_hw->timerawl + HOT_PROFILE_PERIOD_US;
+    printf("Hot profile sampling every %u us on core %u.\r\n", HOT_PROFILE_PERIOD_US, core);
+}
+
+
+// Only samples taken inside a decode are kept.
+void HotProfileGate (bool decoding) {
+    gated = decoding;
+}
+
+
+void HotProfileReset (void) {
+    sampleCount = 0;
+}
+
+
+// Dump the samples for tools/hot_placement.py.
+void HotProfilePrint (void) {
+    uint32_t i, count = sampleCount;
+
+    printf("HOTPROFILE %u %u\r\n", (unsigned)count, HOT_PROFILE_PERIOD_US);
+    for (i = 0; i < count; i++)
+        printf("%08x%s", (unsigned)samplePcs[i], (i % 8 == 7 || i == count - 1) ? "\r\n" : " ");
+    printf("HOTPROFILE END\r\n");
+}
+
+#else
+
+void HotProfileInit (void) {}
+void HotProfileGate (bool decoding) { (void)decoding; }
+void HotProfileReset (void) {}
+void HotProfilePrint (void) { printf("Not built with OPUS_HOT_PROFILE.\r\n"); }
+
+#endif
@@ -0,0 +1,21 @@
+// Hot Code Profiler Header File
+// When built with OPUS_HOT_PROFILE, samples the program counter from a timer interrupt while a
+// decode is in progress, to find which functions are worth moving out of XIP flash into SRAM.
+// Dump the samples with `profile` on the console and feed the output to tools/hot_placement.py,
+// which writes opus_hot_functions.txt for the OPUS_HOT_PLACEMENT build.
+// Without OPUS_HOT_PROFILE these all do nothing.
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifndef HOT_PROFILE_H
+#define HOT_PROFILE_H
+
+#define HOT_PROFILE_SAMPLES 4096  // PCs kept.  Sampling stops when it's full.
+#define HOT_PROFILE_PERIOD_US 97  // Odd, so it doesn't beat with the 1ms tick.
+
+void HotProfileInit (void);
+void HotProfileGate (bool decoding);
+void HotProfileReset (void);
+void HotProfilePrint (void);
+
+#endif
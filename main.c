@@ -14,55 +14,25 @@
 
 #include "settings.h"
 
-#include "pico/audio_i2s.h"
-#include "ogg_stripper.h"
+#include "asset_bundle.h"
+#include "audio_out.h"
+#include "bench.h"
 #include "ogg_data.h"
-#include "opus.h"
+#include "opus_scratch.h"
+#include "player.h"
+#include "phrase.h"
+#include "postproc.h"
+#include "render.h"
+#include "resampler.h"
+#include "console.h"
+#include "decode_stats.h"
+#include "hot_profile.h"
+#include "clock_governor.h"
 
 #ifdef PICO_W
     #include "pico/cyw43_arch.h"
 #endif
 
-#define SAMPLES_PER_BUFFER 1920 // See the comment for opus_decode.  This is 120ms of audio at 16kHz.  I've used less
-                                // than this in the past and it was fine.
-#define OGG_BUF_LEN 0xFF
-
-// This is the audio init structure.  It's used to set up the audio device.
-// This is taken pretty verbatim from the Pico Audio example.
-struct audio_buffer_pool *init_audio() {
-    static audio_format_t audio_format = {
-            .format = AUDIO_BUFFER_FORMAT_PCM_S16,
-            .sample_freq = 16000,
-            .channel_count = 1,
-    };
-
-    static struct audio_buffer_format producer_format = {
-            .format = &audio_format,
-            .sample_stride = 2
-    };
-
-    struct audio_buffer_pool *producer_pool = audio_new_producer_pool(&producer_format, 3, SAMPLES_PER_BUFFER);
-    bool __unused ok;
-    const struct audio_format *output_format;
-
-    struct audio_i2s_config config = {
-            .data_pin = I2S_DATA_PIN,
-            .clock_pin_base = I2S_CLOCK_PIN,
-            .dma_channel = 0,
-            .pio_sm = 0,
-    };
-
-    output_format = audio_i2s_setup(&audio_format, &config);
-    if (!output_format) {
-        panic("PicoAudio: Unable to open audio device.\n");
-    }
-
-    ok = audio_i2s_connect(producer_pool);
-    assert(ok);
-    audio_i2s_set_enabled(true);
-    return producer_pool;
-}
-
 // Declare the FreeRTOS tasks.
 static TaskHandle_t appTaskHandle;
 static void App_Task(void * argument);
@@ -75,9 +45,8 @@ static void CDC_Task(void * argument);
 
 // Set the clock speed, then init the tasks.
 void App_Init(void) {
-#if CLOCK_SPEED_KHZ != 133000
-    set_sys_clock_khz(CLOCK_SPEED_KHZ, true);
-#endif
+    ClockGovernorInit();
+    AssetBundleInit();
 
     xTaskCreate( App_Task,             /* The function that implements the task. */
                  "App",                /* The text name assigned to the task - for debug only as it is not used by the kernel. */
@@ -102,15 +71,27 @@ void App_Init(void) {
 
 }
 
+// The clips phrases can be built from.
+static const phraseClip_t clipLibrary[] = {
+    { SAMPLE_ID, Sample, SAMPLE_LENGTH },
+};
+
+// Print how close the app task's stack has come to running out.  The words used are what
+// APP_TASK_STACK_MEASURED wants (see settings.h).
+static void ReportAppStack(void) {
+    UBaseType_t unused = uxTaskGetStackHighWaterMark(NULL);
+
+    printf("App stack: %u of %u words used, %u never.\r\n", (unsigned)(APP_TASK_STACK_SIZE - unused),
+           (unsigned)APP_TASK_STACK_SIZE, (unsigned)unused);
+    if (unused < APP_TASK_STACK_MARGIN)
+        printf("That's under the %u word margin.  Increase APP_TASK_STACK_SIZE.\r\n", (unsigned)APP_TASK_STACK_MARGIN);
+}
+
 // This is the main task.  It's responsible for blinking the LED and playing the audio.
 static void App_Task(void * argument) {
     (void) argument;  // Unused parameter
     absolute_time_t nextBlink = make_timeout_time_ms(500);
     bool blinkState = true;
-    size_t bytesWritten = 0;
-    int samplesDecoded = 0;
-    int packetsDecoded = 0;
-    int decoderError = 0;
 
 #ifdef PICO_W
     cyw43_arch_init();
@@ -119,34 +100,69 @@ static void App_Task(void * argument) {
     gpio_set_dir(LED_PIN, GPIO_OUT);
 #endif
 
-    struct audio_buffer_pool *ap = init_audio();
+    AudioOutInit();
     audio_buffer_t *buffer;
-    OpusDecoder *decoder = opus_decoder_create(16000, 1, &decoderError);
-    uint8_t oggBuf[OGG_BUF_LEN];
-    int32_t oggBufBytes = 0;
-
-    OggSetSource(Sample, SAMPLE_LENGTH);
-    bool valid = OggPrepareFile();
+    resampler_t resampler;
+    int mode;
+    int32_t slack;
+    bool late = false;
+    bool playing;
+    uint32_t busyStart, busyUs, samples;
+    OpusScratchInit();
+    HotProfileInit();
+    PlayerInit();
+    PostProcInit(PLAYER_SAMPLE_RATE);
+    PhraseSetLibrary(clipLibrary, sizeof(clipLibrary) / sizeof(clipLibrary[0]));
+    PhraseSetBundle(AssetBundleBuiltIn()); // NULL unless built with ASSET_BUNDLE_DIR.
+    if (!ResamplerInit(&resampler, PLAYER_SAMPLE_RATE, AUDIO_OUT_SAMPLE_RATE))
+        panic("Can't resample %u Hz to %u Hz.\n", PLAYER_SAMPLE_RATE, AUDIO_OUT_SAMPLE_RATE);
+
+    playing = PlayerStart(0, SAMPLE_ID, Sample, SAMPLE_LENGTH, MIXER_GAIN_UNITY, 0);
 
     vTaskDelay(1000);
 
     while (1) {
-        if (valid) {
-            buffer = take_audio_buffer(ap, true);
+        // Pick up clips started from the console.
+        PhraseService();
+        PlayerService();
+        // A benchmark asked for on the console runs here, between clips, since it borrows the decoders.
+        if (!playing && PlayerIsIdle() && BenchService())
+            ReportAppStack();
+        if (!playing && !PlayerIsIdle()) {
+            ResamplerReset(&resampler);
+            late = false;
+            playing = true;
+        }
+
+        if (playing) {
+            buffer = AudioOutTake();
+
+            busyStart = time_us_32();
 
-            oggBufBytes = OggGetNextPacket(oggBuf, OGG_BUF_LEN);
-            if (oggBufBytes < 1) {
+            // Mix one block from every playing voice.  Nothing rendered means the last voice ended.
+            // If the last buffer missed its play-out time, decoding has fallen behind and the packets
+            // due now are late too, so they're concealed in place rather than decoded (see PlayerRender).
+            buffer->sample_count = RenderBlock(&resampler, (int16_t *)buffer->buffer->bytes, PLAYER_BLOCK_SAMPLES, late);
+            if (buffer->sample_count == 0) {
                 printf("Done!\r\n");
-                buffer->sample_count = 0;
-                valid = false;
-            } else {
-                buffer->sample_count = opus_decode(decoder, oggBuf, oggBufBytes,
-                                                   (int16_t *) buffer->buffer->bytes,
-                                                   (int) buffer->max_sample_count, 0);
+                printf("Opus scratch high-water: %u of %u bytes.\r\n",
+                       (unsigned)OpusScratchHighWater(), (unsigned)OpusScratchSize());
+                ReportAppStack();
+                playing = false;
             }
-
-            give_audio_buffer(ap, buffer);
+            mode = PlayerLastMode();
+
+            busyUs = time_us_32() - busyStart;
+            samples = buffer->sample_count;
+            slack = AudioOutGive(buffer);
+            late = slack < 0;
+            if (slack != AUDIO_OUT_NO_DEADLINE)
+                DecodeStatsRecordSlack(mode, slack);
+            ClockGovernorUpdate(busyUs, AudioOutBufferUs(samples), slack);
+        } else {
+            ClockGovernorIdle();
         }
+        AudioOutService();
 
         if ( to_us_since_boot(nextBlink) < to_us_since_boot( get_absolute_time() ) ) {
             uint32_t lastCore = get_core_num();
@@ -159,7 +175,13 @@ static void App_Task(void * argument) {
             blinkState = !blinkState;
             nextBlink = make_timeout_time_ms(500);
         }
-        vTaskDelay(1);
+
+        // With nothing to play and I2S parked, sleep until there's a request (or it's time to blink).
+        if (!playing && AudioOutParked()) {
+            int64_t untilBlinkUs = absolute_time_diff_us(get_absolute_time(), nextBlink);
+            ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(untilBlinkUs > 0 ? untilBlinkUs / 1000 + 1 : 1));
+        } else
+            vTaskDelay(1);
     }
 }
 
@@ -177,6 +199,7 @@ static void USB_Task(void * argument) {
 }
 
 // This is the CDC task.  It's responsible for handling CDC events.
+// Anything typed on the CDC port goes to the command console.  Type 'help' for a list.
 static void CDC_Task(void * argument) {
     (void) argument;  // Unused parameter
 
@@ -185,9 +208,8 @@ static void CDC_Task(void * argument) {
         while ( tud_cdc_available() ) {
             uint8_t buf[64];
 
-            // read and echo back
             uint32_t count = tud_cdc_read(buf, sizeof(buf));
-            tud_cdc_write(buf, count);
+            ConsoleInput(buf, count);
         }
 
         tud_cdc_write_flush();
@@ -197,6 +219,8 @@ static void CDC_Task(void * argument) {
 
 // This is the entry point for the program.
 // Call init, then start the scheduler to run the tasks.
+// The simulation (sim/) has a main() of its own, which calls App_Init.
+#ifndef PICO_SIM
 int main() {
     App_Init();
 
@@ -209,3 +233,4 @@ int main() {
     http://www.freertos.org/a00111.html. */
     for( ;; );
 }
+#endif
@@ -0,0 +1,120 @@
+#include <string.h>
+
+#include "mixer.h"
+
+static mixerVoice_t mixerVoices[MIXER_VOICES];
+static int16_t mixScratch[MIXER_MAX_BLOCK];
+
+
+void MixerStart (int voice, mixerSource_t source, void * context, int16_t gain, uint32_t startOffset) {
+    mixerVoice_t *v = &mixerVoices[voice];
+    v->Source = source;
+    v->Context = context;
+    v->Gain = gain;
+    v->StartOffset = startOffset;
+    v->Active = true;
+}
+
+
+void MixerStop (int voice) {
+    mixerVoices[voice].Active = false;
+}
+
+
+void MixerSetGain (int voice, int16_t gain) {
+    mixerVoices[voice].Gain = gain;
+}
+
+
+bool MixerVoiceActive (int voice) {
+    return mixerVoices[voice].Active;
+}
+
+
+bool MixerIsIdle (void) {
+    int voice;
+    for (voice = 0; voice < MIXER_VOICES; voice++) {
+        if (mixerVoices[voice].Active)
+            return false;
+    }
+    return true;
+}
+
+
+static inline int16_t Saturate (int32_t value) {
+    if (value > INT16_MAX)
+        return INT16_MAX;
+    if (value < INT16_MIN)
+        return INT16_MIN;
+    return (int16_t)value;
+}
+
+
+// Scale samples in place by a Q15 gain.
+static void ApplyGain (int16_t * samples, int count, int16_t gain) {
+    int i;
+    if (gain == MIXER_GAIN_UNITY)
+        return;
+    for (i = 0; i < count; i++)
+        samples[i] = (int16_t)(((int32_t)samples[i] * gain) >> 15);
+}
+
+
+// Add samples scaled by a Q15 gain into destination, saturating.
+static void MixIn (int16_t * destination, const int16_t * samples, int count, int16_t gain) {
+    int i;
+    if (gain == MIXER_GAIN_UNITY) {
+        for (i = 0; i < count; i++)
+            destination[i] = Saturate((int32_t)destination[i] + samples[i]);
+    } else {
+        for (i = 0; i < count; i++)
+            destination[i] = Saturate((int32_t)destination[i] + (((int32_t)samples[i] * gain) >> 15));
+    }
+}
+
+
+// Render one block of samples into destination.
+// The first voice that plays renders straight into the output and everything after it is mixed
+// in, so a single voice never pays for a mix pass.  Returns the number of samples rendered, which
+// is 0 only if no voice was active at the start of the block.
+int MixerRender (int16_t * destination, int samples) {
+    int voice, start, count;
+    bool written = false;
+
+    if (samples > MIXER_MAX_BLOCK)
+        samples = MIXER_MAX_BLOCK;
+
+    for (voice = 0; voice < MIXER_VOICES; voice++) {
+        mixerVoice_t *v = &mixerVoices[voice];
+        if (!v->Active)
+            continue;
+
+        // Voices that haven't started yet just count down.
+        if (v->StartOffset >= (uint32_t)samples) {
+            v->StartOffset -= samples;
+            if (!written) {
+                memset(destination, 0, samples * sizeof(int16_t));
+                written = true;
+            }
+            continue;
+        }
+        start = (int)v->StartOffset;
+        v->StartOffset = 0;
+
+        if (!written) {
+            count = v->Source(v->Context, destination + start, samples - start);
+            ApplyGain(destination + start, count, v->Gain);
+            memset(destination, 0, start * sizeof(int16_t));
+            memset(destination + start + count, 0, (samples - start - count) * sizeof(int16_t));
+            written = true;
+        } else {
+            count = v->Source(v->Context, mixScratch, samples - start);
+            MixIn(destination + start, mixScratch, count, v->Gain);
+        }
+
+        if (count < samples - start)
+            v->Active = false;
+    }
+
+    return written ? samples : 0;
+}
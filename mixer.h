@@ -0,0 +1,34 @@
+// Mixer Header File
+// Sums up to MIXER_VOICES sources into one block of 16-bit PCM, each with its own Q15 gain.
+// Voices can start part way into a block (StartOffset) and end part way through one (their source
+// returns short).  Inactive voices cost a flag test.
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifndef MIXER_H
+#define MIXER_H
+
+#define MIXER_VOICES 2
+#define MIXER_MAX_BLOCK 1920    // Largest block MixerRender will be asked for, in samples.
+#define MIXER_GAIN_UNITY 0x7FFF // Treated as exactly 1.0, so a unity voice is copied untouched.
+
+// A voice's source fills destination with up to samples of PCM and returns how many it wrote.
+// Returning fewer than asked means the voice has finished.
+typedef int (*mixerSource_t) (void * context, int16_t * destination, int samples);
+
+typedef struct {
+    mixerSource_t Source;
+    void * Context;
+    int16_t Gain;           // Q15.
+    uint32_t StartOffset;   // Samples of silence before the voice starts, counted from the next block.
+    bool Active;
+} mixerVoice_t;
+
+void MixerStart (int voice, mixerSource_t source, void * context, int16_t gain, uint32_t startOffset);
+void MixerStop (int voice);
+void MixerSetGain (int voice, int16_t gain);
+bool MixerVoiceActive (int voice);
+bool MixerIsIdle (void);
+int MixerRender (int16_t * destination, int samples);
+
+#endif
@@ -4,6 +4,7 @@
 #define OGG_DATA_H
 
     #define SAMPLE_LENGTH 72414
+    #define SAMPLE_ID 1 // Clip ID, for the PCM cache.
     extern const char Sample[SAMPLE_LENGTH];
 
 #endif
\ No newline at end of file
@@ -3,39 +3,34 @@
 #include <string.h>
 #include "ogg_stripper.h"
 
-static oggPageHeader_t currentPageHeader;
-static oggIDHeader_t currentIDHeader;
-static oggCommentHeader_t currentCommentHeader;
-
-#ifdef OGG_STRIP_FILE
-    static FILE * oggFile = NULL;
-#elif defined(OGG_STRIP_MEMORY)
-    static const char * oggFile = NULL;
-    static size_t oggFilePointer = 0;
-    static size_t oggFileLength = 0;
-#endif
+// The reader behind the plain Ogg* functions.
+static oggReader_t defaultReader;
 
 
 // Generic function to read bytes from the source.
 // Assumes the source is already set and opened.
 // Returns the number of bytes read, or an error code.
-static inline int ReadBytes (void * destination, size_t length) {
+static inline int ReadBytes (oggReader_t * reader, void * destination, size_t length) {
 #ifdef OGG_STRIP_FILE
-    if (oggFile == NULL)
+    if (reader->File == NULL)
         return OGG_STRIP_NULL_SOURCE;
     else
-        return (int)fread(destination, 1, length, oggFile);
-#elif defined(OGG_STRIP_MEMORY)
-    if (oggFile == NULL) {
+        return (int)fread(destination, 1, length, reader->File);
+#elif defined(OGG_STRIP_MEMORY) || defined(OGG_STRIP_FLASH_DMA)
+    if (reader->Data == NULL) {
         return OGG_STRIP_NULL_SOURCE;
     } else {
-        if (oggFilePointer + length > oggFileLength)
-            length = oggFileLength - oggFilePointer;
-        if (length)
-            memcpy(destination, oggFile + oggFilePointer, length);
-        else
+        if (reader->Pointer + length > reader->Length)
+            length = reader->Length - reader->Pointer;
+        if (!length)
             return OGG_STRIP_EOF;
-        oggFilePointer += length;
+#ifdef OGG_STRIP_FLASH_DMA
+        if (reader->Stream != NULL)
+            FlashStreamRead(reader->Stream, reader->Pointer, destination, length);
+        else
+#endif
+            memcpy(destination, reader->Data + reader->Pointer, length);
+        reader->Pointer += length;
         return (int)length;
     }
 #endif
@@ -43,39 +38,87 @@ static inline int ReadBytes (void * destination, size_t length) {
 
 
 // Seek the source by a number of bytes.
-static inline void SeekBytes (long length) {
+static inline void SeekBytes (oggReader_t * reader, long length) {
 #ifdef OGG_STRIP_FILE
-    if (oggFile != NULL)
-        fseek(oggFile, length, SEEK_CUR);
-#elif defined(OGG_STRIP_MEMORY)
-    if (oggFile != NULL)
-        oggFilePointer += length;
+    if (reader->File != NULL)
+        fseek(reader->File, length, SEEK_CUR);
+#elif defined(OGG_STRIP_MEMORY) || defined(OGG_STRIP_FLASH_DMA)
+    if (reader->Data != NULL)
+        reader->Pointer += length;
 #endif
 }
 
 
 // Rewind the source to the beginning.
-static inline void Rewind (void) {
+static inline void Rewind (oggReader_t * reader) {
 #ifdef OGG_STRIP_FILE
-    if (oggFile != NULL)
-        fseek(oggFile, 0, SEEK_SET);
-#elif defined(OGG_STRIP_MEMORY)
-    if (oggFile != NULL)
-        oggFilePointer = 0;
+    if (reader->File != NULL)
+        fseek(reader->File, 0, SEEK_SET);
+#elif defined(OGG_STRIP_MEMORY) || defined(OGG_STRIP_FLASH_DMA)
+    if (reader->Data != NULL)
+        reader->Pointer = 0;
+#endif
+    reader->CurrentPacket = 0;
+    reader->DataLen = 0;
+    reader->PageHeader.Segments = 0;
+}
+
+
+// Where we are in the source, and how long it is.
+static inline long Tell (oggReader_t * reader) {
+#ifdef OGG_STRIP_FILE
+    return reader->File != NULL ? ftell(reader->File) : 0;
+#elif defined(OGG_STRIP_MEMORY) || defined(OGG_STRIP_FLASH_DMA)
+    return (long)reader->Pointer;
+#endif
+}
+
+
+static inline void SeekTo (oggReader_t * reader, long offset) {
+#ifdef OGG_STRIP_FILE
+    if (reader->File != NULL)
+        fseek(reader->File, offset, SEEK_SET);
+#elif defined(OGG_STRIP_MEMORY) || defined(OGG_STRIP_FLASH_DMA)
+    if (reader->Data != NULL)
+        reader->Pointer = (size_t)offset;
+#endif
+}
+
+
+static inline long SourceLength (oggReader_t * reader) {
+#ifdef OGG_STRIP_FILE
+    long here, length = 0;
+    if (reader->File != NULL) {
+        here = ftell(reader->File);
+        fseek(reader->File, 0, SEEK_END);
+        length = ftell(reader->File);
+        fseek(reader->File, here, SEEK_SET);
+    }
+    return length;
+#elif defined(OGG_STRIP_MEMORY) || defined(OGG_STRIP_FLASH_DMA)
+    return (long)reader->Length;
 #endif
 }
 
 
 // Set the source to read from.
 // The source is assumed to be open and ready to read.
-void OggSetSource (const void * source, size_t length) {
+void OggReaderSetSource (oggReader_t * reader, const void * source, size_t length) {
 #ifdef OGG_STRIP_FILE
-    oggFile = (FILE *)source;
+    reader->File = (FILE *)source;
 #elif defined(OGG_STRIP_MEMORY)
-    oggFile = (const char *)source;
-    oggFilePointer = 0;
-    oggFileLength = length;
+    reader->Data = (const char *)source;
+    reader->Pointer = 0;
+    reader->Length = length;
+#elif defined(OGG_STRIP_FLASH_DMA)
+    reader->Data = (const char *)FlashStreamUncached(source);
+    reader->Pointer = 0;
+    reader->Length = length;
+    reader->Stream = NULL;
 #endif
+    reader->CurrentPacket = 0;
+    reader->DataLen = 0;
+    reader->PageHeader.Segments = 0;
 }
 
 
@@ -83,14 +126,13 @@ void OggSetSource (const void * source, size_t length) {
 // Expect to be at the beginning of the page.
 // Return the length of the data in the page.
 // Seek to the beginning of the data when finished.
-int OggReadPageHeader (oggPageHeader_t * header) {
+int OggReaderReadPageHeader (oggReader_t * reader, oggPageHeader_t * header) {
     size_t i;
-    if ( ReadBytes( (char *)header, 27 ) == 27 ) {
+    if ( ReadBytes( reader, (char *)header, 27 ) == 27 ) {
         if (header->Signature == OGGS_MAGIC) {
             if (header->Segments) {
                 // Read in the segment table.
-                printf("Segments: %d\n", header->Segments);
-                ReadBytes( (char *)header->SegmentTable, header->Segments );
+                ReadBytes( reader, (char *)header->SegmentTable, header->Segments );
                 header->DataLength = 0;
                 for (i = 0; i < header->Segments; i++)
                     header->DataLength += header->SegmentTable[i];
@@ -116,15 +158,15 @@ int OggReadPageHeader (oggPageHeader_t * header) {
 // We assume we're at the beginning of the page (i.e. on OggS).
 // So, we need to get the page header first to figure out how much data is actually
 // available in this page.
-int OggGetNextDataPage (uint8_t * destination, size_t maxLength) {
-    int dataLen = OggReadPageHeader(&currentPageHeader);
+int OggReaderGetNextDataPage (oggReader_t * reader, uint8_t * destination, size_t maxLength) {
+    int dataLen = OggReaderReadPageHeader(reader, &reader->PageHeader);
     if (dataLen > 0) {
         // The page header is good and dataLen is the number of available bytes in the page.
         // Note: Since we made sure dataLen > 0, casting to unsigned is safe.
         if ((unsigned)dataLen > maxLength)
             dataLen = (int)maxLength;
 
-        if ( ReadBytes(destination, dataLen) == (unsigned)dataLen ) {
+        if ( ReadBytes(reader, destination, dataLen) == (unsigned)dataLen ) {
             return dataLen;
         } else {
             return OGG_STRIP_EOF;
@@ -137,54 +179,61 @@ int OggGetNextDataPage (uint8_t * destination, size_t maxLength) {
 
 // Grab the next packet's content into destination.
 // This is probably audio data.
-// We assume we're at the beginning of a packet if currentPacket is nonzero.
+// We assume we're at the beginning of a packet if CurrentPacket is nonzero.
 // If it's zero, we're probably at the beginning of a page, so we should grab the page
 // header and fast forward to the start of the content before pulling anything.
-int OggGetNextPacket (uint8_t * destination, size_t maxLength) {
-    static size_t currentPacket = 0;
-    static int dataLen = 0;
-    size_t packetLen;
-
-    // If we're done with the previous page and need a new one.
-    if (currentPacket >= currentPageHeader.Segments)
-        currentPacket = 0;
+// A packet is laced into segments of 255 bytes and a last, shorter one, which can carry on into the
+// next page; they're put back together here.  A packet longer than maxLength is skipped, and comes
+// back empty so the player conceals it.
+int OggReaderGetNextPacket (oggReader_t * reader, uint8_t * destination, size_t maxLength) {
+    size_t packetLen = 0, copyLen;
+    uint8_t segment;
+
+    do {
+        // If we're done with the previous page and need a new one.
+        if (reader->CurrentPacket >= reader->PageHeader.Segments)
+            reader->CurrentPacket = 0;
+
+        if (!reader->CurrentPacket)
+            reader->DataLen = OggReaderReadPageHeader(reader, &reader->PageHeader);
+
+        if (reader->DataLen <= 0) {
+            printf("ERR! Couldn't read page header: %d.\r\n", reader->DataLen);
+            return reader->DataLen; // This contains the error code from OggReaderReadPageHeader.
+        }
 
-    if (!currentPacket)
-        dataLen = OggReadPageHeader(&currentPageHeader);
-   
-    if (dataLen > 0) {
         // The page header was pulled successfully, and we're cue'd up.
-        // Note: Since we made sure dataLen > 0, casting to unsigned is safe.
-        packetLen = ReadBytes(destination, currentPageHeader.SegmentTable[currentPacket]);
-
-        if ( packetLen == currentPageHeader.SegmentTable[currentPacket++] )
-            return (int)packetLen;
-        else
+        segment = reader->PageHeader.SegmentTable[reader->CurrentPacket++];
+        copyLen = packetLen < maxLength ? maxLength - packetLen : 0;
+        if (copyLen > segment)
+            copyLen = segment;
+        if (copyLen && ReadBytes(reader, destination + packetLen, copyLen) != (int)copyLen)
             return OGG_STRIP_EOF;
-    } else {
-        printf("ERR! Couldn't read page header: %d.\r\n");
-        return dataLen; // This contains the error code from OggReadPageHeader.
+        if (copyLen < segment)
+            SeekBytes(reader, segment - copyLen);
+        packetLen += segment;
+    } while (segment == 255);
+
+    if (packetLen > maxLength) {
+        printf("ERR! Skipped a %u byte packet, the most is %u.\r\n", (unsigned)packetLen, (unsigned)maxLength);
+        return 0;
     }
-}
-
-
-oggPageHeader_t* OggGetLastPageHeader(void) {
-    return &currentPageHeader;
+    return (int)packetLen;
 }
 
 
 // We should be at the start of the ID header data section.  Read it in.
 // At the end of this thing, we should have advanced dataLen.
 // Return an error code if something goes wrong, or OGG_STRIP_OK if everything's fine.
-int OggGetIDHeader (oggIDHeader_t * destination, int dataLen) {
+int OggReaderGetIDHeader (oggReader_t * reader, oggIDHeader_t * destination, int dataLen) {
     int extraBytes = dataLen - 19;
     // If dataLen exceeds the length of the ID header (like if there's a channel mapping table)
     // just read in the ID stuff, and skip to the end.
     if (dataLen >= 19) {
-        if ( ReadBytes( (char *)destination, 19 ) == 19 ) {
+        if ( ReadBytes( reader, (char *)destination, 19 ) == 19 ) {
             // Advance any excess bytes.
             if (extraBytes > 0)
-                SeekBytes(extraBytes);
+                SeekBytes(reader, extraBytes);
             
             if (destination->Signature == OPUSHEAD_MAGIC)
                 return OGG_STRIP_OK;
@@ -206,15 +255,15 @@ int OggGetIDHeader (oggIDHeader_t * destination, int dataLen) {
 // We should be at the start of the comment header data section.
 // As of now, we don't need to parse this crap.  Just skip it all for now.
 // Return an error code if something goes wrong, or OGG_STRIP_OK if everything's fine.
-int OggGetCommentHeader (oggCommentHeader_t * destination, int dataLen) {
+int OggReaderGetCommentHeader (oggReader_t * reader, oggCommentHeader_t * destination, int dataLen) {
     int extraBytes = dataLen - 12;
     // If dataLen exceeds the length of the comment header (like if there's a custom comment)
     // just read in the fixed comment stuff, and skip to the end.
     if (dataLen >= 12) {
-        if ( ReadBytes( (char *)destination, 12 ) == 12 ) {
+        if ( ReadBytes( reader, (char *)destination, 12 ) == 12 ) {
             // Advance any excess bytes.
             if (extraBytes > 0)
-                SeekBytes(extraBytes);
+                SeekBytes(reader, extraBytes);
             
             if (destination->Signature == OPUSTAGS_MAGIC)
                 return OGG_STRIP_OK;
@@ -237,24 +286,131 @@ int OggGetCommentHeader (oggCommentHeader_t * destination, int dataLen) {
 // Finally, seek to the beginning of the first data page.
 // This function should be called first, before GetNextDataPage.
 // Return the data length pulled from the page header.
-bool OggPrepareFile (void) {
+bool OggReaderPrepareFile (oggReader_t * reader) {
     int dataLen = 0;
-    Rewind(); // Seek to the beginning.
+    Rewind(reader); // Seek to the beginning.
 
     // Read in the ID header.
-    dataLen = OggReadPageHeader(&currentPageHeader);
-    if ( OggGetIDHeader(&currentIDHeader, dataLen) == OGG_STRIP_OK ) {
+    dataLen = OggReaderReadPageHeader(reader, &reader->PageHeader);
+    if ( OggReaderGetIDHeader(reader, &reader->IDHeader, dataLen) == OGG_STRIP_OK ) {
         printf("Got ID Header!\r\n");
     }
 
     // Read in the comment header.
-    dataLen = OggReadPageHeader(&currentPageHeader);
-    if ( OggGetCommentHeader(&currentCommentHeader, dataLen) == OGG_STRIP_OK ) {
+    dataLen = OggReaderReadPageHeader(reader, &reader->PageHeader);
+    if ( OggReaderGetCommentHeader(reader, &reader->CommentHeader, dataLen) == OGG_STRIP_OK ) {
         printf("Got Comment Header!\r\n");
     }
 
+    // Start the packet reader on a fresh page.
+    reader->CurrentPacket = 0;
+    reader->PageHeader.Segments = 0;
+
     if (dataLen > 0)
         return true;
     else
         return false;
 }
+
+
+// Find the granule position of the last page that has one, without disturbing the reader.
+// For Opus this is the end of the stream in 48kHz samples, counting the pre-skip, which is how
+// the player knows exactly where the audio ends.  Returns -1 if there isn't one.
+// Works backwards from the end of the source a chunk at a time, looking for "OggS".
+int64_t OggReaderLastGranule (oggReader_t * reader) {
+    uint8_t chunk[64 + 13];
+    long here = Tell(reader);
+    long end = SourceLength(reader);
+    long start, i, length;
+    int64_t granule = -1;
+
+    for (end = end - 26; end > 0 && granule < 0; end = start) {
+        start = end > 64 ? end - 64 : 0;
+        length = end - start + 13;
+        SeekTo(reader, start);
+        if (ReadBytes(reader, chunk, (size_t)length) != (int)length)
+            break;
+
+        for (i = end - start - 1; i >= 0; i--) {
+            uint32_t signature;
+            memcpy(&signature, &chunk[i], sizeof(signature));
+            if (signature == OGGS_MAGIC && chunk[i + 4] == 0) {
+                memcpy(&granule, &chunk[i + 6], sizeof(granule));
+                if (granule >= 0)
+                    break;
+            }
+        }
+    }
+
+    SeekTo(reader, here);
+    return granule;
+}
+
+
+// Remember where a reader is, to come back to it later with OggReaderSeek.  Used to skip straight to
+// the audio of a clip whose headers have already been read.
+long OggReaderTell (oggReader_t * reader) {
+    return Tell(reader);
+}
+
+
+// Go to an offset from OggReaderTell.  It must be at the start of a page.
+void OggReaderSeek (oggReader_t * reader, long offset) {
+    SeekTo(reader, offset);
+    reader->CurrentPacket = 0;
+    reader->DataLen = 0;
+    reader->PageHeader.Segments = 0;
+}
+
+
+#ifdef OGG_STRIP_FLASH_DMA
+// Read through a flash stream from now on, so what the reader will want next is fetched by DMA while
+// the last packet decodes.  Without one, reads still bypass the XIP cache but wait for the flash.
+// Each reader being played needs its own stream.  Pass NULL to stop using it.
+void OggReaderSetStream (oggReader_t * reader, flashStream_t * stream) {
+    reader->Stream = stream;
+    if (stream != NULL)
+        FlashStreamOpen(stream, reader->Data, reader->Length);
+}
+#endif
+
+
+// The original single-stream API, all on the built-in reader.
+void OggSetSource (const void * source, size_t length) {
+    OggReaderSetSource(&defaultReader, source, length);
+}
+
+
+int OggReadPageHeader (oggPageHeader_t * header) {
+    return OggReaderReadPageHeader(&defaultReader, header);
+}
+
+
+int OggGetNextDataPage (uint8_t * destination, size_t maxLength) {
+    return OggReaderGetNextDataPage(&defaultReader, destination, maxLength);
+}
+
+
+int OggGetNextPacket (uint8_t * destination, size_t maxLength) {
+    return OggReaderGetNextPacket(&defaultReader, destination, maxLength);
+}
+
+
+oggPageHeader_t* OggGetLastPageHeader(void) {
+    return &defaultReader.PageHeader;
+}
+
+
+int OggGetIDHeader (oggIDHeader_t * destination, int dataLen) {
+    return OggReaderGetIDHeader(&defaultReader, destination, dataLen);
+}
+
+
+int OggGetCommentHeader (oggCommentHeader_t * destination, int dataLen) {
+    return OggReaderGetCommentHeader(&defaultReader, destination, dataLen);
+}
+
+
+bool OggPrepareFile (void) {
+    return OggReaderPrepareFile(&defaultReader);
+}
@@ -7,14 +7,20 @@
 #define OGG_STRIPPER_H
 
 // Which type of source do you want to read from?
+// OGG_STRIP_FLASH_DMA is memory too, but reads flash around the XIP cache (see flash_stream.h).
 // #define OGG_STRIP_FILE
 #define OGG_STRIP_MEMORY
+// #define OGG_STRIP_FLASH_DMA
 
 // Uncomment only one of the above.
-#if defined(OGG_STRIP_FILE) && defined(OGG_STRIP_MEMORY)
+#if defined(OGG_STRIP_FILE) + defined(OGG_STRIP_MEMORY) + defined(OGG_STRIP_FLASH_DMA) > 1
     #error "You can only define one source type."
 #endif
 
+#ifdef OGG_STRIP_FLASH_DMA
+    #include "flash_stream.h"
+#endif
+
 #define OGGS_MAGIC     0x5367674F // "OggS" NOTE: Might change due to endianness?
 #define OPUSHEAD_MAGIC 0x646165487375704F // "OpusHead"
 #define OPUSTAGS_MAGIC 0x736761547375704F // "OpusTags"
@@ -47,6 +53,26 @@ typedef struct __attribute((packed)) {
     uint32_t VendorStringLength;
 } oggCommentHeader_t;
 
+// Everything needed to read one Ogg stream.  Use one of these per stream if you need more than
+// one open at a time; the plain Ogg* functions below all work on a single built-in reader.
+typedef struct {
+#ifdef OGG_STRIP_FILE
+    FILE * File;
+#elif defined(OGG_STRIP_MEMORY) || defined(OGG_STRIP_FLASH_DMA)
+    const char * Data;
+    size_t Pointer;
+    size_t Length;
+#endif
+#ifdef OGG_STRIP_FLASH_DMA
+    flashStream_t * Stream;     // Reads go through this if set, otherwise straight from the uncached alias.
+#endif
+    oggPageHeader_t PageHeader;
+    oggIDHeader_t IDHeader;
+    oggCommentHeader_t CommentHeader;
+    size_t CurrentPacket;
+    int DataLen;
+} oggReader_t;
+
 enum {
     OGG_STRIP_OK = 0,
     OGG_STRIP_ERR_UNKNOWN = -1,
@@ -57,6 +83,20 @@ enum {
     OGG_STRIP_NULL_SOURCE = -6
 };
 
+void OggReaderSetSource (oggReader_t * reader, const void * source, size_t length);
+int OggReaderReadPageHeader (oggReader_t * reader, oggPageHeader_t * header);
+int OggReaderGetNextDataPage (oggReader_t * reader, uint8_t * destination, size_t maxLength);
+int OggReaderGetNextPacket (oggReader_t * reader, uint8_t * destination, size_t maxLength);
+int OggReaderGetIDHeader (oggReader_t * reader, oggIDHeader_t * destination, int dataLen);
+int OggReaderGetCommentHeader (oggReader_t * reader, oggCommentHeader_t * destination, int dataLen);
+bool OggReaderPrepareFile (oggReader_t * reader);
+int64_t OggReaderLastGranule (oggReader_t * reader);
+long OggReaderTell (oggReader_t * reader);
+void OggReaderSeek (oggReader_t * reader, long offset);
+#ifdef OGG_STRIP_FLASH_DMA
+void OggReaderSetStream (oggReader_t * reader, flashStream_t * stream);
+#endif
+
 void OggSetSource (const void * source, size_t length);
 int OggReadPageHeader (oggPageHeader_t * header);
 int OggGetNextDataPage (uint8_t * destination, size_t maxLength);
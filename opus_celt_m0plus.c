@@ -0,0 +1,349 @@
+// Cortex-M0+ versions of CELT's inverse MDCT and FFT, for the transforms a 20ms frame uses: the long
+// 1920-point MDCT (a 480-point FFT), and the 240-point MDCTs (60-point FFTs) of a transient's eight
+// short blocks.  CELT always works at 48kHz inside, whatever rate opus_decode gives out, so this
+// covers 16kHz output too.  Other sizes go to Opus' own clt_mdct_backward_c.
+//
+// The arithmetic is exactly mdct.c's and kiss_fft.c's, with the same rounding and wrap-around, so the
+// output is bit for bit the same (host/test_celt_m0plus.c checks it).  What changes is the layout, for
+// a core with a 32x32->32 multiply and eight low registers:
+//   - Each FFT stage is written out for its radix, twiddle stride and counts, so every loop has
+//     constant bounds and steps its pointers by constants, instead of opus_fft_impl walking the
+//     factor table and passing them in.
+//   - MULT16_32_Q15 splits its 32-bit operand into halves.  Where one value is multiplied by two
+//     constants (both parts of a complex multiply, the pre- and post-rotations, the window, the
+//     radix-5 rotations), it's split once and both products share the halves.
+#include <stddef.h>
+
+#include "opus_celt_m0plus.h"
+#include "kiss_fft.h"
+
+#define M0PLUS_INLINE static inline __attribute__((always_inline))
+
+// The static 48kHz mode's sizes, which are all this covers.
+#define MDCT_LONG 1920
+#define MDCT_OVERLAP 120
+
+// A 32-bit value split for MULT16_32_Q15: the high half signed, the low half unsigned.
+typedef struct {
+    opus_int32 High;
+    opus_int32 Low;
+} split32_t;
+
+
+M0PLUS_INLINE split32_t Split (opus_int32 x) {
+    split32_t s = { x >> 16, x & 0xFFFF };
+    return s;
+}
+
+
+// MULT16_32_Q15(c, x) from x's halves, the way fixed_generic.h (and opus_m0plus.h) work it out.
+M0PLUS_INLINE opus_int32 MulQ15 (opus_int32 c, split32_t x) {
+    return (opus_int32)(((opus_uint32)(c * x.High) << 1) + (opus_uint32)(c * x.Low >> 15));
+}
+
+
+// kiss_fft's C_MUL: a times the Q15 twiddle t.
+M0PLUS_INLINE kiss_fft_cpx CMul (kiss_fft_cpx a, const kiss_twiddle_cpx * t) {
+    split32_t r = Split(a.r), i = Split(a.i);
+    opus_int32 tr = t->r, ti = t->i;
+    kiss_fft_cpx m;
+    m.r = SUB32_ovflw(MulQ15(tr, r), MulQ15(ti, i));
+    m.i = ADD32_ovflw(MulQ15(ti, r), MulQ15(tr, i));
+    return m;
+}
+
+
+M0PLUS_INLINE kiss_fft_cpx CAdd (kiss_fft_cpx a, kiss_fft_cpx b) {
+    kiss_fft_cpx m = { ADD32_ovflw(a.r, b.r), ADD32_ovflw(a.i, b.i) };
+    return m;
+}
+
+
+M0PLUS_INLINE kiss_fft_cpx CSub (kiss_fft_cpx a, kiss_fft_cpx b) {
+    kiss_fft_cpx m = { SUB32_ovflw(a.r, b.r), SUB32_ovflw(a.i, b.i) };
+    return m;
+}
+
+
+// The first radix-4 stage, where every twiddle is 1.
+M0PLUS_INLINE void Bfly4First (kiss_fft_cpx * f, int n) {
+    int i;
+    for (i = 0; i < n; i++, f += 4) {
+        kiss_fft_cpx s0, s1;
+        s0 = CSub(f[0], f[2]);
+        f[0] = CAdd(f[0], f[2]);
+        s1 = CAdd(f[1], f[3]);
+        f[2] = CSub(f[0], s1);
+        f[0] = CAdd(f[0], s1);
+        s1 = CSub(f[1], f[3]);
+        f[1].r = ADD32_ovflw(s0.r, s1.i);
+        f[1].i = SUB32_ovflw(s0.i, s1.r);
+        f[3].r = SUB32_ovflw(s0.r, s1.i);
+        f[3].i = ADD32_ovflw(s0.i, s1.r);
+    }
+}
+
+
+// Radix 2 after the first radix-4 stage (m = 4), with its twiddles of 1, -j and sqrt(1/2)(1 -+ j).
+M0PLUS_INLINE void Bfly2 (kiss_fft_cpx * f, int n) {
+    const opus_int32 tw = 23170;    // QCONST16(0.7071067812f, 15)
+    int i;
+    for (i = 0; i < n; i++, f += 8) {
+        kiss_fft_cpx * g = f + 4;
+        kiss_fft_cpx t;
+
+        t = g[0];
+        g[0] = CSub(f[0], t);
+        f[0] = CAdd(f[0], t);
+
+        t.r = MulQ15(tw, Split(ADD32_ovflw(g[1].r, g[1].i)));
+        t.i = MulQ15(tw, Split(SUB32_ovflw(g[1].i, g[1].r)));
+        g[1] = CSub(f[1], t);
+        f[1] = CAdd(f[1], t);
+
+        t.r = g[2].i;
+        t.i = -g[2].r;
+        g[2] = CSub(f[2], t);
+        f[2] = CAdd(f[2], t);
+
+        t.r = MulQ15(tw, Split(SUB32_ovflw(g[3].i, g[3].r)));
+        t.i = MulQ15(tw, Split(NEG32_ovflw(ADD32_ovflw(g[3].i, g[3].r))));
+        g[3] = CSub(f[3], t);
+        f[3] = CAdd(f[3], t);
+    }
+}
+
+
+// Radix 4: n butterflies mm apart, each over m points, with twiddles fstride apart.
+M0PLUS_INLINE void Bfly4 (kiss_fft_cpx * base, const kiss_twiddle_cpx * twiddles, int fstride, int m, int n, int mm) {
+    int i, j;
+    for (i = 0; i < n; i++) {
+        kiss_fft_cpx * f = base + i * mm;
+        const kiss_twiddle_cpx * tw1 = twiddles, * tw2 = twiddles, * tw3 = twiddles;
+        for (j = 0; j < m; j++, f++) {
+            kiss_fft_cpx s0, s1, s2, s3, s4, s5;
+            s0 = CMul(f[m], tw1);
+            s1 = CMul(f[2 * m], tw2);
+            s2 = CMul(f[3 * m], tw3);
+
+            s5 = CSub(f[0], s1);
+            f[0] = CAdd(f[0], s1);
+            s3 = CAdd(s0, s2);
+            s4 = CSub(s0, s2);
+            f[2 * m] = CSub(f[0], s3);
+            tw1 += fstride;
+            tw2 += fstride * 2;
+            tw3 += fstride * 3;
+            f[0] = CAdd(f[0], s3);
+
+            f[m].r = ADD32_ovflw(s5.r, s4.i);
+            f[m].i = SUB32_ovflw(s5.i, s4.r);
+            f[3 * m].r = SUB32_ovflw(s5.r, s4.i);
+            f[3 * m].i = ADD32_ovflw(s5.i, s4.r);
+        }
+    }
+}
+
+
+// Radix 3, laid out like Bfly4.
+M0PLUS_INLINE void Bfly3 (kiss_fft_cpx * base, const kiss_twiddle_cpx * twiddles, int fstride, int m, int n, int mm) {
+    const opus_int32 epi3 = -28378;     // Imaginary part of exp(-2*pi*j/3), Q15.
+    int i, j;
+    for (i = 0; i < n; i++) {
+        kiss_fft_cpx * f = base + i * mm;
+        const kiss_twiddle_cpx * tw1 = twiddles, * tw2 = twiddles;
+        for (j = 0; j < m; j++, f++) {
+            kiss_fft_cpx s0, s1, s2, s3;
+            s1 = CMul(f[m], tw1);
+            s2 = CMul(f[2 * m], tw2);
+
+            s3 = CAdd(s1, s2);
+            s0 = CSub(s1, s2);
+            tw1 += fstride;
+            tw2 += fstride * 2;
+
+            f[m].r = SUB32_ovflw(f[0].r, s3.r >> 1);
+            f[m].i = SUB32_ovflw(f[0].i, s3.i >> 1);
+
+            s0.r = MulQ15(epi3, Split(s0.r));
+            s0.i = MulQ15(epi3, Split(s0.i));
+
+            f[0] = CAdd(f[0], s3);
+
+            f[2 * m].r = ADD32_ovflw(f[m].r, s0.i);
+            f[2 * m].i = SUB32_ovflw(f[m].i, s0.r);
+
+            f[m].r = SUB32_ovflw(f[m].r, s0.i);
+            f[m].i = ADD32_ovflw(f[m].i, s0.r);
+        }
+    }
+}
+
+
+// Radix 5, laid out like Bfly4.  Each of the four sums and differences is rotated by both of the
+// fifth roots ya and yb, so it's split once for the pair.
+M0PLUS_INLINE void Bfly5 (kiss_fft_cpx * base, const kiss_twiddle_cpx * twiddles, int fstride, int m, int n, int mm) {
+    const opus_int32 yar = 10126, yai = -31164, ybr = -26510, ybi = -19261;
+    int i, u;
+    for (i = 0; i < n; i++) {
+        kiss_fft_cpx * f0 = base + i * mm;
+        kiss_fft_cpx * f1 = f0 + m, * f2 = f0 + 2 * m, * f3 = f0 + 3 * m, * f4 = f0 + 4 * m;
+        const kiss_twiddle_cpx * tw1 = twiddles, * tw2 = twiddles, * tw3 = twiddles, * tw4 = twiddles;
+        for (u = 0; u < m; u++) {
+            kiss_fft_cpx s0, s1, s2, s3, s4, s5, s6, s7, s8, s9, s10, s11, s12;
+            split32_t s7r, s7i, s8r, s8i, s9r, s9i, s10r, s10i;
+
+            s0 = *f0;
+            s1 = CMul(*f1, tw1);
+            s2 = CMul(*f2, tw2);
+            s3 = CMul(*f3, tw3);
+            s4 = CMul(*f4, tw4);
+            tw1 += fstride;
+            tw2 += fstride * 2;
+            tw3 += fstride * 3;
+            tw4 += fstride * 4;
+
+            s7 = CAdd(s1, s4);
+            s10 = CSub(s1, s4);
+            s8 = CAdd(s2, s3);
+            s9 = CSub(s2, s3);
+            s7r = Split(s7.r);
+            s7i = Split(s7.i);
+            s8r = Split(s8.r);
+            s8i = Split(s8.i);
+            s9r = Split(s9.r);
+            s9i = Split(s9.i);
+            s10r = Split(s10.r);
+            s10i = Split(s10.i);
+
+            f0->r = ADD32_ovflw(f0->r, ADD32_ovflw(s7.r, s8.r));
+            f0->i = ADD32_ovflw(f0->i, ADD32_ovflw(s7.i, s8.i));
+
+            s5.r = ADD32_ovflw(s0.r, ADD32_ovflw(MulQ15(yar, s7r), MulQ15(ybr, s8r)));
+            s5.i = ADD32_ovflw(s0.i, ADD32_ovflw(MulQ15(yar, s7i), MulQ15(ybr, s8i)));
+            s6.r = ADD32_ovflw(MulQ15(yai, s10i), MulQ15(ybi, s9i));
+            s6.i = NEG32_ovflw(ADD32_ovflw(MulQ15(yai, s10r), MulQ15(ybi, s9r)));
+            *f1 = CSub(s5, s6);
+            *f4 = CAdd(s5, s6);
+
+            s11.r = ADD32_ovflw(s0.r, ADD32_ovflw(MulQ15(ybr, s7r), MulQ15(yar, s8r)));
+            s11.i = ADD32_ovflw(s0.i, ADD32_ovflw(MulQ15(ybr, s7i), MulQ15(yar, s8i)));
+            s12.r = SUB32_ovflw(MulQ15(yai, s9i), MulQ15(ybi, s10i));
+            s12.i = SUB32_ovflw(MulQ15(ybi, s10r), MulQ15(yai, s9r));
+            *f2 = CAdd(s11, s12);
+            *f3 = CSub(s11, s12);
+
+            f0++;
+            f1++;
+            f2++;
+            f3++;
+            f4++;
+        }
+    }
+}
+
+
+// The stages opus_fft_impl runs for the 480-point FFT, factored 5 x 3 x 4 x 2 x 4, last first.
+M0PLUS_INLINE void Fft480 (kiss_fft_cpx * f, const kiss_twiddle_cpx * twiddles) {
+    Bfly4First(f, 120);
+    Bfly2(f, 60);
+    Bfly4(f, twiddles, 15, 8, 15, 32);
+    Bfly3(f, twiddles, 5, 32, 5, 96);
+    Bfly5(f, twiddles, 1, 96, 1, 1);
+}
+
+
+// And the 60-point FFT, 5 x 3 x 4, which reads every eighth of the same twiddles.
+M0PLUS_INLINE void Fft60 (kiss_fft_cpx * f, const kiss_twiddle_cpx * twiddles) {
+    Bfly4First(f, 15);
+    Bfly3(f, twiddles, 40, 4, 5, 12);
+    Bfly5(f, twiddles, 8, 12, 1, 1);
+}
+
+
+// Rotate the input by the MDCT's twiddles into bit-reversed order for the FFT, with real and
+// imaginary swapped so a forward FFT does the inverse.
+M0PLUS_INLINE void PreRotate (const kiss_fft_scalar * in, kiss_fft_scalar * y, const kiss_twiddle_scalar * trig,
+                              const opus_int16 * bitrev, int n4, int stride) {
+    const kiss_fft_scalar * xp1 = in;
+    const kiss_fft_scalar * xp2 = in + stride * (2 * n4 - 1);
+    int i;
+    for (i = 0; i < n4; i++) {
+        split32_t x1 = Split(*xp1), x2 = Split(*xp2);
+        opus_int32 t0 = trig[i], t1 = trig[n4 + i];
+        int rev = bitrev[i];
+        y[2 * rev + 1] = ADD32_ovflw(MulQ15(t0, x2), MulQ15(t1, x1));
+        y[2 * rev] = SUB32_ovflw(MulQ15(t0, x1), MulQ15(t1, x2));
+        xp1 += 2 * stride;
+        xp2 -= 2 * stride;
+    }
+}
+
+
+// Rotate the FFT's output back, working in from both ends at once so it can be done in place.
+M0PLUS_INLINE void PostRotate (kiss_fft_scalar * y, const kiss_twiddle_scalar * trig, int n4) {
+    kiss_fft_scalar * yp0 = y;
+    kiss_fft_scalar * yp1 = y + 2 * n4 - 2;
+    int i;
+    for (i = 0; i < (n4 + 1) >> 1; i++) {
+        split32_t re0 = Split(yp0[1]), im0 = Split(yp0[0]), re1, im1;
+        opus_int32 t0 = trig[i], t1 = trig[n4 + i];
+        kiss_fft_scalar yr, yi;
+
+        yr = ADD32_ovflw(MulQ15(t0, re0), MulQ15(t1, im0));
+        yi = SUB32_ovflw(MulQ15(t1, re0), MulQ15(t0, im0));
+        re1 = Split(yp1[1]);
+        im1 = Split(yp1[0]);
+        yp0[0] = yr;
+        yp1[1] = yi;
+
+        t0 = trig[n4 - i - 1];
+        t1 = trig[2 * n4 - i - 1];
+        yp1[0] = ADD32_ovflw(MulQ15(t0, re1), MulQ15(t1, im1));
+        yp0[1] = SUB32_ovflw(MulQ15(t1, re1), MulQ15(t0, im1));
+        yp0 += 2;
+        yp1 -= 2;
+    }
+}
+
+
+// Window the overlap and mirror it on both sides, for TDAC.
+M0PLUS_INLINE void Mirror (kiss_fft_scalar * out, const opus_val16 * window) {
+    kiss_fft_scalar * xp1 = out + MDCT_OVERLAP - 1;
+    kiss_fft_scalar * yp1 = out;
+    const opus_val16 * wp1 = window;
+    const opus_val16 * wp2 = window + MDCT_OVERLAP - 1;
+    int i;
+    for (i = 0; i < MDCT_OVERLAP / 2; i++) {
+        split32_t x1 = Split(*xp1), x2 = Split(*yp1);
+        opus_int32 w1 = *wp1++, w2 = *wp2--;
+        *yp1++ = SUB32_ovflw(MulQ15(w2, x2), MulQ15(w1, x1));
+        *xp1-- = ADD32_ovflw(MulQ15(w1, x2), MulQ15(w2, x1));
+    }
+}
+
+
+// Opus' clt_mdct_backward_c for the long and short transforms of the 48kHz mode, and a pass-through
+// to it for anything else.
+void clt_mdct_backward_m0plus (const mdct_lookup * l, kiss_fft_scalar * in, kiss_fft_scalar * OPUS_RESTRICT out,
+                               const opus_val16 * OPUS_RESTRICT window, int overlap, int shift, int stride, int arch) {
+    const kiss_fft_state * st = l->kfft[shift];
+    kiss_fft_scalar * y = out + (overlap >> 1);
+    const kiss_twiddle_scalar * trig;
+
+    if (l->n == MDCT_LONG && overlap == MDCT_OVERLAP && shift == 0 && st->nfft == 480 && st->shift <= 0) {
+        PreRotate(in, y, l->trig, st->bitrev, 480, stride);
+        Fft480((kiss_fft_cpx *)y, st->twiddles);
+        PostRotate(y, l->trig, 480);
+    } else if (l->n == MDCT_LONG && overlap == MDCT_OVERLAP && shift == 3 && st->nfft == 60 && st->shift == 3) {
+        // The twiddles for each halving follow the last: 960, then 480, then 240 of them.
+        trig = l->trig + MDCT_LONG / 2 + MDCT_LONG / 4 + MDCT_LONG / 8;
+        PreRotate(in, y, trig, st->bitrev, 60, stride);
+        Fft60((kiss_fft_cpx *)y, st->twiddles);
+        PostRotate(y, trig, 60);
+    } else {
+        clt_mdct_backward_c(l, in, out, window, overlap, shift, stride, arch);
+        return;
+    }
+    Mirror(out, window);
+}
@@ -0,0 +1,14 @@
+// Opus CELT Kernels for Cortex-M0+ Header File
+// clt_mdct_backward_m0plus is a drop-in for Opus' clt_mdct_backward_c, with the 20ms frame's
+// transforms rewritten for the M0+ (see opus_celt_m0plus.c).  The OPUS_CELT_M0PLUS option builds it
+// into opus_codec and points celt_decoder.c's calls at it; clt_mdct_backward_c is still there for
+// the sizes it doesn't cover, and for host/test_celt_m0plus.c and the bench to compare against.
+#include "mdct.h"
+
+#ifndef OPUS_CELT_M0PLUS_H
+#define OPUS_CELT_M0PLUS_H
+
+void clt_mdct_backward_m0plus (const mdct_lookup * l, kiss_fft_scalar * in, kiss_fft_scalar * OPUS_RESTRICT out,
+                               const opus_val16 * OPUS_RESTRICT window, int overlap, int shift, int stride, int arch);
+
+#endif
@@ -0,0 +1,98 @@
+// Stand-in for Opus' CELT decoder in the SILK-only build (OPUS_SILK_ONLY, see CMakeLists.txt).
+// opus_decoder.c still creates and configures a CELT decoder alongside the SILK one, so this takes
+// those calls and holds nothing but the channel count.  celt_decode_with_ec accepts whatever it is
+// given and returns silence of the requested length: the player never hands CELT or Hybrid packets
+// to Opus in this build, but if one did get through, opus_decode would play it as silence rather
+// than return an error.
+// A SILK packet next to a CELT one can still carry a CELT redundancy frame, and the TOC byte doesn't
+// say so.  opus_decode_frame decodes that here and crossfades it in with the mode's window, so it
+// comes out as silence with a real window to fade it by.
+#include <stdarg.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "celt.h"
+#include "modes.h"
+
+#ifdef OPUS_SILK_ONLY
+
+// The 2.5ms overlap window of CELT's 48kHz mode, Q15.  opus_decode_frame fades redundancy frames in
+// and out with it.
+static const opus_val16 stubWindow[120] = {
+    2, 20, 55, 108, 178, 266, 372, 494, 635, 792, 966, 1157,
+    1365, 1590, 1831, 2089, 2362, 2651, 2956, 3276, 3611, 3961, 4325, 4703,
+    5094, 5499, 5916, 6346, 6788, 7241, 7705, 8179, 8663, 9156, 9657, 10167,
+    10684, 11207, 11736, 12271, 12810, 13353, 13899, 14447, 14997, 15547, 16098, 16648,
+    17197, 17744, 18287, 18827, 19363, 19893, 20418, 20936, 21447, 21950, 22445, 22931,
+    23407, 23874, 24330, 24774, 25208, 25629, 26039, 26435, 26819, 27190, 27548, 27893,
+    28224, 28541, 28845, 29135, 29411, 29674, 29924, 30160, 30384, 30594, 30792, 30977,
+    31151, 31313, 31463, 31602, 31731, 31849, 31958, 32057, 32148, 32229, 32303, 32370,
+    32429, 32481, 32528, 32568, 32604, 32634, 32661, 32683, 32701, 32717, 32729, 32740,
+    32748, 32754, 32758, 32762, 32764, 32766, 32767, 32767, 32767, 32767, 32767, 32767
+};
+
+static const CELTMode stubMode = { .Fs = 48000, .overlap = 120, .window = stubWindow };
+
+
+// The decoder state is just the channel count, for the size of the frames it fills.
+int celt_decoder_get_size (int channels) {
+    (void)channels;
+    return sizeof(opus_int32);
+}
+
+
+int celt_decoder_init (CELTDecoder * st, opus_int32 sampling_rate, int channels) {
+    (void)sampling_rate;
+    if (channels != 1 && channels != 2)
+        return OPUS_BAD_ARG;
+    *(opus_int32 *)st = channels;
+    return OPUS_OK;
+}
+
+
+// Only redundancy frames should get here, but any CELT frame is treated the same.  The audio is
+// silence, added to pcm rather than written over it when accumulating.
+int celt_decode_with_ec (CELTDecoder * OPUS_RESTRICT st, const unsigned char * data, int len,
+                         opus_val16 * OPUS_RESTRICT pcm, int frame_size, ec_dec * dec, int accum) {
+    (void)data;
+    (void)len;
+    (void)dec;
+    if (pcm != NULL && !accum)
+        memset(pcm, 0, (size_t)frame_size * *(opus_int32 *)st * sizeof(opus_val16));
+    return frame_size;
+}
+
+
+// Settings are accepted and ignored.  The few queries opus_decoder.c makes get harmless answers.
+int opus_custom_decoder_ctl (CELTDecoder * OPUS_RESTRICT st, int request, ...) {
+    va_list ap;
+    (void)st;
+
+    va_start(ap, request);
+    switch (request) {
+        case CELT_GET_MODE_REQUEST: {
+            const CELTMode ** value = va_arg(ap, const CELTMode **);
+            if (value != NULL)
+                *value = &stubMode;
+            break;
+        }
+        case OPUS_GET_FINAL_RANGE_REQUEST: {
+            opus_uint32 * value = va_arg(ap, opus_uint32 *);
+            if (value != NULL)
+                *value = 0;
+            break;
+        }
+        case OPUS_GET_PITCH_REQUEST: {
+            opus_int32 * value = va_arg(ap, opus_int32 *);
+            if (value != NULL)
+                *value = 0;
+            break;
+        }
+        default:
+            break;
+    }
+    va_end(ap);
+    return OPUS_OK;
+}
+
+#endif
@@ -0,0 +1,128 @@
+# Builds the Opus decoder as the opus_codec static library.  Included by CMakeLists.txt for the
+# Pico and by host/CMakeLists.txt for the host build, so both decode with the same sources and
+# settings.  Paths are relative to this file.
+set(OPUS_CODEC_ROOT ${CMAKE_CURRENT_LIST_DIR})
+set(OPUS_DIR ${OPUS_CODEC_ROOT}/opus)
+
+option(OPUS_SCRATCH_ARENA "Give Opus a shared static scratch arena instead of using alloca()" ON)
+option(OPUS_M0PLUS_MACROS "Use the Cortex-M0+ versions of Opus' fixed-point multiply macros in opus_m0plus.h" ON)
+option(OPUS_SILK_ONLY "Build a decoder for mono SILK speech only, with CELT left out (see opus_celt_stub.c)" OFF)
+option(OPUS_CELT_M0PLUS "Run CELT's inverse MDCT for 20ms frames on the M0+ kernels in opus_celt_m0plus.c" ON)
+option(OPUS_SILK_M0PLUS "Run SILK's LTP and LPC synthesis and NLSF to LPC conversion on the M0+ kernels in opus_silk_m0plus.c" ON)
+
+include(${OPUS_DIR}/cmake/OpusFunctions.cmake)
+
+# Get the list of files from the makefiles.
+# Add the folder prefix to each file in the lists.
+get_opus_sources(SILK_HEAD ${OPUS_DIR}/silk_headers.mk silk_headers_base)
+foreach(silk_header ${silk_headers_base})
+    list(APPEND silk_headers "${OPUS_DIR}/${silk_header}")
+endforeach()
+
+get_opus_sources(SILK_SOURCES ${OPUS_DIR}/silk_sources.mk silk_sources_base)
+foreach(silk_source ${silk_sources_base})
+    list(APPEND silk_sources "${OPUS_DIR}/${silk_source}")
+endforeach()
+
+get_opus_sources(SILK_SOURCES_FIXED ${OPUS_DIR}/silk_sources.mk silk_sources_fixed_base)
+foreach(silk_sources_fixed ${silk_sources_fixed_base})
+    list(APPEND silk_sources_fixed "${OPUS_DIR}/${silk_sources_fixed}")
+endforeach()
+
+get_opus_sources(CELT_HEAD ${OPUS_DIR}/celt_headers.mk celt_headers_base)
+foreach(celt_header ${celt_headers_base})
+    list(APPEND celt_headers "${OPUS_DIR}/${celt_header}")
+endforeach()
+
+get_opus_sources(CELT_SOURCES ${OPUS_DIR}/celt_sources.mk celt_sources_base)
+foreach(celt_source ${celt_sources_base})
+    list(APPEND celt_sources "${OPUS_DIR}/${celt_source}")
+endforeach()
+
+# Its definitions and include paths are PUBLIC because the player includes its headers.
+add_library(opus_codec STATIC
+            ${OPUS_DIR}/src/opus_decoder.c
+            ${OPUS_DIR}/src/opus.c
+            )
+
+target_include_directories(opus_codec PUBLIC
+            ${OPUS_DIR}/include
+            ${OPUS_DIR}
+            ${OPUS_DIR}/celt
+            ${OPUS_DIR}/silk
+            ${OPUS_DIR}/silk/fixed
+            ${OPUS_CODEC_ROOT}
+            )
+
+add_sources_group(opus_codec silk ${silk_headers} ${silk_sources})
+add_sources_group(opus_codec silk ${silk_sources_fixed})
+# The SILK-only build keeps just the parts of CELT that SILK and the Opus layer call: the range
+# decoder, a few maths helpers, and celt.c for the pseudostack pointer the scratch arena uses.
+# The CELT decoder itself is replaced by a stub.
+if (OPUS_SILK_ONLY)
+    add_sources_group(opus_codec celt ${celt_headers}
+            ${OPUS_DIR}/celt/celt.c
+            ${OPUS_DIR}/celt/entcode.c
+            ${OPUS_DIR}/celt/entdec.c
+            ${OPUS_DIR}/celt/mathops.c
+            ${OPUS_DIR}/celt/celt_lpc.c
+            ${OPUS_DIR}/celt/pitch.c
+            )
+    target_sources(opus_codec PRIVATE ${OPUS_CODEC_ROOT}/opus_celt_stub.c)
+    target_compile_definitions(opus_codec PUBLIC -DOPUS_SILK_ONLY)
+else()
+    add_sources_group(opus_codec celt ${celt_headers} ${celt_sources})
+endif()
+
+target_compile_definitions(opus_codec PUBLIC
+            -DOPUS_BUILD
+            -DOPUS_FIXED_POINT
+            -DFIXED_POINT
+            -DHAVE_LRINT
+            )
+
+# Opus needs somewhere to put its temporaries.  The scratch arena (see opus_scratch.h) is one
+# fixed block shared by all decoders, so the app task doesn't need a huge stack for alloca().
+if (OPUS_SCRATCH_ARENA)
+    target_compile_definitions(opus_codec PUBLIC
+            -DNONTHREADSAFE_PSEUDOSTACK
+            -DCUSTOM_SUPPORT
+            -DOPUS_SCRATCH_ARENA
+            )
+else()
+    target_compile_definitions(opus_codec PUBLIC
+            -DUSE_ALLOCA
+            )
+endif()
+
+# Opus' ARM macros need ARMv5E, so replace the generic fixed-point ones it falls back to with versions
+# written for the M0+ (bit-exact, see opus_m0plus.h).  A 64-bit host would use Opus' 64-bit macros
+# instead, so OPUS_M0PLUS_FORCE makes the host build decode with these too, and its output is what
+# the Pico's would be.
+if (OPUS_M0PLUS_MACROS)
+    target_compile_options(opus_codec PRIVATE -include ${OPUS_CODEC_ROOT}/opus_m0plus.h)
+    target_compile_definitions(opus_codec PRIVATE -DOPUS_M0PLUS_FORCE)
+endif()
+
+# CELT's inverse MDCT and FFT for 20ms frames, written out for the M0+ and bit-exact (see
+# opus_celt_m0plus.c).  Only celt_decoder.c's calls are pointed at it, so Opus' own
+# clt_mdct_backward_c is still built, for the other frame sizes and for host/test_celt_m0plus.c and
+# the bench to compare against.
+if (OPUS_CELT_M0PLUS AND NOT OPUS_SILK_ONLY)
+    target_sources(opus_codec PRIVATE ${OPUS_CODEC_ROOT}/opus_celt_m0plus.c)
+    set_property(SOURCE ${OPUS_DIR}/celt/celt_decoder.c APPEND PROPERTY
+                 COMPILE_DEFINITIONS clt_mdct_backward_c=clt_mdct_backward_m0plus)
+    target_compile_definitions(opus_codec PUBLIC -DOPUS_CELT_M0PLUS)
+endif()
+
+# SILK's synthesis filters and NLSF to LPC conversion, written out for orders 10 and 16 and
+# bit-exact (see opus_silk_m0plus.c).  Only the decoder's calls are pointed at them, so Opus' own
+# silk_decode_core and silk_NLSF2A are still built, for host/test_silk_m0plus.c and the bench.
+if (OPUS_SILK_M0PLUS)
+    target_sources(opus_codec PRIVATE ${OPUS_CODEC_ROOT}/opus_silk_m0plus.c)
+    set_property(SOURCE ${OPUS_DIR}/silk/decode_frame.c APPEND PROPERTY
+                 COMPILE_DEFINITIONS silk_decode_core=silk_decode_core_m0plus)
+    set_property(SOURCE ${OPUS_DIR}/silk/decode_parameters.c ${OPUS_DIR}/silk/CNG.c APPEND PROPERTY
+                 COMPILE_DEFINITIONS silk_NLSF2A=silk_NLSF2A_m0plus)
+    target_compile_definitions(opus_codec PUBLIC -DOPUS_SILK_M0PLUS)
+endif()
@@ -0,0 +1,84 @@
+// Opus Fixed-Point Macros for Cortex-M0+
+// Force-included into every Opus source when built with OPUS_M0PLUS_MACROS (see CMakeLists.txt).
+// Opus' own ARM versions of these need ARMv5E or later, so on the M0+ it falls back to the generic C
+// macros.  Those are already 32-bit only, but as macros they evaluate their arguments more than once
+// and mix signed and unsigned halves in ways GCC doesn't tidy up for Thumb-1.  silk_SMMUL goes through
+// a full 64-bit multiply call.  Each one here gives exactly the same result as the generic version,
+// including wrap-around, so the decoded audio doesn't change.
+//
+// This pulls in Opus' own headers first so their include guards are set, then replaces the macros.
+// Where Opus has fast 64-bit arithmetic (OPUS_FAST_INT64) it uses 64-bit versions instead and this
+// steps aside, unless OPUS_M0PLUS_FORCE is defined: host/test_m0plus.c does that to check these
+// against the generic macros on a 64-bit machine.
+//
+// Integer divides need nothing here: the SDK's pico_divider already provides __aeabi_idiv and friends
+// on the hardware divider, for the Opus library too.  OPUS_M0PLUS_MACROS also puts those in SRAM.
+#ifndef OPUS_M0PLUS_H
+#define OPUS_M0PLUS_H
+
+#include "celt/arch.h"
+#include "silk/SigProc_FIX.h"   // Includes silk/macros.h, and has silk_SMMUL.
+
+#if defined(FIXED_POINT) && (!OPUS_FAST_INT64 || defined(OPUS_M0PLUS_FORCE))
+
+// (a32 * (opus_int16)b32) >> 16.  The low half of a32 is never negative, so it isn't sign extended.
+static OPUS_INLINE opus_int32 silk_SMULWB_m0plus (opus_int32 a32, opus_int32 b32) {
+    opus_int32 b16 = (opus_int16)b32;
+    return (a32 >> 16) * b16 + (opus_int32)((opus_int32)(a32 & 0xFFFF) * b16 >> 16);
+}
+
+// (a32 * (b32 >> 16)) >> 16
+static OPUS_INLINE opus_int32 silk_SMULWT_m0plus (opus_int32 a32, opus_int32 b32) {
+    opus_int32 b16 = b32 >> 16;
+    return (a32 >> 16) * b16 + (opus_int32)((opus_int32)(a32 & 0xFFFF) * b16 >> 16);
+}
+
+// (a32 * b32) >> 16, wrapping like the generic silk_MLA.
+static OPUS_INLINE opus_int32 silk_SMULWW_m0plus (opus_int32 a32, opus_int32 b32) {
+    opus_int32 high = ((b32 >> 15) + 1) >> 1;
+    return (opus_int32)((opus_uint32)silk_SMULWB_m0plus(a32, b32) + (opus_uint32)a32 * (opus_uint32)high);
+}
+
+// (a32 * b32) >> 32 from four 16x16 products, instead of a call to the 64-bit multiply.
+static OPUS_INLINE opus_int32 silk_SMMUL_m0plus (opus_int32 a32, opus_int32 b32) {
+    opus_uint32 al = (opus_uint32)a32 & 0xFFFF, bl = (opus_uint32)b32 & 0xFFFF;
+    opus_int32 ah = a32 >> 16, bh = b32 >> 16;
+    opus_int32 lh = ah * (opus_int32)bl;
+    opus_int32 hl = (opus_int32)al * bh;
+    opus_int32 carry = (opus_int32)((al * bl) >> 16) + (lh & 0xFFFF) + (hl & 0xFFFF);
+    return ah * bh + (lh >> 16) + (hl >> 16) + (carry >> 16);
+}
+
+// ((opus_val16)a * b) >> 15 and >> 16, the way fixed_generic.h splits them.
+static OPUS_INLINE opus_val32 MULT16_32_Q15_m0plus (opus_val16 a, opus_val32 b) {
+    return (opus_val32)((opus_uint32)((opus_int32)a * (b >> 16)) << 1) +
+           ((opus_int32)a * (opus_int32)(b & 0xFFFF) >> 15);
+}
+
+static OPUS_INLINE opus_val32 MULT16_32_Q16_m0plus (opus_val16 a, opus_val32 b) {
+    return (opus_int32)a * (b >> 16) + ((opus_int32)a * (opus_int32)(b & 0xFFFF) >> 16);
+}
+
+#undef silk_SMULWB
+#undef silk_SMLAWB
+#undef silk_SMULWT
+#undef silk_SMLAWT
+#undef silk_SMULWW
+#undef silk_SMLAWW
+#undef silk_SMMUL
+#undef MULT16_32_Q15
+#undef MULT16_32_Q16
+
+#define silk_SMULWB(a32, b32)       silk_SMULWB_m0plus((a32), (b32))
+#define silk_SMLAWB(a32, b32, c32)  ((opus_int32)((opus_uint32)(a32) + (opus_uint32)silk_SMULWB_m0plus((b32), (c32))))
+#define silk_SMULWT(a32, b32)       silk_SMULWT_m0plus((a32), (b32))
+#define silk_SMLAWT(a32, b32, c32)  ((opus_int32)((opus_uint32)(a32) + (opus_uint32)silk_SMULWT_m0plus((b32), (c32))))
+#define silk_SMULWW(a32, b32)       silk_SMULWW_m0plus((a32), (b32))
+#define silk_SMLAWW(a32, b32, c32)  ((opus_int32)((opus_uint32)(a32) + (opus_uint32)silk_SMULWW_m0plus((b32), (c32))))
+#define silk_SMMUL(a32, b32)        silk_SMMUL_m0plus((a32), (b32))
+#define MULT16_32_Q15(a, b)         MULT16_32_Q15_m0plus((a), (b))
+#define MULT16_32_Q16(a, b)         MULT16_32_Q16_m0plus((a), (b))
+
+#endif
+
+#endif
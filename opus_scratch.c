@@ -0,0 +1,96 @@
+#include <stdio.h>
+#include <string.h>
+#include "pico/platform.h"
+#include "settings.h"
+#include "opus_scratch.h"
+
+#ifdef OPUS_SCRATCH_ARENA
+
+#define SCRATCH_FILL   0xA5       // Paint pattern used to find the high-water mark.
+#define SCRATCH_CANARY 0x5C7A7C4E // Guard word past the end of the arena.
+
+// The arena and its guard word.  OPUS_SCRATCH_PLACEMENT picks the SRAM bank (see settings.h).
+static uint8_t OPUS_SCRATCH_PLACEMENT scratchArena[OPUS_SCRATCH_SIZE + sizeof(uint32_t)] __attribute__((aligned(8)));
+static volatile bool scratchInUse = false;
+
+// Opus' pseudostack pointer, defined in celt.c.  It's left at the arena base between decodes.
+extern char *global_stack;
+
+
+// Paint the arena so the high-water mark can be measured later, and set the guard word.
+// Call this once, before the first decoder is created.
+void OpusScratchInit (void) {
+    uint32_t canary = SCRATCH_CANARY;
+    memset(scratchArena, SCRATCH_FILL, OPUS_SCRATCH_SIZE);
+    memcpy(scratchArena + OPUS_SCRATCH_SIZE, &canary, sizeof(canary));
+}
+
+
+// Called by Opus (through custom_support.h) the first time it needs its pseudostack.
+// The requested size is Opus' GLOBAL_STACK_SIZE, which custom_support.h sets to the arena size.
+void * OpusScratchGet (size_t size) {
+    if (size > OPUS_SCRATCH_SIZE)
+        panic("Opus scratch: %u bytes requested, arena is %u.\n", (unsigned)size, OPUS_SCRATCH_SIZE);
+    return scratchArena;
+}
+
+
+// Claim the arena around a decode.  Decoders share it, so they must never overlap.
+void OpusScratchAcquire (void) {
+    if (scratchInUse)
+        panic("Opus scratch: arena is already in use.\n");
+    scratchInUse = true;
+}
+
+
+// Release the arena after a decode.  Every ALLOC_STACK should have been unwound by now.
+void OpusScratchRelease (void) {
+    if (global_stack != NULL && global_stack != (char *)scratchArena)
+        panic("Opus scratch: pseudostack not unwound (%d bytes).\n", (int)(global_stack - (char *)scratchArena));
+    scratchInUse = false;
+}
+
+
+// Return false if the guard word past the end of the arena has been overwritten.
+bool OpusScratchCheck (void) {
+    uint32_t canary;
+    memcpy(&canary, scratchArena + OPUS_SCRATCH_SIZE, sizeof(canary));
+    return canary == SCRATCH_CANARY;
+}
+
+
+// Highest byte of the arena that has ever been written, found by scanning down for the paint.
+size_t OpusScratchHighWater (void) {
+    size_t used = OPUS_SCRATCH_SIZE;
+    while (used && scratchArena[used - 1] == SCRATCH_FILL)
+        used--;
+    return used;
+}
+
+
+// Repaint the arena so the high-water mark starts again from nothing.  Only between decodes: nothing
+// in the arena outlives one.
+void OpusScratchResetHighWater (void) {
+    if (scratchInUse)
+        panic("Opus scratch: can't reset the high-water mark during a decode.\n");
+    memset(scratchArena, SCRATCH_FILL, OPUS_SCRATCH_SIZE);
+}
+
+
+size_t OpusScratchSize (void) {
+    return OPUS_SCRATCH_SIZE;
+}
+
+#else
+
+// Built with USE_ALLOCA.  Opus' temporaries are on the task stack and there's nothing to track.
+void OpusScratchInit (void) {}
+void * OpusScratchGet (size_t size) { (void)size; return NULL; }
+void OpusScratchAcquire (void) {}
+void OpusScratchRelease (void) {}
+bool OpusScratchCheck (void) { return true; }
+size_t OpusScratchHighWater (void) { return 0; }
+void OpusScratchResetHighWater (void) {}
+size_t OpusScratchSize (void) { return 0; }
+
+#endif
@@ -0,0 +1,22 @@
+// Opus Scratch Arena Header File
+// When built with OPUS_SCRATCH_ARENA, Opus' temporary allocations (ALLOC/VARDECL) come from one
+// statically placed arena instead of alloca() on the calling task's stack.  Opus' pseudostack is
+// a single global, so every decoder shares the arena.  That's fine as long as no two decoders
+// run at the same time, which OpusScratchAcquire/Release check.
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef OPUS_SCRATCH_H
+#define OPUS_SCRATCH_H
+
+void OpusScratchInit (void);
+void * OpusScratchGet (size_t size);
+void OpusScratchAcquire (void);
+void OpusScratchRelease (void);
+bool OpusScratchCheck (void);
+size_t OpusScratchHighWater (void);
+void OpusScratchResetHighWater (void);
+size_t OpusScratchSize (void);
+
+#endif
@@ -0,0 +1,384 @@
+// Cortex-M0+ versions of SILK's synthesis (silk_decode_core) and NLSF to LPC conversion
+// (silk_NLSF2A), the two places a SILK frame spends most of its time once the range decoder is done.
+// SILK only ever uses LPC orders 10 (8 and 12kHz) and 16 (16kHz), so each is written out for those.
+//
+// The arithmetic is exactly Opus' own, with the same rounding and wrap-around, so the output is bit
+// for bit the same (host/test_silk_m0plus.c checks it).  What changes is the layout:
+//   - LPC synthesis works out two output samples per pass.  Each state value is loaded once and goes
+//     into both sums, tap m of the first sample and tap m+1 of the second; the second gets its tap 0
+//     once the first is done.  The filter coefficients are packed two to a word and taken apart with
+//     silk_SMULWB and silk_SMULWT, and every tap is written out for the order.  The sums are kept
+//     unsigned, which wraps exactly like silk_SMLAWB's.
+//   - The 5-tap LTP filter keeps its coefficients and the last four lagged values in locals, so each
+//     output sample loads one new value.  That holds because the lag is always more than 2, so the
+//     value it loads was written before that sample.
+//   - silk_NLSF2A_find_poly's loops are written out for 5 and 8 (orders 10 and 16), and its Q16
+//     multiply uses 32-bit halves instead of silk_SMULL's 64-bit product.
+// The rest of silk_decode_core (excitation, gains, re-whitening) and of silk_NLSF2A is Opus' code as is.
+#include "opus_silk_m0plus.h"
+#include "stack_alloc.h"
+
+#define M0PLUS_INLINE static inline __attribute__((always_inline))
+
+#define QA 16                               // As NLSF2A.c.
+#ifndef MAX_LPC_STABILIZE_ITERATIONS
+#define MAX_LPC_STABILIZE_ITERATIONS 16
+#endif
+
+
+// Two samples of tap m from the state value s[-1 - m]: tap m of this sample into sum0, tap m + 1 of
+// the next into sum1.  a packs the coefficients two to a word, the even one in the low half.
+#define LPC_TAP_EVEN(m)                                                     \
+    x = s[-1 - (m)];                                                        \
+    sum0 += (opus_uint32)silk_SMULWB(x, a[(m) / 2]);                        \
+    sum1 += (opus_uint32)silk_SMULWT(x, a[(m) / 2])
+#define LPC_TAP_ODD(m)                                                      \
+    x = s[-1 - (m)];                                                        \
+    sum0 += (opus_uint32)silk_SMULWT(x, a[(m) / 2]);                        \
+    sum1 += (opus_uint32)silk_SMULWB(x, a[(m) / 2 + 1])
+
+
+// Add the prediction to the excitation and scale with the gain, as silk_decode_core does for each
+// sample.  Returns the new state value.
+M0PLUS_INLINE opus_int32 LpcOutput (opus_uint32 sum, opus_int32 res_Q14, opus_int32 Gain_Q10, opus_int16 * xq) {
+    opus_int32 y = silk_ADD_SAT32(res_Q14, silk_LSHIFT_SAT32((opus_int32)sum, 4));
+    *xq = (opus_int16)silk_SAT16(silk_RSHIFT_ROUND(silk_SMULWW(y, Gain_Q10), 8));
+    return y;
+}
+
+
+// One subframe of the LPC synthesis filter for order 10 or 16.  s points at the subframe's first
+// output in sLPC_Q14, with the order's worth of history before it.
+M0PLUS_INLINE void LpcSubframe (opus_int32 * s, const opus_int32 * res_Q14, const opus_int32 * a, opus_int32 Gain_Q10,
+                                opus_int16 * xq, int length, int order) {
+    opus_uint32 sum0, sum1;
+    opus_int32 x;
+    int i, m;
+
+    for (i = 0; i + 1 < length; i += 2, s += 2) {
+        // silk_decode_core starts each sum at order / 2, to take off silk_SMLAWB's bias.
+        sum0 = sum1 = (opus_uint32)(order >> 1);
+        LPC_TAP_EVEN(0);
+        LPC_TAP_ODD(1);
+        LPC_TAP_EVEN(2);
+        LPC_TAP_ODD(3);
+        LPC_TAP_EVEN(4);
+        LPC_TAP_ODD(5);
+        LPC_TAP_EVEN(6);
+        LPC_TAP_ODD(7);
+        LPC_TAP_EVEN(8);
+        if (order == 16) {
+            LPC_TAP_ODD(9);
+            LPC_TAP_EVEN(10);
+            LPC_TAP_ODD(11);
+            LPC_TAP_EVEN(12);
+            LPC_TAP_ODD(13);
+            LPC_TAP_EVEN(14);
+        }
+        // The oldest value is only in the first sample's sum.
+        sum0 += (opus_uint32)silk_SMULWT(s[-order], a[order / 2 - 1]);
+
+        s[0] = LpcOutput(sum0, res_Q14[i], Gain_Q10, &xq[i]);
+        sum1 += (opus_uint32)silk_SMULWB(s[0], a[0]);
+        s[1] = LpcOutput(sum1, res_Q14[i + 1], Gain_Q10, &xq[i + 1]);
+    }
+
+    // SILK's subframes are 40, 60 or 80 samples, so this is never needed, but an odd one would still work.
+    for (; i < length; i++, s++) {
+        sum0 = (opus_uint32)(order >> 1);
+        for (m = 0; m < order; m++)
+            sum0 += (opus_uint32)(m & 1 ? silk_SMULWT(s[-1 - m], a[m >> 1]) : silk_SMULWB(s[-1 - m], a[m >> 1]));
+        s[0] = LpcOutput(sum0, res_Q14[i], Gain_Q10, &xq[i]);
+    }
+}
+
+
+// One subframe of the 5-tap long-term predictor.  lag points at the newest of the lagged values for
+// the first sample (pred_lag_ptr in silk_decode_core), and sLTP_Q15 at where its output goes.
+M0PLUS_INLINE void LtpSubframe (opus_int32 * res_Q14, const opus_int32 * exc_Q14, opus_int32 * sLTP_Q15,
+                                const opus_int32 * lag, const opus_int16 * B_Q14, int length) {
+    opus_int32 b0 = B_Q14[0], b1 = B_Q14[1], b2 = B_Q14[2], b3 = B_Q14[3], b4 = B_Q14[4];
+    opus_int32 x0, x1 = lag[-1], x2 = lag[-2], x3 = lag[-3], x4 = lag[-4];
+    opus_uint32 pred_Q13;
+    int i;
+
+    for (i = 0; i < length; i++) {
+        x0 = lag[i];
+        // Starts at 2 to take off silk_SMLAWB's bias, as silk_decode_core does.
+        pred_Q13 = 2;
+        pred_Q13 += (opus_uint32)silk_SMULWB(x0, b0);
+        pred_Q13 += (opus_uint32)silk_SMULWB(x1, b1);
+        pred_Q13 += (opus_uint32)silk_SMULWB(x2, b2);
+        pred_Q13 += (opus_uint32)silk_SMULWB(x3, b3);
+        pred_Q13 += (opus_uint32)silk_SMULWB(x4, b4);
+        x4 = x3;
+        x3 = x2;
+        x2 = x1;
+        x1 = x0;
+
+        res_Q14[i] = silk_ADD_LSHIFT32(exc_Q14[i], (opus_int32)pred_Q13, 1);
+        sLTP_Q15[i] = silk_LSHIFT(res_Q14[i], 1);
+    }
+}
+
+
+// silk_decode_core, with the LTP and LPC filters above.  The rest is as Opus has it.
+void silk_decode_core_m0plus (silk_decoder_state * psDec, silk_decoder_control * psDecCtrl, opus_int16 xq[],
+                              const opus_int16 pulses[MAX_FRAME_LENGTH], int arch) {
+    opus_int i, k, lag = 0, start_idx, sLTP_buf_idx, NLSF_interpolation_flag, signalType;
+    opus_int16 * A_Q12, * B_Q14, * pxq;
+    opus_int32 A_pairs[MAX_LPC_ORDER / 2];
+    VARDECL(opus_int16, sLTP);
+    VARDECL(opus_int32, sLTP_Q15);
+    opus_int32 Gain_Q10, inv_gain_Q31, gain_adj_Q16, rand_seed, offset_Q10;
+    opus_int32 * pexc_Q14, * pres_Q14;
+    VARDECL(opus_int32, res_Q14);
+    VARDECL(opus_int32, sLPC_Q14);
+    SAVE_STACK;
+
+    silk_assert(psDec->prev_gain_Q16 != 0);
+    celt_assert(psDec->LPC_order == 10 || psDec->LPC_order == 16);
+
+    ALLOC(sLTP, psDec->ltp_mem_length, opus_int16);
+    ALLOC(sLTP_Q15, psDec->ltp_mem_length + psDec->frame_length, opus_int32);
+    ALLOC(res_Q14, psDec->subfr_length, opus_int32);
+    ALLOC(sLPC_Q14, psDec->subfr_length + MAX_LPC_ORDER, opus_int32);
+
+    offset_Q10 = silk_Quantization_Offsets_Q10[psDec->indices.signalType >> 1][psDec->indices.quantOffsetType];
+
+    NLSF_interpolation_flag = psDec->indices.NLSFInterpCoef_Q2 < 1 << 2;
+
+    // Decode excitation
+    rand_seed = psDec->indices.Seed;
+    for (i = 0; i < psDec->frame_length; i++) {
+        rand_seed = silk_RAND(rand_seed);
+        psDec->exc_Q14[i] = silk_LSHIFT((opus_int32)pulses[i], 14);
+        if (psDec->exc_Q14[i] > 0)
+            psDec->exc_Q14[i] -= QUANT_LEVEL_ADJUST_Q10 << 4;
+        else if (psDec->exc_Q14[i] < 0)
+            psDec->exc_Q14[i] += QUANT_LEVEL_ADJUST_Q10 << 4;
+        psDec->exc_Q14[i] += offset_Q10 << 4;
+        if (rand_seed < 0)
+            psDec->exc_Q14[i] = -psDec->exc_Q14[i];
+
+        rand_seed = silk_ADD32_ovflw(rand_seed, pulses[i]);
+    }
+
+    // Copy LPC state
+    silk_memcpy(sLPC_Q14, psDec->sLPC_Q14_buf, MAX_LPC_ORDER * sizeof(opus_int32));
+
+    pexc_Q14 = psDec->exc_Q14;
+    pxq = xq;
+    sLTP_buf_idx = psDec->ltp_mem_length;
+    for (k = 0; k < psDec->nb_subfr; k++) {
+        pres_Q14 = res_Q14;
+        A_Q12 = psDecCtrl->PredCoef_Q12[k >> 1];
+
+        // Pack the LPC coefficients two to a word for LpcSubframe.
+        for (i = 0; i < psDec->LPC_order; i += 2)
+            A_pairs[i >> 1] = (opus_int32)((opus_uint32)(opus_uint16)A_Q12[i] | (opus_uint32)A_Q12[i + 1] << 16);
+        B_Q14 = &psDecCtrl->LTPCoef_Q14[k * LTP_ORDER];
+        signalType = psDec->indices.signalType;
+
+        Gain_Q10 = silk_RSHIFT(psDecCtrl->Gains_Q16[k], 6);
+        inv_gain_Q31 = silk_INVERSE32_varQ(psDecCtrl->Gains_Q16[k], 47);
+
+        // Calculate gain adjustment factor
+        if (psDecCtrl->Gains_Q16[k] != psDec->prev_gain_Q16) {
+            gain_adj_Q16 = silk_DIV32_varQ(psDec->prev_gain_Q16, psDecCtrl->Gains_Q16[k], 16);
+
+            // Scale short term state
+            for (i = 0; i < MAX_LPC_ORDER; i++)
+                sLPC_Q14[i] = silk_SMULWW(gain_adj_Q16, sLPC_Q14[i]);
+        } else {
+            gain_adj_Q16 = (opus_int32)1 << 16;
+        }
+
+        // Save inv_gain
+        silk_assert(inv_gain_Q31 != 0);
+        psDec->prev_gain_Q16 = psDecCtrl->Gains_Q16[k];
+
+        // Avoid abrupt transition from voiced PLC to unvoiced normal decoding
+        if (psDec->lossCnt && psDec->prevSignalType == TYPE_VOICED &&
+            psDec->indices.signalType != TYPE_VOICED && k < MAX_NB_SUBFR / 2) {
+            silk_memset(B_Q14, 0, LTP_ORDER * sizeof(opus_int16));
+            B_Q14[LTP_ORDER / 2] = SILK_FIX_CONST(0.25, 14);
+
+            signalType = TYPE_VOICED;
+            psDecCtrl->pitchL[k] = psDec->lagPrev;
+        }
+
+        if (signalType == TYPE_VOICED) {
+            lag = psDecCtrl->pitchL[k];
+
+            // Re-whitening
+            if (k == 0 || (k == 2 && NLSF_interpolation_flag)) {
+                // Rewhiten with new A coefs
+                start_idx = psDec->ltp_mem_length - lag - psDec->LPC_order - LTP_ORDER / 2;
+                celt_assert(start_idx > 0);
+
+                if (k == 2)
+                    silk_memcpy(&psDec->outBuf[psDec->ltp_mem_length], xq, 2 * psDec->subfr_length * sizeof(opus_int16));
+
+                silk_LPC_analysis_filter(&sLTP[start_idx], &psDec->outBuf[start_idx + k * psDec->subfr_length],
+                                         A_Q12, psDec->ltp_mem_length - start_idx, psDec->LPC_order, arch);
+
+                // After a packet loss, apply a gain adjustment
+                if (k == 0) {
+                    // Do LTP downscaling to reduce inter-packet dependency
+                    inv_gain_Q31 = silk_LSHIFT(silk_SMULWB(inv_gain_Q31, psDecCtrl->LTP_scale_Q14), 2);
+                }
+                for (i = 0; i < lag + LTP_ORDER / 2; i++)
+                    sLTP_Q15[sLTP_buf_idx - i - 1] = silk_SMULWB(inv_gain_Q31, sLTP[psDec->ltp_mem_length - i - 1]);
+            } else {
+                // Update LTP state when Gain changes
+                if (gain_adj_Q16 != (opus_int32)1 << 16) {
+                    for (i = 0; i < lag + LTP_ORDER / 2; i++)
+                        sLTP_Q15[sLTP_buf_idx - i - 1] = silk_SMULWW(gain_adj_Q16, sLTP_Q15[sLTP_buf_idx - i - 1]);
+                }
+            }
+        }
+
+        // Long-term prediction
+        if (signalType == TYPE_VOICED) {
+            LtpSubframe(pres_Q14, pexc_Q14, &sLTP_Q15[sLTP_buf_idx], &sLTP_Q15[sLTP_buf_idx - lag + LTP_ORDER / 2],
+                        B_Q14, psDec->subfr_length);
+            sLTP_buf_idx += psDec->subfr_length;
+        } else {
+            pres_Q14 = pexc_Q14;
+        }
+
+        // Short-term prediction, written out for each order so the taps are constants.
+        if (psDec->LPC_order == 16)
+            LpcSubframe(&sLPC_Q14[MAX_LPC_ORDER], pres_Q14, A_pairs, Gain_Q10, pxq, psDec->subfr_length, 16);
+        else
+            LpcSubframe(&sLPC_Q14[MAX_LPC_ORDER], pres_Q14, A_pairs, Gain_Q10, pxq, psDec->subfr_length, 10);
+
+        // Update LPC filter state
+        silk_memcpy(sLPC_Q14, &sLPC_Q14[psDec->subfr_length], MAX_LPC_ORDER * sizeof(opus_int32));
+        pexc_Q14 += psDec->subfr_length;
+        pxq += psDec->subfr_length;
+    }
+
+    // Save LPC state
+    silk_memcpy(psDec->sLPC_Q14_buf, sLPC_Q14, MAX_LPC_ORDER * sizeof(opus_int32));
+    RESTORE_STACK;
+}
+
+
+// (a * b + 2^15) >> 16 for silk_NLSF2A_find_poly, which Opus works out as a 64-bit product and
+// silk_RSHIFT_ROUND64.  Every part but the lowest is already a whole multiple of 2^16, so only
+// that one needs rounding, and the sum wraps to the same 32 bits the cast to opus_int32 keeps.
+M0PLUS_INLINE opus_int32 MulQA (opus_int32 a, opus_int32 b) {
+    opus_int32 ah = a >> 16, bh = b >> 16;
+    opus_uint32 al = (opus_uint32)a & 0xFFFF, bl = (opus_uint32)b & 0xFFFF;
+    return (opus_int32)(((opus_uint32)(ah * bh) << 16) + (opus_uint32)ah * bl + al * (opus_uint32)bh +
+                        ((al * bl + 0x8000) >> 16));
+}
+
+
+// One pass of silk_NLSF2A_find_poly's outer loop, for k from 1 to 7.  k is a constant wherever this
+// is inlined, so the switch leaves just its inner loop, written out.
+M0PLUS_INLINE void PolyStep (opus_int32 * out, opus_int32 ftmp, int k) {
+    out[k + 1] = silk_LSHIFT(out[k - 1], 1) - MulQA(ftmp, out[k]);
+    switch (k) {
+        case 7: out[7] += out[5] - MulQA(ftmp, out[6]);     // fall through
+        case 6: out[6] += out[4] - MulQA(ftmp, out[5]);     // fall through
+        case 5: out[5] += out[3] - MulQA(ftmp, out[4]);     // fall through
+        case 4: out[4] += out[2] - MulQA(ftmp, out[3]);     // fall through
+        case 3: out[3] += out[1] - MulQA(ftmp, out[2]);     // fall through
+        case 2: out[2] += out[0] - MulQA(ftmp, out[1]);     // fall through
+        default: break;
+    }
+    out[1] -= ftmp;
+}
+
+
+// silk_NLSF2A_find_poly for dd of 5 or 8.
+M0PLUS_INLINE void FindPoly (opus_int32 * out, const opus_int32 * cLSF, int dd) {
+    out[0] = silk_LSHIFT(1, QA);
+    out[1] = -cLSF[0];
+    PolyStep(out, cLSF[2], 1);
+    PolyStep(out, cLSF[4], 2);
+    PolyStep(out, cLSF[6], 3);
+    PolyStep(out, cLSF[8], 4);
+    if (dd == 8) {
+        PolyStep(out, cLSF[10], 5);
+        PolyStep(out, cLSF[12], 6);
+        PolyStep(out, cLSF[14], 7);
+    }
+}
+
+
+// silk_NLSF2A, with FindPoly.  The rest is as Opus has it.
+void silk_NLSF2A_m0plus (opus_int16 * a_Q12, const opus_int16 * NLSF, const opus_int d, int arch) {
+    // This ordering was found to maximize quality. It improves numerical accuracy of find_poly
+    // compared to "standard" ordering.
+    static const unsigned char ordering16[16] = {
+        0, 15, 8, 7, 4, 11, 12, 3, 2, 13, 10, 5, 6, 9, 14, 1
+    };
+    static const unsigned char ordering10[10] = {
+        0, 9, 6, 3, 4, 5, 8, 1, 2, 7
+    };
+    const unsigned char * ordering;
+    opus_int k, i, dd;
+    opus_int32 cos_LSF_QA[SILK_MAX_ORDER_LPC];
+    opus_int32 P[SILK_MAX_ORDER_LPC / 2 + 1], Q[SILK_MAX_ORDER_LPC / 2 + 1];
+    opus_int32 Ptmp, Qtmp, f_int, f_frac, cos_val, delta;
+    opus_int32 a32_QA1[SILK_MAX_ORDER_LPC];
+
+    silk_assert(LSF_COS_TAB_SZ_FIX == 128);
+    celt_assert(d == 10 || d == 16);
+
+    // Convert LSFs to 2*cos(LSF), using piecewise linear curve from table
+    ordering = d == 16 ? ordering16 : ordering10;
+    for (k = 0; k < d; k++) {
+        silk_assert(NLSF[k] >= 0);
+
+        // f_int on a scale 0-127 (rounded down), f_frac 0..255
+        f_int = silk_RSHIFT(NLSF[k], 15 - 7);
+        f_frac = NLSF[k] - silk_LSHIFT(f_int, 15 - 7);
+
+        silk_assert(f_int >= 0);
+        silk_assert(f_int < LSF_COS_TAB_SZ_FIX);
+
+        // Read start and end value from table
+        cos_val = silk_LSFCosTab_FIX_Q12[f_int];                 // Q12
+        delta = silk_LSFCosTab_FIX_Q12[f_int + 1] - cos_val;     // Q12, with a range of 0..200
+
+        // Linear interpolation
+        cos_LSF_QA[ordering[k]] = silk_RSHIFT_ROUND(silk_LSHIFT(cos_val, 8) + silk_MUL(delta, f_frac), 20 - QA);
+    }
+
+    dd = silk_RSHIFT(d, 1);
+
+    // Generate even and odd polynomials using convolution
+    if (dd == 8) {
+        FindPoly(P, &cos_LSF_QA[0], 8);
+        FindPoly(Q, &cos_LSF_QA[1], 8);
+    } else {
+        FindPoly(P, &cos_LSF_QA[0], 5);
+        FindPoly(Q, &cos_LSF_QA[1], 5);
+    }
+
+    // Convert even and odd polynomials to opus_int32 Q12 filter coefs
+    for (k = 0; k < dd; k++) {
+        Ptmp = P[k + 1] + P[k];
+        Qtmp = Q[k + 1] - Q[k];
+
+        // The Ptmp and Qtmp values at this stage need to fit in int32
+        a32_QA1[k] = -Qtmp - Ptmp;              // QA+1
+        a32_QA1[d - k - 1] = Qtmp - Ptmp;       // QA+1
+    }
+
+    // Convert int32 coefficients to Q12 int16 coefs
+    silk_LPC_fit(a_Q12, a32_QA1, 12, QA + 1, d);
+
+    for (i = 0; silk_LPC_inverse_pred_gain(a_Q12, d, arch) == 0 && i < MAX_LPC_STABILIZE_ITERATIONS; i++) {
+        // Prediction coefficients are (too close to) unstable; apply bandwidth expansion on the
+        // unscaled coefficients, convert to Q12 and measure again
+        silk_bwexpander_32(a32_QA1, d, 65536 - silk_LSHIFT(2, i));
+        for (k = 0; k < d; k++)
+            a_Q12[k] = (opus_int16)silk_RSHIFT_ROUND(a32_QA1[k], QA + 1 - 12);     // QA+1 -> Q12
+    }
+}
@@ -0,0 +1,15 @@
+// Opus SILK Kernels for Cortex-M0+ Header File
+// Drop-ins for SILK's silk_decode_core and silk_NLSF2A, with the LTP and LPC synthesis filters and the
+// NLSF to LPC conversion rewritten for the M0+ (see opus_silk_m0plus.c).  The OPUS_SILK_M0PLUS option
+// builds them into opus_codec and points the decoder's calls at them; Opus' own versions are still
+// there for host/test_silk_m0plus.c and the bench to compare against.
+#include "main.h"
+
+#ifndef OPUS_SILK_M0PLUS_H
+#define OPUS_SILK_M0PLUS_H
+
+void silk_decode_core_m0plus (silk_decoder_state * psDec, silk_decoder_control * psDecCtrl, opus_int16 xq[],
+                              const opus_int16 pulses[MAX_FRAME_LENGTH], int arch);
+void silk_NLSF2A_m0plus (opus_int16 * a_Q12, const opus_int16 * NLSF, const opus_int d, int arch);
+
+#endif
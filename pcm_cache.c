@@ -0,0 +1,170 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+
+#include "pcm_cache.h"
+
+static pcmCacheEntry_t cacheEntries[PCM_CACHE_ENTRIES];
+static uint32_t cacheBytes = 0;
+static uint32_t useCounter = 0;
+static uint32_t hits = 0, misses = 0, evictions = 0;
+static volatile bool clearRequested = false; // Set from the console, applied by the decode loop.
+
+
+static pcmCacheEntry_t * Find (uint32_t id) {
+    uint32_t i;
+    for (i = 0; i < PCM_CACHE_ENTRIES; i++) {
+        if (cacheEntries[i].Pcm != NULL && cacheEntries[i].Id == id)
+            return &cacheEntries[i];
+    }
+    return NULL;
+}
+
+
+static void Free (pcmCacheEntry_t * entry) {
+    vPortFree(entry->Pcm);
+    cacheBytes -= entry->Samples * sizeof(int16_t);
+    memset(entry, 0, sizeof(*entry));
+}
+
+
+// Drop unpinned entries if the console asked for it.
+static void CheckClear (void) {
+    uint32_t i;
+    if (clearRequested) {
+        clearRequested = false;
+        for (i = 0; i < PCM_CACHE_ENTRIES; i++) {
+            if (cacheEntries[i].Pcm != NULL && !cacheEntries[i].Pins)
+                Free(&cacheEntries[i]);
+        }
+        hits = misses = evictions = 0;
+    }
+}
+
+
+// The least recently used entry that isn't pinned, or NULL if they all are.
+static pcmCacheEntry_t * Oldest (void) {
+    pcmCacheEntry_t *oldest = NULL;
+    uint32_t i;
+    for (i = 0; i < PCM_CACHE_ENTRIES; i++) {
+        pcmCacheEntry_t *entry = &cacheEntries[i];
+        if (entry->Pcm != NULL && !entry->Pins && (oldest == NULL || entry->LastUse < oldest->LastUse))
+            oldest = entry;
+    }
+    return oldest;
+}
+
+
+// Look a clip up.  On a hit, returns its PCM and pins it until PcmCacheRelease.
+const int16_t * PcmCacheLookup (uint32_t id, uint32_t * samples) {
+    pcmCacheEntry_t *entry;
+
+    CheckClear();
+    if (id == PCM_CACHE_NO_ID)
+        return NULL;
+
+    entry = Find(id);
+    if (entry == NULL || !entry->Valid) {
+        misses++;
+        return NULL;
+    }
+
+    hits++;
+    entry->LastUse = ++useCounter;
+    entry->Pins++;
+    *samples = entry->Samples;
+    return entry->Pcm;
+}
+
+
+// Whether a clip would be a hit, without pinning it or counting it.
+bool PcmCacheHas (uint32_t id) {
+    pcmCacheEntry_t *entry;
+
+    CheckClear();
+    entry = Find(id);
+    return id != PCM_CACHE_NO_ID && entry != NULL && entry->Valid;
+}
+
+
+// Make room for a clip of the given length and return the space to decode it into, pinned.
+// Evicts least recently used clips as needed.  Returns NULL if the clip is too big, is already
+// being filled, or can't be fitted around the pinned entries.
+int16_t * PcmCacheReserve (uint32_t id, uint32_t samples) {
+    uint32_t bytes = samples * sizeof(int16_t);
+    pcmCacheEntry_t *entry, *victim;
+    uint32_t i;
+
+    if (id == PCM_CACHE_NO_ID || samples == 0 || samples > PCM_CACHE_MAX_SAMPLES || bytes > PCM_CACHE_BUDGET)
+        return NULL;
+    if (Find(id) != NULL)
+        return NULL;
+
+    for (;;) {
+        entry = NULL;
+        for (i = 0; i < PCM_CACHE_ENTRIES && entry == NULL; i++) {
+            if (cacheEntries[i].Pcm == NULL)
+                entry = &cacheEntries[i];
+        }
+        if (entry != NULL && cacheBytes + bytes <= PCM_CACHE_BUDGET)
+            break;
+
+        victim = Oldest();
+        if (victim == NULL)
+            return NULL;
+        Free(victim);
+        evictions++;
+    }
+
+    entry->Pcm = pvPortMalloc(bytes);
+    if (entry->Pcm == NULL)
+        return NULL;
+    entry->Id = id;
+    entry->Samples = samples;
+    entry->LastUse = ++useCounter;
+    entry->Pins = 1;
+    entry->Valid = false;
+    cacheBytes += bytes;
+    return entry->Pcm;
+}
+
+
+// The reserved clip has been decoded in full and can be played from the cache.
+void PcmCacheCommit (uint32_t id) {
+    pcmCacheEntry_t *entry = Find(id);
+    if (entry != NULL)
+        entry->Valid = true;
+}
+
+
+// Done with a clip from PcmCacheLookup or PcmCacheReserve.  A reservation that was never committed
+// is thrown away.
+void PcmCacheRelease (uint32_t id) {
+    pcmCacheEntry_t *entry = Find(id);
+    if (entry == NULL)
+        return;
+    if (entry->Pins)
+        entry->Pins--;
+    if (!entry->Valid && !entry->Pins)
+        Free(entry);
+}
+
+
+void PcmCacheClear (void) {
+    clearRequested = true;
+}
+
+
+void PcmCachePrint (void) {
+    uint32_t i;
+
+    printf("PCM cache: %u of %u bytes, %u hits, %u misses, %u evictions.\r\n", (unsigned)cacheBytes,
+           (unsigned)PCM_CACHE_BUDGET, (unsigned)hits, (unsigned)misses, (unsigned)evictions);
+    for (i = 0; i < PCM_CACHE_ENTRIES; i++) {
+        pcmCacheEntry_t *entry = &cacheEntries[i];
+        if (entry->Pcm != NULL)
+            printf("  clip %u: %u samples%s%s\r\n", (unsigned)entry->Id, (unsigned)entry->Samples,
+                   entry->Valid ? "" : ", filling", entry->Pins ? ", playing" : "");
+    }
+}
@@ -0,0 +1,34 @@
+// PCM Cache Header File
+// Keeps the decoded PCM of short, often-played clips in spare heap, so replaying them skips Ogg
+// parsing and Opus decoding altogether.  Entries are keyed by clip ID and evicted least recently
+// used first to stay under PCM_CACHE_BUDGET bytes.  Entries being filled or played are pinned and
+// never evicted.
+// Everything here is called from the decode loop, apart from PcmCachePrint and PcmCacheClear.
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "settings.h"
+
+#ifndef PCM_CACHE_H
+#define PCM_CACHE_H
+
+#define PCM_CACHE_NO_ID 0 // Clips with this ID are never cached.
+
+typedef struct {
+    uint32_t Id;
+    int16_t * Pcm;
+    uint32_t Samples;
+    uint32_t LastUse;
+    uint8_t Pins;
+    bool Valid;     // Fully decoded.  False while the first play is still filling it.
+} pcmCacheEntry_t;
+
+const int16_t * PcmCacheLookup (uint32_t id, uint32_t * samples);
+bool PcmCacheHas (uint32_t id);
+int16_t * PcmCacheReserve (uint32_t id, uint32_t samples);
+void PcmCacheCommit (uint32_t id);
+void PcmCacheRelease (uint32_t id);
+void PcmCacheClear (void);
+void PcmCachePrint (void);
+
+#endif
@@ -0,0 +1,119 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "player.h"
+#include "phrase.h"
+
+static const phraseClip_t * library = NULL;
+static size_t libraryCount = 0;
+static const assetBundle_t * bundle = NULL;
+
+// Set from the console, applied by the decode loop.
+static phraseFragment_t requestedFragments[PHRASE_MAX_FRAGMENTS];
+static size_t requestedCount = 0;
+static volatile int requestedVoice = -1;
+
+
+void PhraseSetLibrary (const phraseClip_t * clips, size_t count) {
+    library = clips;
+    libraryCount = count;
+}
+
+
+void PhraseSetBundle (const assetBundle_t * assets) {
+    bundle = assets;
+}
+
+
+const phraseClip_t * PhraseFindClip (uint32_t id) {
+    size_t i;
+    for (i = 0; i < libraryCount; i++) {
+        if (library[i].Id == id)
+            return &library[i];
+    }
+    return NULL;
+}
+
+
+// Play a phrase on a voice, replacing whatever it was playing.
+// All of the fragments are looked up and parsed first, and crossfades are clamped to the length
+// of the fragments either side, so nothing can go wrong part way through.
+bool PhraseStart (int voice, const phraseFragment_t * fragments, size_t count) {
+    playerQueued_t entries[PHRASE_MAX_FRAGMENTS];
+    const phraseClip_t *clip;
+    const assetBundleEntry_t *entry;
+    int32_t fade;
+    size_t i;
+
+    if (count == 0 || count > PHRASE_MAX_FRAGMENTS || count > PLAYER_QUEUE_LEN + 1)
+        return false;
+
+    for (i = 0; i < count; i++) {
+        entries[i].Join = i ? (int32_t)fragments[i].JoinMs * PLAYER_SAMPLE_RATE / 1000 : 0;
+        clip = PhraseFindClip(fragments[i].Id);
+        if (clip != NULL) {
+            entries[i].Id = clip->Id;
+            entries[i].Clip = clip->Data;
+            entries[i].Length = clip->Length;
+            if (!PlayerPreParse(&entries[i])) {
+                printf("Phrase: clip %u won't parse.\r\n", (unsigned)fragments[i].Id);
+                return false;
+            }
+        } else if ((entry = AssetBundleFind(bundle, fragments[i].Id)) != NULL) {
+            // The packer has read the headers already.
+            entries[i].Id = entry->Id;
+            entries[i].Clip = AssetBundleClip(bundle, entry);
+            entries[i].Length = entry->Length;
+            entries[i].Samples = (int32_t)((uint64_t)entry->Samples * PLAYER_SAMPLE_RATE / 48000);
+            entries[i].PreSkip = entry->PreSkip;
+            entries[i].AudioOffset = (long)entry->AudioOffset;
+        } else {
+            printf("Phrase: no clip %u.\r\n", (unsigned)fragments[i].Id);
+            return false;
+        }
+    }
+
+    // A crossfade can't be longer than either fragment, or we won't know when to start it.
+    for (i = 1; i < count; i++) {
+        if (entries[i].Join < 0) {
+            fade = -entries[i].Join;
+            if (entries[i - 1].Samples < 0 || entries[i].Samples < 0)
+                fade = 0;
+            if (fade > entries[i - 1].Samples)
+                fade = entries[i - 1].Samples;
+            if (fade > entries[i].Samples)
+                fade = entries[i].Samples;
+            entries[i].Join = -fade;
+        }
+    }
+
+    PlayerStop(voice);
+    for (i = 0; i < count; i++) {
+        if (!PlayerQueueEntry(voice, &entries[i]))
+            return false;
+    }
+    return true;
+}
+
+
+// Ask the decode loop to start a phrase.  Safe to call from other tasks.
+bool PhraseRequest (int voice, const phraseFragment_t * fragments, size_t count) {
+    if (count == 0 || count > PHRASE_MAX_FRAGMENTS || requestedVoice >= 0)
+        return false;
+    memcpy(requestedFragments, fragments, count * sizeof(phraseFragment_t));
+    requestedCount = count;
+    requestedVoice = voice;
+    PlayerWake();
+    return true;
+}
+
+
+// Start any requested phrase.  Called by the decode loop.
+void PhraseService (void) {
+    int voice = requestedVoice;
+    if (voice >= 0) {
+        if (!PhraseStart(voice, requestedFragments, requestedCount))
+            printf("Couldn't start the phrase.\r\n");
+        requestedVoice = -1;
+    }
+}
@@ -0,0 +1,37 @@
+// Phrase Header File
+// Builds one continuous utterance out of short clips: "Temperature is" + "twenty" + "three" + "degrees".
+// Give it a list of clip IDs, each with the join to the clip before it (some silence, or a
+// crossfade), and it plays them back to back on one player voice.  Every fragment's headers and
+// length are read when the phrase is started, so the joins themselves are only a seek and a copy.
+// Clips are looked up by ID in a library table the application registers with PhraseSetLibrary, then
+// in the asset bundle from PhraseSetBundle, whose directory has their headers parsed already.
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "asset_bundle.h"
+
+#ifndef PHRASE_H
+#define PHRASE_H
+
+#define PHRASE_MAX_FRAGMENTS 16
+
+typedef struct {
+    uint32_t Id;
+    const void * Data;
+    size_t Length;
+} phraseClip_t;
+
+typedef struct {
+    uint32_t Id;
+    int16_t JoinMs;     // Before this fragment: silence if positive, crossfade if negative.  Ignored on the first.
+} phraseFragment_t;
+
+void PhraseSetLibrary (const phraseClip_t * clips, size_t count);
+void PhraseSetBundle (const assetBundle_t * bundle);
+const phraseClip_t * PhraseFindClip (uint32_t id);
+bool PhraseStart (int voice, const phraseFragment_t * fragments, size_t count);
+bool PhraseRequest (int voice, const phraseFragment_t * fragments, size_t count);
+void PhraseService (void);
+
+#endif
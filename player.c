@@ -0,0 +1,622 @@
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdlib.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "audio_out.h"
+#include "decode_stats.h"
+#include "decoder_pool.h"
+#include "hot_profile.h"
+#include "ogg_data.h"
+#include "opus_scratch.h"
+#include "pcm_cache.h"
+#include "player.h"
+
+static playerVoice_t playerVoices[MIXER_VOICES];
+static int lastMode = DECODE_MODE_SILK;
+static TaskHandle_t decodeTask = NULL;
+static uint32_t dtxCount = 0;
+static uint32_t rejectCount = 0;
+static uint32_t lateCount = 0;
+// Where Refill copies Ogg packets out of their pages.  Only the decode task refills, and a whole
+// packet is too much to put on its stack.
+static uint8_t packetBuffer[PLAYER_PACKET_LEN];
+
+// Set from the console, applied by the decode loop.
+static volatile int requestedVoice = -1;
+static volatile uint32_t requestedId = PCM_CACHE_NO_ID;
+static volatile int16_t requestedGain = MIXER_GAIN_UNITY;
+static volatile bool requestedQueue = false;
+
+
+// Decode one packet into pcm with the scratch arena claimed, and record how long it took.
+// A NULL packet asks Opus for concealment (PLC) of maxSamples.  A packet that won't decode is
+// concealed too, so a corrupt packet costs one frame of PLC rather than a gap.  Concealment is
+// timed apart from real decodes.
+static int DecodePacket (OpusDecoder * decoder, int mode, const uint8_t * packet, int32_t length,
+                         int16_t * pcm, int maxSamples) {
+    uint32_t decodeStart = time_us_32();
+    int samples = -1;
+
+    OpusScratchAcquire();
+    HotProfileGate(true);
+    if (packet != NULL) {
+        samples = opus_decode(decoder, packet, length, pcm, maxSamples, 0);
+        DecodeStatsRecordDecode(mode, time_us_32() - decodeStart);
+        if (samples < 0) {
+            int lost = opus_packet_get_nb_samples(packet, length, PLAYER_SAMPLE_RATE);
+            maxSamples = lost > 0 && lost <= maxSamples ? lost : PLAYER_SAMPLE_RATE / 50;
+            AudioOutCountConcealment();
+        }
+    }
+    if (samples < 0) {
+        decodeStart = time_us_32();
+        samples = opus_decode(decoder, NULL, 0, pcm, maxSamples, 0);
+        DecodeStatsRecordConceal(time_us_32() - decodeStart);
+    }
+    HotProfileGate(false);
+    OpusScratchRelease();
+
+    if (!OpusScratchCheck())
+        panic("Opus scratch arena overflowed.  Increase OPUS_SCRATCH_SIZE.\n");
+    return samples < 0 ? 0 : samples;
+}
+
+
+// Whether this build can decode the packet.  The SILK-only build has no CELT decoder, no stereo and a
+// shorter carry buffer, so it takes mono SILK packets of up to PLAYER_FRAME_MAX.
+static bool PacketSupported (const uint8_t * packet, int length) {
+#ifdef OPUS_SILK_ONLY
+    return DecodeStatsMode(packet) == DECODE_MODE_SILK && !(packet[0] & 0x04) &&
+           opus_packet_get_nb_samples(packet, length, PLAYER_SAMPLE_RATE) <= PLAYER_FRAME_MAX;
+#else
+    (void)packet;
+    (void)length;
+    return true;
+#endif
+}
+
+
+// How long a packet plays for at PLAYER_SAMPLE_RATE, to conceal it in its place.
+static int PacketSamples (const uint8_t * packet, int length) {
+    int samples = opus_packet_get_nb_samples(packet, length, PLAYER_SAMPLE_RATE);
+    return samples > 0 && samples <= PLAYER_FRAME_MAX ? samples : PLAYER_FRAME_MAX;
+}
+
+
+// Refill a clip's carry buffer from its next packet.  Returns false at the end of the clip.  With
+// late set, the packet has missed its deadline: it's read but not decoded, and concealment covers
+// the time it would have played, so everything after it still plays when it should.
+static bool Refill (playerClip_t * c, bool late) {
+    const uint8_t *packet = packetBuffer;
+    int length, concealSamples = 0;
+
+    c->PcmPos = 0;
+    c->PcmLen = 0;
+    if (c->Remaining == 0)
+        return false;
+
+    // Compact streams are decoded in place; Ogg packets are copied out of their pages.
+    if (c->Compact.Data != NULL)
+        length = CompactReaderNextPacket(&c->Compact, &packet);
+    else
+        length = OggReaderGetNextPacket(&c->Reader, packetBuffer, sizeof(packetBuffer));
+    if (length < 0)
+        return false;
+
+    if (length == 0) {
+        // An empty packet stands for a lost one.  Conceal it for as long as the one before.
+        opus_int32 last = 0;
+        opus_decoder_ctl(c->Decoder, OPUS_GET_LAST_PACKET_DURATION(&last));
+        concealSamples = last > 0 && last <= PLAYER_FRAME_MAX ? (int)last : PLAYER_SAMPLE_RATE / 50;
+    } else if (!PacketSupported(packet, length)) {
+        // Never let Opus see it.  Cover the time it would have played with concealment.
+        concealSamples = PacketSamples(packet, length);
+        rejectCount++;
+    } else if (late) {
+        concealSamples = PacketSamples(packet, length);
+        lateCount++;
+    }
+
+    if (concealSamples) {
+        c->PcmLen = DecodePacket(c->Decoder, c->Mode, NULL, 0, c->Pcm, concealSamples);
+        AudioOutCountConcealment();
+        // Concealment isn't what the clip sounds like, so don't cache this play of it.
+        if (c->Fill != NULL) {
+            c->Fill = NULL;
+            c->Pinned = false;
+            PcmCacheRelease(c->Id);
+        }
+    } else {
+        c->Mode = DecodeStatsMode(packet);
+        lastMode = c->Mode;
+        c->PcmLen = DecodePacket(c->Decoder, c->Mode, packet, length, c->Pcm, PLAYER_FRAME_MAX);
+
+        // A DTX packet is just the TOC byte.  The decoder still has to see it, but what it makes
+        // is comfort noise; play true silence instead so the output can spot it and park.
+        if (length <= PLAYER_DTX_LEN) {
+            memset(c->Pcm, 0, c->PcmLen * sizeof(int16_t));
+            dtxCount++;
+        }
+    }
+
+    // Trim the pre-skip off the front and anything past the last granule off the end.
+    if (c->Skip) {
+        c->PcmPos = c->Skip < (uint32_t)c->PcmLen ? (int)c->Skip : c->PcmLen;
+        c->Skip -= c->PcmPos;
+    }
+    if (c->Remaining > 0) {
+        if (c->PcmLen - c->PcmPos > c->Remaining)
+            c->PcmLen = c->PcmPos + c->Remaining;
+        c->Remaining -= c->PcmLen - c->PcmPos;
+    }
+    return true;
+}
+
+
+// The clip is over, or being replaced.  Hand back the cache entry, keeping it if it was filled in full.
+static void EndClip (playerClip_t * c) {
+    if (c->Fill != NULL && c->CachePos == c->CacheLen)
+        PcmCacheCommit(c->Id);
+    if (c->Pinned)
+        PcmCacheRelease(c->Id);
+    if (c->Decoder != NULL)
+        DecoderPoolRelease(c->Decoder);
+#ifdef OGG_STRIP_FLASH_DMA
+    FlashStreamClose(&c->Stream);
+#endif
+    c->Decoder = NULL;
+    c->Pinned = false;
+    c->Fill = NULL;
+    c->Cached = NULL;
+    c->Remaining = 0;
+    c->PcmPos = c->PcmLen = 0;
+}
+
+
+// Read a clip's headers ahead of time, so opening it later is just a seek.  Fills in Samples,
+// PreSkip and AudioOffset.  Samples stays -1 if the clip's length can't be found.
+bool PlayerPreParse (playerQueued_t * entry) {
+    oggReader_t reader;
+    compactReader_t compact;
+    int64_t granule;
+
+    entry->Samples = -1;
+    if (CompactIsStream(entry->Clip, entry->Length)) {
+        if (!CompactReaderOpen(&compact, entry->Clip, entry->Length))
+            return false;
+        if (compact.Header.Samples) {
+            entry->Samples = (int32_t)((uint64_t)compact.Header.Samples * PLAYER_SAMPLE_RATE / 48000);
+            entry->PreSkip = compact.Header.PreSkip;
+            entry->AudioOffset = (long)compact.Header.DataOffset;
+        }
+        return true;
+    }
+
+    OggReaderSetSource(&reader, entry->Clip, entry->Length);
+    if (!OggReaderPrepareFile(&reader))
+        return false;
+
+    // Pre-skip and granule positions are always counted at 48kHz.
+    granule = OggReaderLastGranule(&reader);
+    if (granule > reader.IDHeader.PreSkip) {
+        entry->Samples = (int32_t)((granule - reader.IDHeader.PreSkip) * PLAYER_SAMPLE_RATE / 48000);
+        entry->PreSkip = reader.IDHeader.PreSkip;
+        entry->AudioOffset = OggReaderTell(&reader);
+    }
+    return true;
+}
+
+
+// Open a clip in a slot: from the PCM cache if it's there, otherwise parse the Ogg headers (unless
+// PlayerPreParse already has), find the trims and borrow a decoder from the pool.
+static bool OpenClip (playerClip_t * c, const playerQueued_t * entry) {
+    playerQueued_t parsed;
+
+    EndClip(c);
+    c->Id = entry->Id;
+    c->Join = entry->Join;
+    c->CachePos = 0;
+    c->Compact.Data = NULL;
+
+    c->Cached = PcmCacheLookup(entry->Id, &c->CacheLen);
+    if (c->Cached != NULL) {
+        c->Pinned = true;
+        return true;
+    }
+
+    if (CompactIsStream(entry->Clip, entry->Length)) {
+        // A compact stream's header has everything in it already.
+        if (!CompactReaderOpen(&c->Compact, entry->Clip, entry->Length))
+            return false;
+        c->Skip = (uint32_t)c->Compact.Header.PreSkip * PLAYER_SAMPLE_RATE / 48000;
+        c->Remaining = c->Compact.Header.Samples ?
+                       (int32_t)((uint64_t)c->Compact.Header.Samples * PLAYER_SAMPLE_RATE / 48000) : -1;
+    } else {
+        if (entry->Samples < 0) {
+            parsed = *entry;
+            if (!PlayerPreParse(&parsed))
+                return false;
+            entry = &parsed;
+        }
+
+        OggReaderSetSource(&c->Reader, entry->Clip, entry->Length);
+#ifdef OGG_STRIP_FLASH_DMA
+        OggReaderSetStream(&c->Reader, &c->Stream);
+#endif
+        if (entry->Samples >= 0) {
+            OggReaderSeek(&c->Reader, entry->AudioOffset);
+            c->Skip = (uint32_t)entry->PreSkip * PLAYER_SAMPLE_RATE / 48000;
+            c->Remaining = entry->Samples;
+        } else {
+            // No end granule, so play until the packets run out, and take the pre-skip from the header.
+            if (!OggReaderPrepareFile(&c->Reader))
+                return false;
+            c->Skip = (uint32_t)c->Reader.IDHeader.PreSkip * PLAYER_SAMPLE_RATE / 48000;
+            c->Remaining = -1;
+        }
+    }
+
+    c->Decoder = DecoderPoolAcquire(PLAYER_SAMPLE_RATE, 1);
+    if (c->Decoder == NULL)
+        return false;
+
+    if (c->Remaining > 0) {
+        c->CacheLen = (uint32_t)c->Remaining;
+        c->Fill = PcmCacheReserve(entry->Id, c->CacheLen);
+        c->Pinned = c->Fill != NULL;
+    }
+    return true;
+}
+
+
+// Samples a clip has left to play, or -1 if it doesn't know.
+static int32_t ClipLeft (const playerClip_t * c) {
+    if (c->Cached != NULL)
+        return (int32_t)(c->CacheLen - c->CachePos);
+    if (c->Remaining < 0)
+        return -1;
+    return c->Remaining + (c->PcmLen - c->PcmPos);
+}
+
+
+// Copy up to samples from a clip, decoding as needed.  Returns fewer than asked at the end of the clip.
+// If late is set, the first packet it needs is concealed instead (see Refill), and late is cleared.
+static int ReadClip (playerClip_t * c, int16_t * destination, int samples, bool * late) {
+    int written = 0, count;
+
+    // Cached clips are just a copy.
+    if (c->Cached != NULL) {
+        count = (int)(c->CacheLen - c->CachePos);
+        if (count > samples)
+            count = samples;
+        memcpy(destination, c->Cached + c->CachePos, count * sizeof(int16_t));
+        c->CachePos += count;
+        return count;
+    }
+
+    while (written < samples) {
+        if (c->PcmPos >= c->PcmLen) {
+            if (!Refill(c, *late))
+                break;
+            *late = false;
+        }
+        count = c->PcmLen - c->PcmPos;
+        if (count > samples - written)
+            count = samples - written;
+        memcpy(destination + written, c->Pcm + c->PcmPos, count * sizeof(int16_t));
+        if (c->Fill != NULL && c->CachePos + count <= c->CacheLen) {
+            memcpy(c->Fill + c->CachePos, c->Pcm + c->PcmPos, count * sizeof(int16_t));
+            c->CachePos += count;
+        }
+        c->PcmPos += count;
+        written += count;
+    }
+    return written;
+}
+
+
+// Move on to the pre-rolled clip.  Returns false if there isn't one.
+static bool Splice (playerVoice_t * v) {
+    EndClip(v->Current);
+    if (v->Next == NULL)
+        return false;
+    v->Current = v->Next;
+    v->Next = NULL;
+    v->Silence = v->Current->Join > 0 ? (uint32_t)v->Current->Join : 0;
+    return true;
+}
+
+
+// Play up to samples of the crossfade from Current into Next, a chunk at a time.  Returns how many
+// were written.  Both clips are known to have at least Fade samples left.
+static int Crossfade (playerVoice_t * v, int16_t * destination, int samples) {
+    int16_t incoming[PLAYER_FADE_CHUNK];
+    bool late = false;
+    int i, count, in;
+    int32_t weight;
+
+    count = samples < PLAYER_FADE_CHUNK ? samples : PLAYER_FADE_CHUNK;
+    if ((uint32_t)count > v->Fade)
+        count = (int)v->Fade;
+
+    i = ReadClip(v->Current, destination, count, &v->Late);
+    memset(destination + i, 0, (count - i) * sizeof(int16_t));
+    in = ReadClip(v->Next, incoming, count, &late);
+    memset(incoming + in, 0, (count - in) * sizeof(int16_t));
+
+    // Linear, equal-gain.  weight is how far into the fade we are, in Q15.
+    for (i = 0; i < count; i++) {
+        weight = (int32_t)(((uint64_t)(v->FadeLen - v->Fade + i) << 15) / v->FadeLen);
+        destination[i] = (int16_t)(((int32_t)destination[i] * (32768 - weight) + (int32_t)incoming[i] * weight) >> 15);
+    }
+
+    v->Fade -= count;
+    if (!v->Fade)
+        Splice(v);
+    return count;
+}
+
+
+// The mixer source for a voice.  When the current clip runs out part way through the block, the
+// pre-rolled one is swapped in and carries on from the next sample, after any silence it asked for.
+// If it asked for a crossfade instead, it starts that many samples before the current one ends.
+static int VoiceRender (void * context, int16_t * destination, int samples) {
+    playerVoice_t *v = (playerVoice_t *)context;
+    int written = 0, want, count;
+    int32_t left, fade;
+
+    while (written < samples) {
+        want = samples - written;
+
+        if (v->Silence) {
+            count = (uint32_t)want < v->Silence ? want : (int)v->Silence;
+            memset(destination + written, 0, count * sizeof(int16_t));
+            v->Silence -= count;
+            written += count;
+            continue;
+        }
+
+        if (v->Fade) {
+            written += Crossfade(v, destination + written, want);
+            continue;
+        }
+
+        // Stop short where a crossfade into the next clip has to begin.
+        if (v->Next != NULL && v->Next->Join < 0 && (left = ClipLeft(v->Current)) >= 0) {
+            fade = -v->Next->Join;
+            if (fade > left)
+                fade = left;
+            if (fade > 0 && left - fade < want) {
+                want = left - fade;
+                if (!want) {
+                    v->Fade = v->FadeLen = (uint32_t)fade;
+                    continue;
+                }
+            }
+        }
+
+        count = ReadClip(v->Current, destination + written, want, &v->Late);
+        written += count;
+        if (count < want && !Splice(v))
+            break;
+    }
+    return written;
+}
+
+
+// Set up the player.  Call this from the task that will run PlayerService and PlayerRender; it's
+// the one PlayerWake wakes.
+void PlayerInit (void) {
+    int voice;
+
+    decodeTask = xTaskGetCurrentTaskHandle();
+    DecoderPoolInit();
+    for (voice = 0; voice < MIXER_VOICES; voice++) {
+        playerVoices[voice].Current = &playerVoices[voice].Clips[0];
+        playerVoices[voice].Gain = MIXER_GAIN_UNITY;
+#ifdef OGG_STRIP_FLASH_DMA
+        FlashStreamInit(&playerVoices[voice].Clips[0].Stream);
+        FlashStreamInit(&playerVoices[voice].Clips[1].Stream);
+#endif
+    }
+}
+
+
+// Throw away the pre-rolled clip and the queue.
+static void ClearQueue (playerVoice_t * v) {
+    if (v->Next != NULL)
+        EndClip(v->Next);
+    v->Next = NULL;
+    v->QueueCount = 0;
+    v->Silence = 0;
+    v->Fade = 0;
+}
+
+
+// Start a clip on a voice, replacing whatever it was playing and anything queued.  startOffset is
+// in samples from the start of the next rendered block.  If the clip's ID is in the PCM cache, it
+// plays from there without touching the Ogg data; otherwise it's decoded, and cached on the way if
+// it's short enough.
+bool PlayerStart (int voice, uint32_t id, const void * clip, size_t length, int16_t gain, uint32_t startOffset) {
+    playerVoice_t *v = &playerVoices[voice];
+    playerQueued_t entry = { id, clip, length, 0, -1, 0, 0 };
+
+    MixerStop(voice);
+    ClearQueue(v);
+    v->Late = false;
+    v->Gain = gain;
+    if (!OpenClip(v->Current, &entry))
+        return false;
+    MixerStart(voice, VoiceRender, v, gain, startOffset);
+    return true;
+}
+
+
+// Add a clip to a voice's queue, to follow on gaplessly from what's playing.  An idle voice just
+// starts it.  Returns false if the queue is full.
+bool PlayerQueue (int voice, uint32_t id, const void * clip, size_t length) {
+    playerQueued_t entry = { id, clip, length, 0, -1, 0, 0 };
+    return PlayerQueueEntry(voice, &entry);
+}
+
+
+// As PlayerQueue, with a join and maybe pre-parsed headers (see PlayerPreParse).  On an idle voice
+// the clip starts straight away and the join is ignored.
+bool PlayerQueueEntry (int voice, const playerQueued_t * entry) {
+    playerVoice_t *v = &playerVoices[voice];
+
+    if (!MixerVoiceActive(voice)) {
+        MixerStop(voice);
+        ClearQueue(v);
+        v->Late = false;
+        if (!OpenClip(v->Current, entry))
+            return false;
+        MixerStart(voice, VoiceRender, v, v->Gain, 0);
+        return true;
+    }
+    if (v->QueueCount >= PLAYER_QUEUE_LEN)
+        return false;
+
+    v->Queue[(v->QueueHead + v->QueueCount++) % PLAYER_QUEUE_LEN] = *entry;
+    return true;
+}
+
+
+void PlayerStop (int voice) {
+    MixerStop(voice);
+    ClearQueue(&playerVoices[voice]);
+    EndClip(playerVoices[voice].Current);
+}
+
+
+// Set a voice's gain, for what's playing and for clips it starts later from its queue.
+void PlayerSetGain (int voice, int16_t gain) {
+    playerVoices[voice].Gain = gain;
+    MixerSetGain(voice, gain);
+}
+
+
+// Ask the decode loop to play the built-in sample on a voice, now or queued behind what's
+// playing.  The ID is for the PCM cache.  Safe to call from other tasks.
+bool PlayerRequest (int voice, uint32_t id, int16_t gain, bool queue) {
+    if (voice < 0 || voice >= MIXER_VOICES)
+        return false;
+    requestedGain = gain;
+    requestedId = id;
+    requestedQueue = queue;
+    requestedVoice = voice;
+    PlayerWake();
+    return true;
+}
+
+
+// Wake the decode loop if it's idle, to pick up a request.
+void PlayerWake (void) {
+    if (decodeTask != NULL)
+        xTaskNotifyGive(decodeTask);
+}
+
+
+// Pre-roll the head of a voice's queue into the spare slot: open it and decode its first packet,
+// so the splice itself is only a copy.
+static void PreRoll (playerVoice_t * v) {
+    playerQueued_t *entry;
+    playerClip_t *spare;
+
+    if (v->Next != NULL || v->QueueCount == 0)
+        return;
+
+    // A cached clip plays without a decoder.  Otherwise, with a small decoder pool, wait for another
+    // clip to finish rather than drop this one.
+    entry = &v->Queue[v->QueueHead];
+    if (!PcmCacheHas(entry->Id) && !DecoderPoolFree())
+        return;
+
+    v->QueueHead = (v->QueueHead + 1) % PLAYER_QUEUE_LEN;
+    v->QueueCount--;
+
+    spare = v->Current == &v->Clips[0] ? &v->Clips[1] : &v->Clips[0];
+    if (!OpenClip(spare, entry)) {
+        printf("Couldn't open queued clip %u.\r\n", (unsigned)entry->Id);
+        return;
+    }
+    if (spare->Cached == NULL && !Refill(spare, false)) {
+        EndClip(spare);
+        return;
+    }
+    v->Next = spare;
+}
+
+
+// Apply any request made with PlayerRequest, and pre-roll queued clips.  Called by the decode loop
+// between blocks, so none of this lands in the middle of a splice.
+void PlayerService (void) {
+    int voice = requestedVoice;
+    bool ok;
+
+    if (voice >= 0) {
+        requestedVoice = -1;
+        if (requestedQueue)
+            ok = PlayerQueue(voice, requestedId, Sample, SAMPLE_LENGTH);
+        else
+            ok = PlayerStart(voice, requestedId, Sample, SAMPLE_LENGTH, requestedGain, 0);
+        if (!ok)
+            printf("Couldn't start the sample on voice %d.\r\n", voice);
+    }
+
+    // A voice that ran out with clips still queued (its pre-roll failed) picks up from the queue.
+    for (voice = 0; voice < MIXER_VOICES; voice++) {
+        playerVoice_t *v = &playerVoices[voice];
+        if (!MixerVoiceActive(voice) && v->QueueCount) {
+            PreRoll(v);
+            if (Splice(v))
+                MixerStart(voice, VoiceRender, v, v->Gain, 0);
+        }
+        if (MixerVoiceActive(voice))
+            PreRoll(v);
+    }
+}
+
+
+// Render a block from all playing voices.  With late set, the block is already behind its
+// deadline, so the packet each voice would decode next is concealed in its place (see Refill).
+// PLC is cheaper than decoding, which lets the output catch up.
+int PlayerRender (int16_t * destination, int samples, bool late) {
+    int voice;
+    for (voice = 0; voice < MIXER_VOICES; voice++)
+        playerVoices[voice].Late = late;
+    samples = MixerRender(destination, samples);
+    for (voice = 0; voice < MIXER_VOICES; voice++)
+        playerVoices[voice].Late = false;
+    return samples;
+}
+
+
+bool PlayerIsIdle (void) {
+    return MixerIsIdle();
+}
+
+
+int PlayerLastMode (void) {
+    return lastMode;
+}
+
+
+// Packets dropped because this build can't decode them (see PacketSupported).
+uint32_t PlayerRejectCount (void) {
+    return rejectCount;
+}
+
+
+// Packets concealed instead of decoded because they were late.
+uint32_t PlayerLateCount (void) {
+    return lateCount;
+}
+
+
+uint32_t PlayerDtxCount (void) {
+    return dtxCount;
+}
@@ -0,0 +1,102 @@
+// Player Header File
+// Plays Ogg Opus clips, or compact streams (compact_stream.h), on the mixer's voices.  Each voice has
+// its own Ogg readers, and borrows Opus decoders from decoder_pool.h, so a chime can start over a
+// sentence without disturbing it.  Decoded packets are carried over between blocks, so the mixer can
+// ask for any block size regardless of the packet durations.
+// The encoder's pre-skip is dropped from the front of each clip and the end is trimmed to the last
+// granule position, so a clip plays exactly the samples that were encoded.  Short clips with an ID
+// go through the PCM cache (pcm_cache.h): the first play fills it, later plays just copy.
+//
+// Each voice also has a play queue.  While one clip plays, the next is opened, parsed and its
+// first packet decoded in a second slot (pre-roll), so when the first ends the next carries on from
+// the very next sample, in the same block.  A queued clip can also ask for silence before it, or to
+// crossfade in over the end of the one before; the two slots play together for the crossfade.
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "compact_stream.h"
+#include "mixer.h"
+#include "ogg_stripper.h"
+#include "opus.h"
+
+#ifndef PLAYER_H
+#define PLAYER_H
+
+#define PLAYER_SAMPLE_RATE 16000
+#ifdef OPUS_SILK_ONLY
+#define PLAYER_FRAME_MAX 960                            // Longest packet the SILK-only build takes (60ms).
+#else
+#define PLAYER_FRAME_MAX 1920                           // Longest Opus packet (120ms) at PLAYER_SAMPLE_RATE.
+#endif
+#define PLAYER_BLOCK_SAMPLES (PLAYER_SAMPLE_RATE / 50)  // 20ms per rendered block.
+#define PLAYER_PACKET_LEN 1275                          // Longest Opus frame; longer Ogg packets are concealed.
+#define PLAYER_QUEUE_LEN 16                             // Clips waiting behind the pre-rolled one, per voice.
+#define PLAYER_FADE_CHUNK 64                            // Samples per step of a crossfade.
+#define PLAYER_DTX_LEN 2                                // Packets this short are DTX, and played as silence.
+
+// One clip being played or pre-rolled.
+typedef struct {
+    oggReader_t Reader;
+    compactReader_t Compact;       // Read instead of Reader if the clip is a compact stream.
+#ifdef OGG_STRIP_FLASH_DMA
+    flashStream_t Stream;          // The Reader's read-ahead.
+#endif
+    OpusDecoder * Decoder;         // Borrowed from the decoder pool while the clip is open.
+    int16_t Pcm[PLAYER_FRAME_MAX]; // Decoded but not yet rendered.
+    int PcmPos;
+    int PcmLen;
+    int Mode;                      // DECODE_MODE_* of the last packet.
+    uint32_t Skip;                 // Pre-skip still to drop from the front.
+    int32_t Remaining;             // Samples left before the end trim, or -1 if the length isn't known.
+    uint32_t Id;                   // Clip ID for the PCM cache, or PCM_CACHE_NO_ID.
+    bool Pinned;                   // Holding a PCM cache entry for Id.
+    const int16_t * Cached;        // Playing from the cache.
+    int16_t * Fill;                // Filling the cache as we decode.
+    uint32_t CacheLen;
+    uint32_t CachePos;
+    int32_t Join;                  // From playerQueued_t.
+} playerClip_t;
+
+typedef struct {
+    uint32_t Id;
+    const void * Clip;
+    size_t Length;
+    int32_t Join;                  // Samples of silence before the clip, or if negative, of crossfade into it.
+    int32_t Samples;               // Trimmed length if the headers have been read already, otherwise -1.
+    uint16_t PreSkip;              // These two are only used if Samples is set.
+    long AudioOffset;              // Where the first audio page starts.
+} playerQueued_t;
+
+typedef struct {
+    playerClip_t Clips[2];
+    playerClip_t * Current;
+    playerClip_t * Next;           // Pre-rolled and ready to splice on, or NULL.
+    playerQueued_t Queue[PLAYER_QUEUE_LEN];
+    uint8_t QueueHead;
+    uint8_t QueueCount;
+    bool Late;                     // Conceal the next packet instead of decoding it.
+    int16_t Gain;                  // Q15.  Kept here so a clip started from the queue plays at it too.
+    uint32_t Silence;              // Samples of silence still to play before Current.
+    uint32_t Fade;                 // Samples of crossfade from Current to Next still to play.
+    uint32_t FadeLen;
+} playerVoice_t;
+
+void PlayerInit (void);
+bool PlayerStart (int voice, uint32_t id, const void * clip, size_t length, int16_t gain, uint32_t startOffset);
+bool PlayerQueue (int voice, uint32_t id, const void * clip, size_t length);
+bool PlayerQueueEntry (int voice, const playerQueued_t * entry);
+bool PlayerPreParse (playerQueued_t * entry);
+void PlayerStop (int voice);
+void PlayerSetGain (int voice, int16_t gain);
+bool PlayerRequest (int voice, uint32_t id, int16_t gain, bool queue);
+void PlayerWake (void);
+void PlayerService (void);
+int PlayerRender (int16_t * destination, int samples, bool late);
+bool PlayerIsIdle (void);
+int PlayerLastMode (void);
+uint32_t PlayerDtxCount (void);
+uint32_t PlayerRejectCount (void);
+uint32_t PlayerLateCount (void);
+
+#endif
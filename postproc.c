@@ -0,0 +1,200 @@
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#include "settings.h"
+#include "postproc.h"
+
+static const postProcBand_t bands[] = POSTPROC_EQ;
+#define BAND_COUNT (sizeof(bands) / sizeof(bands[0]))
+#define PI 3.14159265358979f
+
+static postProcBiquad_t biquads[POSTPROC_MAX_BIQUADS];
+static int biquadCount = 0;
+static uint32_t rate = 16000;
+static bool enabled = POSTPROC;
+
+static int32_t gain = 1 << POSTPROC_GAIN_SHIFT;     // Current volume, 1.0 = unity.
+static int32_t gainTarget = 1 << POSTPROC_GAIN_SHIFT;
+static int32_t gainStep = 0;
+static uint32_t gainRampSamples = 0;
+
+static int32_t limitEnvelope = 0;                   // Peak follower, instant attack, exponential release.
+static int32_t limitRelease;                        // Q15 decay per sample.
+static int32_t limitMinGain = 32768;                // Deepest gain reduction since the last print, Q15.
+
+// Set from the console, applied at the start of the next block.
+static volatile bool gainRequested = false;
+static volatile int16_t requestedGain;
+static volatile uint32_t requestedRampMs;
+
+
+static inline int16_t Saturate (int32_t value) {
+    if (value > INT16_MAX)
+        return INT16_MAX;
+    if (value < INT16_MIN)
+        return INT16_MIN;
+    return (int16_t)value;
+}
+
+
+static inline int16_t ToCoef (float value) {
+    return Saturate((int32_t)lrintf(value * (1 << POSTPROC_COEF_SHIFT)));
+}
+
+
+// Work out a band's coefficients.  These are the RBJ Audio EQ Cookbook formulas; float is fine
+// here since it only runs at start-up.
+static void DesignBand (postProcBiquad_t * biquad, const postProcBand_t * band) {
+    float w0 = 2.0f * PI * band->Frequency / (float)rate;
+    float cw = cosf(w0), alpha = sinf(w0) / (2.0f * band->Q);
+    float a = powf(10.0f, band->GainDb / 40.0f), sa = 2.0f * sqrtf(a) * alpha;
+    float b0, b1, b2, a0, a1, a2;
+
+    switch (band->Type) {
+    case POSTPROC_HIGHPASS:
+        b0 = (1 + cw) / 2; b1 = -(1 + cw); b2 = (1 + cw) / 2;
+        a0 = 1 + alpha; a1 = -2 * cw; a2 = 1 - alpha;
+        break;
+    case POSTPROC_LOWPASS:
+        b0 = (1 - cw) / 2; b1 = 1 - cw; b2 = (1 - cw) / 2;
+        a0 = 1 + alpha; a1 = -2 * cw; a2 = 1 - alpha;
+        break;
+    case POSTPROC_PEAK:
+        b0 = 1 + alpha * a; b1 = -2 * cw; b2 = 1 - alpha * a;
+        a0 = 1 + alpha / a; a1 = -2 * cw; a2 = 1 - alpha / a;
+        break;
+    case POSTPROC_LOWSHELF:
+        b0 = a * ((a + 1) - (a - 1) * cw + sa); b1 = 2 * a * ((a - 1) - (a + 1) * cw); b2 = a * ((a + 1) - (a - 1) * cw - sa);
+        a0 = (a + 1) + (a - 1) * cw + sa; a1 = -2 * ((a - 1) + (a + 1) * cw); a2 = (a + 1) + (a - 1) * cw - sa;
+        break;
+    case POSTPROC_HIGHSHELF:
+    default:
+        b0 = a * ((a + 1) + (a - 1) * cw + sa); b1 = -2 * a * ((a - 1) + (a + 1) * cw); b2 = a * ((a + 1) + (a - 1) * cw - sa);
+        a0 = (a + 1) - (a - 1) * cw + sa; a1 = 2 * ((a - 1) - (a + 1) * cw); a2 = (a + 1) - (a - 1) * cw - sa;
+        break;
+    }
+
+    biquad->B0 = ToCoef(b0 / a0);
+    biquad->B1 = ToCoef(b1 / a0);
+    biquad->B2 = ToCoef(b2 / a0);
+    biquad->A1 = ToCoef(-a1 / a0);
+    biquad->A2 = ToCoef(-a2 / a0);
+}
+
+
+// Set the chain up for a sample rate, from silence.  Bands above Nyquist are dropped.
+void PostProcInit (uint32_t sampleRate) {
+    uint32_t i;
+
+    rate = sampleRate;
+    biquadCount = 0;
+    memset(biquads, 0, sizeof(biquads));
+    limitEnvelope = 0;
+    for (i = 0; i < BAND_COUNT && biquadCount < POSTPROC_MAX_BIQUADS; i++) {
+        if (bands[i].Frequency < rate / 2)
+            DesignBand(&biquads[biquadCount++], &bands[i]);
+    }
+
+    limitRelease = (int32_t)lrintf(expf(-1000.0f / (POSTPROC_LIMIT_RELEASE_MS * (float)rate)) * 32768.0f);
+}
+
+
+// Ramp the volume to a Q15 gain over rampMs.  Safe to call from other tasks.
+void PostProcSetGain (int16_t newGain, uint32_t rampMs) {
+    requestedGain = newGain;
+    requestedRampMs = rampMs;
+    gainRequested = true;
+}
+
+
+void PostProcEnable (bool enable) {
+    enabled = enable;
+}
+
+
+bool PostProcIsEnabled (void) {
+    return enabled;
+}
+
+
+static void ApplyGainRequest (void) {
+    if (gainRequested) {
+        gainRequested = false;
+        gainTarget = (int32_t)requestedGain << (POSTPROC_GAIN_SHIFT - 15);
+        gainRampSamples = (uint32_t)((uint64_t)requestedRampMs * rate / 1000);
+        if (gainRampSamples == 0)
+            gainRampSamples = 1;
+        gainStep = (gainTarget - gain) / (int32_t)gainRampSamples;
+    }
+}
+
+
+// Run a block through the chain, in place.
+void PostProcProcess (int16_t * samples, int count) {
+    postProcBiquad_t *bq;
+    int32_t x, level, limitGain;
+    int64_t acc;
+    int i, b;
+
+    if (!enabled)
+        return;
+    ApplyGainRequest();
+
+    for (i = 0; i < count; i++) {
+        x = samples[i];
+
+        // EQ.  Direct form I, feeding each section's rounding error into its next sample.  Each
+        // product fits 32 bits, but five of them with coefficients near +-4 don't, so they're summed
+        // in 64 (which on the M0+ only costs an add with carry each).
+        for (b = 0; b < biquadCount; b++) {
+            bq = &biquads[b];
+            acc = (int64_t)bq->Error + (int32_t)bq->B0 * x + (int32_t)bq->B1 * bq->X1 + (int32_t)bq->B2 * bq->X2
+                  + (int32_t)bq->A1 * bq->Y1 + (int32_t)bq->A2 * bq->Y2;
+            bq->Error = (int32_t)(acc & ((1 << POSTPROC_COEF_SHIFT) - 1));
+            bq->X2 = bq->X1;
+            bq->X1 = (int16_t)x;
+            bq->Y2 = bq->Y1;
+            bq->Y1 = Saturate((int32_t)(acc >> POSTPROC_COEF_SHIFT));
+            x = bq->Y1;
+        }
+
+        // Volume, stepping towards the target a little every sample.
+        if (gainRampSamples) {
+            gain += gainStep;
+            if (--gainRampSamples == 0)
+                gain = gainTarget;
+        }
+        x = (x * (gain >> (POSTPROC_GAIN_SHIFT - 15))) >> 15;
+
+        // Limiter.  The envelope jumps straight to any new peak, so the sample that sets it is
+        // already brought down to the threshold; there's nothing to look ahead for.
+        level = x < 0 ? -x : x;
+        limitEnvelope = (limitEnvelope * limitRelease) >> 15;
+        if (level > limitEnvelope)
+            limitEnvelope = level;
+        if (limitEnvelope > POSTPROC_LIMIT) {
+            limitGain = (POSTPROC_LIMIT << 15) / limitEnvelope;
+            if (limitGain < limitMinGain)
+                limitMinGain = limitGain;
+            x = (x * limitGain) >> 15;
+        }
+
+        samples[i] = Saturate(x);
+    }
+}
+
+
+void PostProcPrint (void) {
+    int b;
+
+    printf("Post-processing %s.  Volume %d%%", enabled ? "on" : "off",
+           (int)(((int64_t)gain * 100) >> POSTPROC_GAIN_SHIFT));
+    if (gainRampSamples)
+        printf(" ramping to %d%%", (int)(((int64_t)gainTarget * 100) >> POSTPROC_GAIN_SHIFT));
+    printf(", deepest limiting %d/32768.\r\n", (int)limitMinGain);
+    for (b = 0; b < biquadCount; b++)
+        printf("  biquad %d: b %d %d %d, a %d %d (Q13)\r\n", b, biquads[b].B0, biquads[b].B1, biquads[b].B2,
+               -biquads[b].A1, -biquads[b].A2);
+    limitMinGain = 32768;
+}
@@ -0,0 +1,46 @@
+// Post-Processing Header File
+// An optional chain run over each mixed block before it's resampled: a cascade of biquad filters
+// (EQ), a volume control that ramps linearly to new settings, and a peak limiter.  It's all
+// fixed point, works in place, and does every stage for one sample before moving to the next, so
+// it's one pass over the block however many stages there are.
+// The filters are set up from POSTPROC_EQ in settings.h.
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifndef POSTPROC_H
+#define POSTPROC_H
+
+#define POSTPROC_MAX_BIQUADS 4
+#define POSTPROC_COEF_SHIFT 13      // Biquad coefficients are Q13, which covers the +-4 that boosts can need.
+#define POSTPROC_GAIN_SHIFT 23      // The volume ramps in Q8.23, so long ramps still move every sample.
+
+enum {
+    POSTPROC_HIGHPASS,
+    POSTPROC_LOWPASS,
+    POSTPROC_PEAK,
+    POSTPROC_LOWSHELF,
+    POSTPROC_HIGHSHELF
+};
+
+// One EQ section, as written in settings.h.
+typedef struct {
+    int Type;
+    float Frequency;    // Hz.
+    float Q;
+    float GainDb;       // Peak and shelf only.
+} postProcBand_t;
+
+typedef struct {
+    int16_t B0, B1, B2, A1, A2; // Q13, A1/A2 with the sign already flipped for adding.
+    int16_t X1, X2, Y1, Y2;
+    int32_t Error;              // Rounding error carried into the next sample (first-order noise shaping).
+} postProcBiquad_t;
+
+void PostProcInit (uint32_t sampleRate);
+void PostProcSetGain (int16_t gain, uint32_t rampMs);
+void PostProcEnable (bool enable);
+bool PostProcIsEnabled (void);
+void PostProcProcess (int16_t * samples, int count);
+void PostProcPrint (void);
+
+#endif
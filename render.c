@@ -0,0 +1,16 @@
+#include "player.h"
+#include "postproc.h"
+#include "render.h"
+
+
+// Render a block of samples at PLAYER_SAMPLE_RATE from the player into pcm, post-process it, and
+// resample it to the output rate.  The player renders into the back of the buffer, post-processing
+// happens in place there, and the resampler works forwards from the front.  pcm must have room for
+// ResamplerMaxOutput(samples).  Returns the samples at the output rate; 0 once nothing is playing.
+int RenderBlock (resampler_t * resampler, int16_t * pcm, int samples, bool late) {
+    int16_t *input = pcm + ResamplerInputOffset(resampler, samples);
+
+    samples = PlayerRender(input, samples, late);
+    PostProcProcess(input, samples);
+    return ResamplerProcess(resampler, input, samples, pcm);
+}
@@ -0,0 +1,14 @@
+// Render Header File
+// One block of the output chain: the player's mix, post-processed and resampled to the output rate.
+// Shared by the app task and the host build, so both run exactly the same audio path.
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "resampler.h"
+
+#ifndef RENDER_H
+#define RENDER_H
+
+int RenderBlock (resampler_t * resampler, int16_t * pcm, int samples, bool late);
+
+#endif
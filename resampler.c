@@ -0,0 +1,120 @@
+#include <string.h>
+
+#include "resampler.h"
+
+// Set up a converter.  Returns false if the ratio isn't one the tables cover.
+bool ResamplerInit (resampler_t * resampler, uint32_t inputRate, uint32_t outputRate) {
+    memset(resampler, 0, sizeof(*resampler));
+
+    if (inputRate == outputRate)
+        return true;
+
+    if (inputRate != 8000 && inputRate != 12000 && inputRate != 16000 && inputRate != 24000)
+        return false;
+
+    if (outputRate == 48000) {
+        resampler->Table = resamplerTable12;
+        resampler->Phases = 12;
+    } else if (outputRate == 44100) {
+        resampler->Table = resamplerTable441;
+        resampler->Phases = 441;
+    } else {
+        return false;
+    }
+
+    // Rows per output = Phases * inputRate / outputRate, which comes out whole for every pair above.
+    resampler->Step = (uint32_t)(((uint64_t)resampler->Phases * inputRate) / outputRate);
+    return true;
+}
+
+
+// Forget the previous block, for the start of a new stream.
+void ResamplerReset (resampler_t * resampler) {
+    resampler->Phase = 0;
+    memset(resampler->History, 0, sizeof(resampler->History));
+}
+
+
+// The most output samples a block of inSamples can produce.
+int ResamplerMaxOutput (const resampler_t * resampler, int inSamples) {
+    if (!resampler->Table)
+        return inSamples;
+    return (int)(((uint32_t)inSamples * resampler->Phases) / resampler->Step) + 1;
+}
+
+
+// Where to put inSamples of input in the output buffer to resample in place.  The buffer must hold
+// ResamplerInputOffset() + inSamples samples.
+// The input goes at the end, after room for the whole output plus a filter's worth of headroom.
+// The output then only catches up with the input at the very end of the block, by which time the
+// filter no longer needs the samples it overwrites.
+int ResamplerInputOffset (const resampler_t * resampler, int inSamples) {
+    if (!resampler->Table)
+        return 0;
+    return ResamplerMaxOutput(resampler, inSamples) + RESAMPLER_TAPS - inSamples;
+}
+
+
+static inline int16_t Saturate (int32_t value) {
+    if (value > INT16_MAX)
+        return INT16_MAX;
+    if (value < INT16_MIN)
+        return INT16_MIN;
+    return (int16_t)value;
+}
+
+
+static inline int16_t Filter (const int16_t * x, const int16_t * coefs) {
+    int32_t acc = 1 << 14;
+    int k;
+    for (k = 0; k < RESAMPLER_TAPS; k++)
+        acc += (int32_t)x[k] * coefs[k];
+    return Saturate(acc >> 15);
+}
+
+
+// Resample a block.  Returns the number of output samples written.
+// Output is delayed by RESAMPLER_TAPS/2 input samples, since each output only uses inputs up to the
+// newest one.  input and output can overlap as described at ResamplerInputOffset().
+int ResamplerProcess (resampler_t * resampler, const int16_t * input, int inSamples, int16_t * output) {
+    int16_t window[2 * RESAMPLER_TAPS - 1];
+    const uint32_t phases = resampler->Phases, step = resampler->Step;
+    uint32_t phase = resampler->Phase;
+    int i, head, written = 0;
+
+    if (!resampler->Table) {
+        if (output != input)
+            memmove(output, input, inSamples * sizeof(int16_t));
+        return inSamples;
+    }
+
+    // The first few inputs need the previous block's tail, so run those through a joined window.
+    head = inSamples < RESAMPLER_TAPS - 1 ? inSamples : RESAMPLER_TAPS - 1;
+    memcpy(window, resampler->History, sizeof(resampler->History));
+    memcpy(window + RESAMPLER_TAPS - 1, input, head * sizeof(int16_t));
+    for (i = 0; i < head; i++) {
+        for (; phase < phases; phase += step)
+            output[written++] = Filter(window + i, resampler->Table[phase]);
+        phase -= phases;
+    }
+
+    // The rest read straight from the input.
+    for (; i < inSamples; i++) {
+        const int16_t *x = input + i - (RESAMPLER_TAPS - 1);
+        for (; phase < phases; phase += step)
+            output[written++] = Filter(x, resampler->Table[phase]);
+        phase -= phases;
+    }
+
+    // Keep the tail for next time.  The output hasn't reached it yet (see ResamplerInputOffset()).
+    if (inSamples >= RESAMPLER_TAPS - 1) {
+        memcpy(resampler->History, input + inSamples - (RESAMPLER_TAPS - 1), sizeof(resampler->History));
+    } else {
+        memmove(resampler->History, resampler->History + inSamples,
+                (RESAMPLER_TAPS - 1 - inSamples) * sizeof(int16_t));
+        memcpy(resampler->History + RESAMPLER_TAPS - 1 - inSamples, input, inSamples * sizeof(int16_t));
+    }
+
+    resampler->Phase = phase;
+    return written;
+}
@@ -0,0 +1,34 @@
+// Resampler Header File
+// Fixed-point polyphase sample-rate converter, for playing the decoder's output on an I2S DAC
+// running at a different rate.  Converts 8, 12, 16 or 24 kHz up to 44.1 or 48 kHz, or passes
+// through unchanged when the rates match.  The filter tables are in resampler_tables.c, generated by
+// tools/gen_resampler_tables.py.
+//
+// It can work in place: put the input ResamplerInputOffset() samples into the output buffer and the
+// output is written from the start of the buffer without treading on input it still needs.
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifndef RESAMPLER_H
+#define RESAMPLER_H
+
+#define RESAMPLER_TAPS 16
+
+extern const int16_t resamplerTable12[12][RESAMPLER_TAPS];
+extern const int16_t resamplerTable441[441][RESAMPLER_TAPS];
+
+typedef struct {
+    const int16_t (*Table)[RESAMPLER_TAPS]; // NULL when passing through.
+    uint32_t Phases;                        // Rows in Table.
+    uint32_t Step;                          // Table rows to advance per output sample.
+    uint32_t Phase;                         // Where the next output falls, in rows past the newest input.
+    int16_t History[RESAMPLER_TAPS - 1];    // The last inputs of the previous block.
+} resampler_t;
+
+bool ResamplerInit (resampler_t * resampler, uint32_t inputRate, uint32_t outputRate);
+void ResamplerReset (resampler_t * resampler);
+int ResamplerMaxOutput (const resampler_t * resampler, int inSamples);
+int ResamplerInputOffset (const resampler_t * resampler, int inSamples);
+int ResamplerProcess (resampler_t * resampler, const int16_t * input, int inSamples, int16_t * output);
+
+#endif
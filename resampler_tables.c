@@ -0,0 +1,463 @@
+// Generated by gen_resampler_tables.py on 2026-10-19.  Don't edit; re-run the script.
+// Windowed-sinc, 16 taps, cut-off 0.90 of the input Nyquist, Kaiser beta 7.0.
+
+#include "resampler.h"
+
+const int16_t resamplerTable12[12][RESAMPLER_TAPS] = {
+    { 48, -192, 511, -1046, 1755, -2495, 3063, 29480, 3063, -2495, 1755, -1046, 511, -192, 48, 0 },
+    { 48, -185, 464, -884, 1334, -1532, 712, 29204, 5696, -3427, 2118, -1164, 533, -188, 43, -4 },
+    { 46, -167, 396, -690, 882, -591, -1305, 28366, 8543, -4267, 2392, -1222, 522, -169, 34, -2 },
+    { 40, -143, 314, -480, 429, 280, -2949, 27007, 11523, -4954, 2550, -1211, 477, -136, 20, 1 },
+    { 33, -114, 226, -267, 0, 1043, -4200, 25170, 14547, -5429, 2570, -1124, 394, -87, 0, 6 },
+    { 26, -83, 136, -64, -384, 1667, -5054, 22924, 17519, -5635, 2435, -955, 273, -24, -24, 11 },
+    { 18, -52, 52, 119, -706, 2134, -5523, 20341, 20343, -5523, 2134, -706, 119, 52, -52, 18 },
+    { 11, -24, -24, 273, -955, 2435, -5635, 17519, 22924, -5054, 1667, -384, -64, 136, -83, 26 },
+    { 6, 0, -87, 394, -1124, 2570, -5429, 14547, 25170, -4200, 1043, 0, -267, 226, -114, 33 },
+    { 1, 20, -136, 477, -1211, 2550, -4954, 11523, 27007, -2949, 280, 429, -480, 314, -143, 40 },
+    { -2, 34, -169, 522, -1222, 2392, -4267, 8543, 28366, -1305, -591, 882, -690, 396, -167, 46 },
+    { -4, 43, -188, 533, -1164, 2118, -3427, 5696, 29204, 712, -1532, 1334, -884, 464, -185, 48 },
+};
+
+const int16_t resamplerTable441[441][RESAMPLER_TAPS] = {
+    { 48, -192, 511, -1046, 1755, -2495, 3063, 29480, 3063, -2495, 1755, -1046, 511, -192, 48, 0 },
+    { 48, -192, 510, -1043, 1745, -2470, 2995, 29487, 3131, -2522, 1766, -1050, 512, -192, 48, -5 },
+    { 48, -192, 509, -1039, 1734, -2444, 2927, 29486, 3200, -2548, 1777, -1054, 513, -192, 48, -5 },
+    { 48, -192, 508, -1035, 1723, -2417, 2860, 29484, 3268, -2574, 1788, -1058, 514, -192, 48, -5 },
+    { 48, -192, 507, -1031, 1712, -2391, 2792, 29484, 3337, -2600, 1798, -1062, 515, -192, 48, -5 },
+    { 48, -192, 506, -1027, 1701, -2365, 2725, 29480, 3406, -2625, 1809, -1065, 516, -192, 48, -5 },
+    { 48, -192, 505, -1023, 1690, -2339, 2658, 29478, 3475, -2651, 1819, -1069, 517, -192, 48, -4 },
+    { 48, -192, 504, -1019, 1679, -2313, 2591, 29475, 3545, -2677, 1830, -1073, 518, -192, 48, -4 },
+    { 48, -192, 503, -1015, 1668, -2287, 2525, 29473, 3614, -2703, 1840, -1076, 519, -192, 47, -4 },
+    { 49, -191, 502, -1010, 1657, -2261, 2459, 29467, 3684, -2729, 1851, -1080, 519, -192, 47, -4 },
+    { 49, -191, 501, -1006, 1645, -2234, 2393, 29464, 3754, -2755, 1861, -1084, 520, -192, 47, -4 },
+    { 49, -191, 500, -1002, 1634, -2208, 2327, 29459, 3824, -2780, 1871, -1087, 521, -192, 47, -4 },
+    { 49, -191, 498, -998, 1623, -2182, 2261, 29454, 3895, -2806, 1882, -1090, 522, -192, 47, -4 },
+    { 49, -191, 497, -994, 1612, -2156, 2196, 29451, 3965, -2832, 1892, -1094, 522, -192, 47, -4 },
+    { 49, -191, 496, -989, 1600, -2129, 2131, 29443, 4036, -2857, 1902, -1097, 523, -192, 47, -4 },
+    { 49, -190, 495, -985, 1589, -2103, 2066, 29437, 4107, -2883, 1912, -1101, 524, -192, 47, -4 },
+    { 49, -190, 494, -981, 1577, -2077, 2001, 29432, 4178, -2908, 1922, -1104, 524, -192, 47, -4 },
+    { 49, -190, 492, -976, 1566, -2051, 1937, 29424, 4250, -2934, 1932, -1107, 525, -192, 47, -4 },
+    { 49, -190, 491, -972, 1555, -2024, 1872, 29417, 4321, -2959, 1942, -1110, 526, -192, 46, -4 },
+    { 49, -190, 490, -967, 1543, -1998, 1808, 29411, 4393, -2985, 1952, -1114, 526, -192, 46, -4 },
+    { 49, -189, 488, -963, 1531, -1972, 1745, 29401, 4465, -3010, 1962, -1117, 527, -191, 46, -4 },
+    { 49, -189, 487, -958, 1520, -1946, 1681, 29392, 4537, -3035, 1972, -1120, 527, -191, 46, -4 },
+    { 49, -189, 486, -954, 1508, -1919, 1618, 29384, 4609, -3061, 1981, -1123, 528, -191, 46, -4 },
+    { 49, -189, 484, -949, 1497, -1893, 1555, 29374, 4682, -3086, 1991, -1126, 528, -191, 46, -4 },
+    { 49, -188, 483, -945, 1485, -1867, 1492, 29363, 4755, -3111, 2001, -1129, 529, -191, 46, -4 },
+    { 49, -188, 481, -940, 1473, -1840, 1429, 29356, 4827, -3136, 2010, -1132, 529, -191, 45, -4 },
+    { 49, -188, 480, -935, 1462, -1814, 1367, 29342, 4900, -3161, 2020, -1135, 530, -190, 45, -4 },
+    { 49, -188, 479, -931, 1450, -1788, 1305, 29332, 4974, -3186, 2029, -1138, 530, -190, 45, -4 },
+    { 49, -187, 477, -926, 1438, -1762, 1243, 29322, 5047, -3211, 2038, -1141, 530, -190, 45, -4 },
+    { 49, -187, 476, -921, 1426, -1735, 1181, 29308, 5120, -3236, 2048, -1143, 531, -190, 45, -4 },
+    { 49, -187, 474, -917, 1414, -1709, 1120, 29298, 5194, -3261, 2057, -1146, 531, -190, 45, -4 },
+    { 49, -186, 473, -912, 1403, -1683, 1059, 29282, 5268, -3285, 2066, -1149, 531, -189, 45, -4 },
+    { 49, -186, 471, -907, 1391, -1657, 998, 29271, 5342, -3310, 2075, -1152, 532, -189, 44, -4 },
+    { 49, -186, 470, -902, 1379, -1631, 937, 29258, 5416, -3335, 2084, -1154, 532, -189, 44, -4 },
+    { 49, -185, 468, -897, 1367, -1604, 876, 29243, 5491, -3359, 2093, -1157, 532, -189, 44, -4 },
+    { 49, -185, 467, -893, 1355, -1578, 816, 29229, 5565, -3384, 2102, -1159, 532, -188, 44, -4 },
+    { 48, -185, 465, -888, 1343, -1552, 756, 29215, 5640, -3408, 2111, -1162, 533, -188, 44, -4 },
+    { 48, -184, 463, -883, 1331, -1526, 697, 29200, 5715, -3433, 2120, -1164, 533, -188, 43, -4 },
+    { 48, -184, 462, -878, 1319, -1500, 637, 29184, 5790, -3457, 2129, -1167, 533, -187, 43, -4 },
+    { 48, -184, 460, -873, 1307, -1474, 578, 29169, 5865, -3481, 2137, -1169, 533, -187, 43, -4 },
+    { 48, -183, 458, -868, 1295, -1447, 519, 29152, 5940, -3506, 2146, -1171, 533, -187, 43, -4 },
+    { 48, -183, 457, -863, 1283, -1421, 460, 29135, 6016, -3530, 2154, -1174, 533, -186, 43, -4 },
+    { 48, -183, 455, -858, 1271, -1395, 402, 29119, 6091, -3554, 2163, -1176, 533, -186, 42, -4 },
+    { 48, -182, 453, -853, 1258, -1369, 344, 29102, 6167, -3578, 2171, -1178, 533, -186, 42, -4 },
+    { 48, -182, 452, -848, 1246, -1343, 286, 29082, 6243, -3602, 2180, -1180, 533, -185, 42, -4 },
+    { 48, -181, 450, -843, 1234, -1317, 228, 29062, 6319, -3625, 2188, -1182, 533, -185, 42, -3 },
+    { 48, -181, 448, -838, 1222, -1291, 171, 29044, 6395, -3649, 2196, -1184, 533, -185, 42, -3 },
+    { 48, -181, 447, -832, 1210, -1265, 114, 29023, 6472, -3673, 2204, -1186, 533, -184, 41, -3 },
+    { 48, -180, 445, -827, 1198, -1240, 57, 29004, 6548, -3696, 2212, -1188, 533, -184, 41, -3 },
+    { 48, -180, 443, -822, 1185, -1214, 0, 28985, 6625, -3720, 2220, -1190, 533, -183, 41, -3 },
+    { 48, -179, 441, -817, 1173, -1188, -56, 28963, 6702, -3743, 2228, -1192, 533, -183, 41, -3 },
+    { 48, -179, 439, -812, 1161, -1162, -113, 28943, 6779, -3766, 2236, -1194, 533, -182, 40, -3 },
+    { 48, -178, 438, -807, 1149, -1136, -168, 28920, 6856, -3790, 2244, -1196, 533, -182, 40, -3 },
+    { 48, -178, 436, -801, 1136, -1110, -224, 28901, 6933, -3813, 2251, -1198, 532, -182, 40, -3 },
+    { 47, -177, 434, -796, 1124, -1085, -279, 28878, 7010, -3836, 2259, -1199, 532, -181, 40, -3 },
+    { 47, -177, 432, -791, 1112, -1059, -334, 28856, 7088, -3859, 2267, -1201, 532, -181, 39, -3 },
+    { 47, -176, 430, -785, 1099, -1033, -389, 28832, 7165, -3882, 2274, -1202, 532, -180, 39, -3 },
+    { 47, -176, 428, -780, 1087, -1008, -444, 28812, 7243, -3905, 2281, -1204, 531, -180, 39, -3 },
+    { 47, -175, 426, -775, 1075, -982, -498, 28784, 7321, -3927, 2289, -1205, 531, -179, 39, -3 },
+    { 47, -175, 425, -769, 1062, -957, -552, 28761, 7399, -3950, 2296, -1207, 531, -178, 38, -3 },
+    { 47, -174, 423, -764, 1050, -931, -606, 28736, 7477, -3972, 2303, -1208, 530, -178, 38, -3 },
+    { 47, -174, 421, -759, 1038, -906, -659, 28712, 7555, -3995, 2310, -1210, 530, -177, 38, -3 },
+    { 47, -173, 419, -753, 1025, -880, -712, 28686, 7633, -4017, 2317, -1211, 529, -177, 38, -3 },
+    { 47, -173, 417, -748, 1013, -855, -765, 28660, 7712, -4039, 2324, -1212, 529, -176, 37, -3 },
+    { 47, -172, 415, -743, 1000, -830, -818, 28636, 7791, -4062, 2331, -1213, 528, -176, 37, -3 },
+    { 46, -172, 413, -737, 988, -804, -870, 28608, 7869, -4084, 2338, -1215, 528, -175, 37, -2 },
+    { 46, -171, 411, -732, 976, -779, -923, 28582, 7948, -4105, 2344, -1216, 527, -174, 36, -2 },
+    { 46, -171, 409, -726, 963, -754, -974, 28554, 8027, -4127, 2351, -1217, 527, -174, 36, -2 },
+    { 46, -170, 407, -721, 951, -729, -1026, 28527, 8106, -4149, 2357, -1218, 526, -173, 36, -2 },
+    { 46, -170, 405, -715, 938, -704, -1077, 28498, 8185, -4171, 2364, -1219, 526, -172, 36, -2 },
+    { 46, -169, 403, -710, 926, -679, -1128, 28471, 8264, -4192, 2370, -1220, 525, -172, 35, -2 },
+    { 46, -169, 401, -704, 914, -654, -1179, 28441, 8344, -4214, 2376, -1220, 524, -171, 35, -2 },
+    { 46, -168, 399, -699, 901, -629, -1230, 28411, 8423, -4235, 2383, -1221, 524, -170, 35, -2 },
+    { 46, -167, 397, -693, 889, -604, -1280, 28381, 8503, -4256, 2389, -1222, 523, -170, 34, -2 },
+    { 45, -167, 395, -687, 876, -579, -1330, 28353, 8582, -4277, 2395, -1223, 522, -169, 34, -2 },
+    { 45, -166, 393, -682, 864, -554, -1379, 28320, 8662, -4298, 2401, -1223, 521, -168, 34, -2 },
+    { 45, -166, 391, -676, 851, -529, -1429, 28293, 8742, -4319, 2406, -1224, 520, -168, 33, -2 },
+    { 45, -165, 388, -671, 839, -505, -1478, 28261, 8822, -4340, 2412, -1224, 520, -167, 33, -2 },
+    { 45, -164, 386, -665, 827, -480, -1527, 28227, 8902, -4360, 2418, -1225, 519, -166, 33, -2 },
+    { 45, -164, 384, -659, 814, -455, -1575, 28196, 8982, -4381, 2423, -1225, 518, -165, 32, -2 },
+    { 45, -163, 382, -654, 802, -431, -1623, 28163, 9062, -4401, 2429, -1226, 517, -165, 32, -1 },
+    { 45, -163, 380, -648, 789, -406, -1671, 28129, 9143, -4421, 2434, -1226, 516, -164, 32, -1 },
+    { 44, -162, 378, -643, 777, -382, -1719, 28098, 9223, -4441, 2439, -1226, 515, -163, 31, -1 },
+    { 44, -161, 376, -637, 764, -358, -1767, 28064, 9304, -4461, 2445, -1227, 514, -162, 31, -1 },
+    { 44, -161, 374, -631, 752, -333, -1814, 28029, 9384, -4481, 2450, -1227, 513, -161, 31, -1 },
+    { 44, -160, 371, -626, 740, -309, -1861, 27997, 9465, -4501, 2455, -1227, 512, -161, 30, -1 },
+    { 44, -159, 369, -620, 727, -285, -1907, 27961, 9546, -4521, 2460, -1227, 511, -160, 30, -1 },
+    { 44, -159, 367, -614, 715, -261, -1953, 27926, 9626, -4540, 2465, -1227, 510, -159, 29, -1 },
+    { 44, -158, 365, -608, 702, -237, -1999, 27890, 9707, -4559, 2469, -1227, 509, -158, 29, -1 },
+    { 44, -157, 363, -603, 690, -213, -2045, 27854, 9788, -4579, 2474, -1227, 508, -157, 29, -1 },
+    { 43, -157, 360, -597, 678, -189, -2091, 27821, 9869, -4598, 2479, -1227, 506, -156, 28, -1 },
+    { 43, -156, 358, -591, 665, -165, -2136, 27783, 9950, -4617, 2483, -1226, 505, -155, 28, -1 },
+    { 43, -155, 356, -586, 653, -141, -2181, 27746, 10032, -4635, 2487, -1226, 504, -155, 27, -1 },
+    { 43, -155, 354, -580, 641, -118, -2225, 27707, 10113, -4654, 2492, -1226, 503, -154, 27, 0 },
+    { 43, -154, 352, -574, 628, -94, -2269, 27669, 10194, -4673, 2496, -1225, 501, -153, 27, 0 },
+    { 43, -153, 349, -568, 616, -70, -2313, 27631, 10275, -4691, 2500, -1225, 500, -152, 26, 0 },
+    { 42, -153, 347, -563, 604, -47, -2357, 27593, 10357, -4709, 2504, -1224, 499, -151, 26, 0 },
+    { 42, -152, 345, -557, 591, -23, -2401, 27557, 10438, -4728, 2508, -1224, 497, -150, 25, 0 },
+    { 42, -151, 342, -551, 579, 0, -2444, 27516, 10520, -4746, 2512, -1223, 496, -149, 25, 0 },
+    { 42, -151, 340, -545, 567, 23, -2487, 27477, 10601, -4763, 2515, -1223, 495, -148, 25, 0 },
+    { 42, -150, 338, -539, 554, 47, -2529, 27436, 10683, -4781, 2519, -1222, 493, -147, 24, 0 },
+    { 42, -149, 336, -534, 542, 70, -2571, 27395, 10765, -4799, 2522, -1221, 492, -146, 24, 0 },
+    { 42, -149, 333, -528, 530, 93, -2613, 27355, 10847, -4816, 2526, -1220, 490, -145, 23, 0 },
+    { 41, -148, 331, -522, 518, 116, -2655, 27315, 10928, -4833, 2529, -1220, 489, -144, 23, 0 },
+    { 41, -147, 329, -516, 505, 139, -2696, 27273, 11010, -4850, 2532, -1219, 487, -143, 22, 1 },
+    { 41, -146, 326, -510, 493, 161, -2738, 27233, 11092, -4867, 2535, -1218, 485, -142, 22, 1 },
+    { 41, -146, 324, -505, 481, 184, -2778, 27190, 11174, -4884, 2538, -1217, 484, -141, 22, 1 },
+    { 41, -145, 322, -499, 469, 207, -2819, 27147, 11256, -4901, 2541, -1215, 482, -140, 21, 1 },
+    { 41, -144, 319, -493, 457, 230, -2859, 27101, 11338, -4917, 2544, -1214, 481, -138, 21, 1 },
+    { 40, -143, 317, -487, 445, 252, -2899, 27060, 11420, -4934, 2547, -1213, 479, -137, 20, 1 },
+    { 40, -143, 315, -481, 432, 275, -2939, 27017, 11502, -4950, 2550, -1212, 477, -136, 20, 1 },
+    { 40, -142, 312, -476, 420, 297, -2978, 26975, 11584, -4966, 2552, -1210, 475, -135, 19, 1 },
+    { 40, -141, 310, -470, 408, 319, -3017, 26930, 11666, -4982, 2554, -1209, 474, -134, 19, 1 },
+    { 40, -140, 308, -464, 396, 341, -3056, 26885, 11749, -4998, 2557, -1208, 472, -133, 18, 1 },
+    { 40, -140, 305, -458, 384, 363, -3095, 26840, 11831, -5013, 2559, -1206, 470, -132, 18, 2 },
+    { 39, -139, 303, -452, 372, 386, -3133, 26796, 11913, -5029, 2561, -1205, 468, -131, 17, 2 },
+    { 39, -138, 301, -446, 360, 407, -3171, 26749, 11995, -5044, 2563, -1203, 466, -129, 17, 2 },
+    { 39, -137, 298, -441, 348, 429, -3208, 26703, 12078, -5059, 2565, -1201, 464, -128, 16, 2 },
+    { 39, -137, 296, -435, 336, 451, -3246, 26658, 12160, -5074, 2567, -1200, 462, -127, 16, 2 },
+    { 39, -136, 294, -429, 324, 473, -3283, 26612, 12242, -5089, 2568, -1198, 460, -126, 15, 2 },
+    { 38, -135, 291, -423, 312, 494, -3319, 26565, 12324, -5103, 2570, -1196, 458, -125, 15, 2 },
+    { 38, -134, 289, -417, 300, 516, -3356, 26517, 12407, -5118, 2571, -1194, 456, -123, 14, 2 },
+    { 38, -134, 286, -411, 288, 537, -3392, 26470, 12489, -5132, 2573, -1192, 454, -122, 14, 2 },
+    { 38, -133, 284, -406, 277, 559, -3428, 26420, 12572, -5146, 2574, -1190, 452, -121, 13, 3 },
+    { 38, -132, 282, -400, 265, 580, -3463, 26370, 12654, -5160, 2575, -1188, 450, -119, 13, 3 },
+    { 38, -131, 279, -394, 253, 601, -3499, 26323, 12736, -5173, 2576, -1186, 448, -118, 12, 3 },
+    { 37, -131, 277, -388, 241, 622, -3533, 26274, 12819, -5187, 2577, -1184, 446, -117, 12, 3 },
+    { 37, -130, 274, -382, 229, 643, -3568, 26226, 12901, -5200, 2578, -1181, 443, -116, 11, 3 },
+    { 37, -129, 272, -377, 218, 664, -3603, 26177, 12983, -5214, 2578, -1179, 441, -114, 11, 3 },
+    { 37, -128, 269, -371, 206, 685, -3637, 26127, 13066, -5227, 2579, -1177, 439, -113, 10, 3 },
+    { 37, -127, 267, -365, 194, 706, -3670, 26074, 13148, -5239, 2579, -1174, 437, -112, 10, 3 },
+    { 36, -127, 265, -359, 183, 726, -3704, 26024, 13231, -5252, 2580, -1172, 434, -110, 9, 4 },
+    { 36, -126, 262, -353, 171, 747, -3737, 25973, 13313, -5265, 2580, -1169, 432, -109, 9, 4 },
+    { 36, -125, 260, -348, 159, 767, -3770, 25923, 13395, -5277, 2580, -1166, 430, -108, 8, 4 },
+    { 36, -124, 257, -342, 148, 787, -3803, 25871, 13478, -5289, 2580, -1164, 427, -106, 8, 4 },
+    { 36, -123, 255, -336, 136, 808, -3835, 25818, 13560, -5301, 2580, -1161, 425, -105, 7, 4 },
+    { 35, -123, 253, -330, 125, 828, -3867, 25767, 13642, -5313, 2580, -1158, 422, -103, 6, 4 },
+    { 35, -122, 250, -324, 113, 848, -3899, 25713, 13725, -5324, 2580, -1155, 420, -102, 6, 4 },
+    { 35, -121, 248, -319, 102, 868, -3930, 25661, 13807, -5335, 2579, -1152, 417, -101, 5, 4 },
+    { 35, -120, 245, -313, 90, 888, -3961, 25607, 13889, -5347, 2579, -1150, 415, -99, 5, 5 },
+    { 35, -119, 243, -307, 79, 907, -3992, 25553, 13972, -5358, 2578, -1146, 412, -98, 4, 5 },
+    { 34, -118, 240, -301, 68, 927, -4022, 25497, 14054, -5368, 2577, -1143, 410, -96, 4, 5 },
+    { 34, -118, 238, -296, 56, 946, -4053, 25448, 14136, -5379, 2576, -1140, 407, -95, 3, 5 },
+    { 34, -117, 235, -290, 45, 966, -4083, 25393, 14218, -5389, 2575, -1137, 404, -93, 2, 5 },
+    { 34, -116, 233, -284, 34, 985, -4112, 25337, 14300, -5400, 2574, -1134, 402, -92, 2, 5 },
+    { 34, -115, 231, -278, 22, 1005, -4142, 25281, 14382, -5410, 2573, -1130, 399, -90, 1, 5 },
+    { 33, -114, 228, -273, 11, 1024, -4171, 25225, 14465, -5419, 2572, -1127, 396, -89, 1, 6 },
+    { 33, -114, 226, -267, 0, 1043, -4200, 25170, 14547, -5429, 2570, -1124, 394, -87, 0, 6 },
+    { 33, -113, 223, -261, -11, 1062, -4228, 25113, 14629, -5438, 2569, -1120, 391, -86, -1, 6 },
+    { 33, -112, 221, -255, -22, 1080, -4256, 25056, 14711, -5448, 2567, -1116, 388, -84, -1, 6 },
+    { 33, -111, 218, -250, -33, 1099, -4284, 25003, 14792, -5457, 2565, -1113, 385, -83, -2, 6 },
+    { 32, -110, 216, -244, -44, 1118, -4312, 24944, 14874, -5465, 2563, -1109, 382, -81, -2, 6 },
+    { 32, -109, 213, -238, -55, 1136, -4339, 24887, 14956, -5474, 2561, -1105, 379, -79, -3, 6 },
+    { 32, -109, 211, -233, -66, 1155, -4366, 24830, 15038, -5482, 2559, -1102, 376, -78, -4, 7 },
+    { 32, -108, 209, -227, -77, 1173, -4393, 24771, 15120, -5491, 2557, -1098, 373, -76, -4, 7 },
+    { 32, -107, 206, -221, -88, 1191, -4419, 24715, 15201, -5499, 2554, -1094, 370, -75, -5, 7 },
+    { 31, -106, 204, -216, -99, 1209, -4445, 24656, 15283, -5506, 2552, -1090, 367, -73, -6, 7 },
+    { 31, -105, 201, -210, -110, 1227, -4471, 24597, 15365, -5514, 2549, -1086, 364, -71, -6, 7 },
+    { 31, -104, 199, -204, -121, 1245, -4496, 24537, 15446, -5521, 2547, -1082, 361, -70, -7, 7 },
+    { 31, -104, 196, -199, -131, 1263, -4522, 24477, 15528, -5528, 2544, -1077, 358, -68, -7, 7 },
+    { 31, -103, 194, -193, -142, 1281, -4547, 24416, 15609, -5535, 2541, -1073, 355, -66, -8, 8 },
+    { 30, -102, 191, -188, -153, 1298, -4571, 24360, 15690, -5542, 2538, -1069, 352, -65, -9, 8 },
+    { 30, -101, 189, -182, -163, 1316, -4596, 24297, 15772, -5549, 2534, -1064, 349, -63, -9, 8 },
+    { 30, -100, 187, -177, -174, 1333, -4620, 24237, 15853, -5555, 2531, -1060, 346, -61, -10, 8 },
+    { 30, -99, 184, -171, -184, 1350, -4644, 24178, 15934, -5561, 2528, -1056, 342, -60, -11, 8 },
+    { 30, -99, 182, -165, -195, 1367, -4667, 24116, 16015, -5567, 2524, -1051, 339, -58, -11, 8 },
+    { 29, -98, 179, -160, -205, 1384, -4690, 24054, 16096, -5572, 2520, -1046, 336, -56, -12, 9 },
+    { 29, -97, 177, -154, -216, 1401, -4713, 23992, 16177, -5578, 2517, -1042, 333, -54, -13, 9 },
+    { 29, -96, 174, -149, -226, 1418, -4736, 23931, 16258, -5583, 2513, -1037, 329, -53, -13, 9 },
+    { 29, -95, 172, -143, -237, 1434, -4758, 23869, 16338, -5588, 2509, -1032, 326, -51, -14, 9 },
+    { 29, -94, 169, -138, -247, 1451, -4780, 23807, 16419, -5593, 2504, -1027, 323, -49, -15, 9 },
+    { 28, -93, 167, -132, -257, 1467, -4802, 23744, 16500, -5597, 2500, -1023, 319, -47, -15, 9 },
+    { 28, -93, 165, -127, -267, 1484, -4823, 23682, 16580, -5602, 2496, -1018, 316, -46, -16, 9 },
+    { 28, -92, 162, -121, -278, 1500, -4844, 23619, 16661, -5606, 2491, -1013, 312, -44, -17, 10 },
+    { 28, -91, 160, -116, -288, 1516, -4865, 23553, 16741, -5610, 2487, -1007, 309, -42, -17, 10 },
+    { 28, -90, 157, -111, -298, 1532, -4886, 23491, 16821, -5613, 2482, -1002, 305, -40, -18, 10 },
+    { 27, -89, 155, -105, -308, 1548, -4906, 23427, 16901, -5617, 2477, -997, 302, -38, -19, 10 },
+    { 27, -88, 153, -100, -318, 1564, -4926, 23364, 16981, -5620, 2472, -992, 298, -37, -20, 10 },
+    { 27, -88, 150, -94, -328, 1579, -4946, 23300, 17061, -5623, 2467, -987, 295, -35, -20, 10 },
+    { 27, -87, 148, -89, -338, 1595, -4965, 23233, 17141, -5625, 2461, -981, 291, -33, -21, 11 },
+    { 27, -86, 145, -84, -348, 1610, -4984, 23170, 17221, -5628, 2456, -976, 287, -31, -22, 11 },
+    { 26, -85, 143, -78, -357, 1626, -5003, 23100, 17301, -5630, 2451, -970, 284, -29, -22, 11 },
+    { 26, -84, 141, -73, -367, 1641, -5022, 23037, 17380, -5632, 2445, -965, 280, -27, -23, 11 },
+    { 26, -83, 138, -68, -377, 1656, -5040, 22973, 17459, -5634, 2439, -959, 276, -25, -24, 11 },
+    { 26, -83, 136, -62, -387, 1671, -5058, 22905, 17539, -5635, 2433, -953, 272, -23, -24, 11 },
+    { 25, -82, 133, -57, -396, 1686, -5076, 22841, 17618, -5637, 2427, -948, 269, -22, -25, 12 },
+    { 25, -81, 131, -52, -406, 1700, -5093, 22775, 17697, -5638, 2421, -942, 265, -20, -26, 12 },
+    { 25, -80, 129, -47, -415, 1715, -5110, 22707, 17776, -5639, 2415, -936, 261, -18, -27, 12 },
+    { 25, -79, 126, -41, -425, 1729, -5127, 22639, 17855, -5639, 2409, -930, 257, -16, -27, 12 },
+    { 25, -78, 124, -36, -434, 1744, -5144, 22572, 17934, -5640, 2402, -924, 253, -14, -28, 12 },
+    { 24, -77, 121, -31, -444, 1758, -5160, 22507, 18012, -5640, 2395, -918, 249, -12, -29, 13 },
+    { 24, -77, 119, -26, -453, 1772, -5176, 22438, 18091, -5640, 2389, -912, 246, -10, -30, 13 },
+    { 24, -76, 117, -21, -462, 1786, -5192, 22369, 18169, -5639, 2382, -906, 242, -8, -30, 13 },
+    { 24, -75, 114, -15, -472, 1800, -5207, 22301, 18248, -5639, 2375, -900, 238, -6, -31, 13 },
+    { 24, -74, 112, -10, -481, 1814, -5222, 22231, 18326, -5638, 2368, -893, 234, -4, -32, 13 },
+    { 23, -73, 110, -5, -490, 1827, -5237, 22165, 18404, -5637, 2360, -887, 230, -2, -33, 13 },
+    { 23, -72, 107, 0, -499, 1841, -5252, 22094, 18482, -5635, 2353, -881, 226, 0, -33, 14 },
+    { 23, -72, 105, 5, -508, 1854, -5266, 22027, 18559, -5634, 2346, -874, 221, 2, -34, 14 },
+    { 23, -71, 103, 10, -517, 1867, -5280, 21958, 18637, -5632, 2338, -868, 217, 4, -35, 14 },
+    { 23, -70, 100, 15, -526, 1881, -5294, 21889, 18714, -5630, 2330, -861, 213, 6, -36, 14 },
+    { 22, -69, 98, 20, -535, 1894, -5307, 21818, 18792, -5627, 2322, -855, 209, 8, -36, 14 },
+    { 22, -68, 96, 25, -544, 1907, -5321, 21748, 18869, -5625, 2314, -848, 205, 10, -37, 15 },
+    { 22, -67, 93, 30, -553, 1919, -5333, 21678, 18946, -5622, 2306, -841, 201, 12, -38, 15 },
+    { 22, -67, 91, 35, -561, 1932, -5346, 21607, 19023, -5619, 2298, -834, 197, 14, -39, 15 },
+    { 22, -66, 89, 40, -570, 1945, -5358, 21536, 19099, -5616, 2290, -827, 192, 16, -39, 15 },
+    { 21, -65, 86, 45, -579, 1957, -5371, 21469, 19176, -5612, 2281, -821, 188, 18, -40, 15 },
+    { 21, -64, 84, 50, -587, 1969, -5382, 21394, 19253, -5608, 2273, -814, 184, 21, -41, 15 },
+    { 21, -63, 82, 55, -596, 1982, -5394, 21323, 19329, -5604, 2264, -807, 179, 23, -42, 16 },
+    { 21, -63, 80, 60, -604, 1994, -5405, 21250, 19405, -5600, 2255, -799, 175, 25, -42, 16 },
+    { 21, -62, 77, 65, -613, 2006, -5416, 21179, 19481, -5595, 2246, -792, 171, 27, -43, 16 },
+    { 20, -61, 75, 70, -621, 2017, -5427, 21109, 19557, -5590, 2237, -785, 166, 29, -44, 16 },
+    { 20, -60, 73, 74, -630, 2029, -5437, 21038, 19632, -5585, 2228, -778, 162, 31, -45, 16 },
+    { 20, -59, 71, 79, -638, 2041, -5447, 20964, 19708, -5580, 2218, -771, 158, 33, -46, 17 },
+    { 20, -58, 68, 84, -646, 2052, -5457, 20891, 19783, -5574, 2209, -763, 153, 35, -46, 17 },
+    { 20, -58, 66, 89, -654, 2063, -5467, 20820, 19858, -5568, 2199, -756, 149, 37, -47, 17 },
+    { 19, -57, 64, 93, -663, 2075, -5476, 20747, 19933, -5562, 2190, -748, 144, 40, -48, 17 },
+    { 19, -56, 62, 98, -671, 2086, -5485, 20673, 20008, -5555, 2180, -741, 140, 42, -49, 17 },
+    { 19, -55, 59, 103, -679, 2097, -5494, 20600, 20083, -5549, 2170, -733, 135, 44, -50, 18 },
+    { 19, -54, 57, 108, -687, 2107, -5503, 20527, 20157, -5542, 2160, -726, 131, 46, -50, 18 },
+    { 19, -54, 55, 112, -695, 2118, -5511, 20453, 20232, -5534, 2150, -718, 126, 48, -51, 18 },
+    { 18, -53, 53, 117, -702, 2129, -5519, 20379, 20306, -5527, 2139, -710, 121, 51, -52, 18 },
+    { 18, -52, 51, 121, -710, 2139, -5527, 20306, 20379, -5519, 2129, -702, 117, 53, -53, 18 },
+    { 18, -51, 48, 126, -718, 2150, -5534, 20232, 20453, -5511, 2118, -695, 112, 55, -54, 19 },
+    { 18, -50, 46, 131, -726, 2160, -5542, 20157, 20527, -5503, 2107, -687, 108, 57, -54, 19 },
+    { 18, -50, 44, 135, -733, 2170, -5549, 20083, 20600, -5494, 2097, -679, 103, 59, -55, 19 },
+    { 17, -49, 42, 140, -741, 2180, -5555, 20008, 20673, -5485, 2086, -671, 98, 62, -56, 19 },
+    { 17, -48, 40, 144, -748, 2190, -5562, 19933, 20747, -5476, 2075, -663, 93, 64, -57, 19 },
+    { 17, -47, 37, 149, -756, 2199, -5568, 19858, 20820, -5467, 2063, -654, 89, 66, -58, 20 },
+    { 17, -46, 35, 153, -763, 2209, -5574, 19783, 20891, -5457, 2052, -646, 84, 68, -58, 20 },
+    { 17, -46, 33, 158, -771, 2218, -5580, 19708, 20964, -5447, 2041, -638, 79, 71, -59, 20 },
+    { 16, -45, 31, 162, -778, 2228, -5585, 19632, 21038, -5437, 2029, -630, 74, 73, -60, 20 },
+    { 16, -44, 29, 166, -785, 2237, -5590, 19557, 21109, -5427, 2017, -621, 70, 75, -61, 20 },
+    { 16, -43, 27, 171, -792, 2246, -5595, 19481, 21179, -5416, 2006, -613, 65, 77, -62, 21 },
+    { 16, -42, 25, 175, -799, 2255, -5600, 19405, 21250, -5405, 1994, -604, 60, 80, -63, 21 },
+    { 16, -42, 23, 179, -807, 2264, -5604, 19329, 21323, -5394, 1982, -596, 55, 82, -63, 21 },
+    { 15, -41, 21, 184, -814, 2273, -5608, 19253, 21394, -5382, 1969, -587, 50, 84, -64, 21 },
+    { 15, -40, 18, 188, -821, 2281, -5612, 19176, 21469, -5371, 1957, -579, 45, 86, -65, 21 },
+    { 15, -39, 16, 192, -827, 2290, -5616, 19099, 21536, -5358, 1945, -570, 40, 89, -66, 22 },
+    { 15, -39, 14, 197, -834, 2298, -5619, 19023, 21607, -5346, 1932, -561, 35, 91, -67, 22 },
+    { 15, -38, 12, 201, -841, 2306, -5622, 18946, 21678, -5333, 1919, -553, 30, 93, -67, 22 },
+    { 15, -37, 10, 205, -848, 2314, -5625, 18869, 21748, -5321, 1907, -544, 25, 96, -68, 22 },
+    { 14, -36, 8, 209, -855, 2322, -5627, 18792, 21818, -5307, 1894, -535, 20, 98, -69, 22 },
+    { 14, -36, 6, 213, -861, 2330, -5630, 18714, 21889, -5294, 1881, -526, 15, 100, -70, 23 },
+    { 14, -35, 4, 217, -868, 2338, -5632, 18637, 21958, -5280, 1867, -517, 10, 103, -71, 23 },
+    { 14, -34, 2, 221, -874, 2346, -5634, 18559, 22027, -5266, 1854, -508, 5, 105, -72, 23 },
+    { 14, -33, 0, 226, -881, 2353, -5635, 18482, 22094, -5252, 1841, -499, 0, 107, -72, 23 },
+    { 13, -33, -2, 230, -887, 2360, -5637, 18404, 22165, -5237, 1827, -490, -5, 110, -73, 23 },
+    { 13, -32, -4, 234, -893, 2368, -5638, 18326, 22231, -5222, 1814, -481, -10, 112, -74, 24 },
+    { 13, -31, -6, 238, -900, 2375, -5639, 18248, 22301, -5207, 1800, -472, -15, 114, -75, 24 },
+    { 13, -30, -8, 242, -906, 2382, -5639, 18169, 22369, -5192, 1786, -462, -21, 117, -76, 24 },
+    { 13, -30, -10, 246, -912, 2389, -5640, 18091, 22438, -5176, 1772, -453, -26, 119, -77, 24 },
+    { 13, -29, -12, 249, -918, 2395, -5640, 18012, 22507, -5160, 1758, -444, -31, 121, -77, 24 },
+    { 12, -28, -14, 253, -924, 2402, -5640, 17934, 22572, -5144, 1744, -434, -36, 124, -78, 25 },
+    { 12, -27, -16, 257, -930, 2409, -5639, 17855, 22639, -5127, 1729, -425, -41, 126, -79, 25 },
+    { 12, -27, -18, 261, -936, 2415, -5639, 17776, 22707, -5110, 1715, -415, -47, 129, -80, 25 },
+    { 12, -26, -20, 265, -942, 2421, -5638, 17697, 22775, -5093, 1700, -406, -52, 131, -81, 25 },
+    { 12, -25, -22, 269, -948, 2427, -5637, 17618, 22841, -5076, 1686, -396, -57, 133, -82, 25 },
+    { 11, -24, -23, 272, -953, 2433, -5635, 17539, 22905, -5058, 1671, -387, -62, 136, -83, 26 },
+    { 11, -24, -25, 276, -959, 2439, -5634, 17459, 22973, -5040, 1656, -377, -68, 138, -83, 26 },
+    { 11, -23, -27, 280, -965, 2445, -5632, 17380, 23037, -5022, 1641, -367, -73, 141, -84, 26 },
+    { 11, -22, -29, 284, -970, 2451, -5630, 17301, 23100, -5003, 1626, -357, -78, 143, -85, 26 },
+    { 11, -22, -31, 287, -976, 2456, -5628, 17221, 23170, -4984, 1610, -348, -84, 145, -86, 27 },
+    { 11, -21, -33, 291, -981, 2461, -5625, 17141, 23233, -4965, 1595, -338, -89, 148, -87, 27 },
+    { 10, -20, -35, 295, -987, 2467, -5623, 17061, 23300, -4946, 1579, -328, -94, 150, -88, 27 },
+    { 10, -20, -37, 298, -992, 2472, -5620, 16981, 23364, -4926, 1564, -318, -100, 153, -88, 27 },
+    { 10, -19, -38, 302, -997, 2477, -5617, 16901, 23427, -4906, 1548, -308, -105, 155, -89, 27 },
+    { 10, -18, -40, 305, -1002, 2482, -5613, 16821, 23491, -4886, 1532, -298, -111, 157, -90, 28 },
+    { 10, -17, -42, 309, -1007, 2487, -5610, 16741, 23553, -4865, 1516, -288, -116, 160, -91, 28 },
+    { 10, -17, -44, 312, -1013, 2491, -5606, 16661, 23619, -4844, 1500, -278, -121, 162, -92, 28 },
+    { 9, -16, -46, 316, -1018, 2496, -5602, 16580, 23682, -4823, 1484, -267, -127, 165, -93, 28 },
+    { 9, -15, -47, 319, -1023, 2500, -5597, 16500, 23744, -4802, 1467, -257, -132, 167, -93, 28 },
+    { 9, -15, -49, 323, -1027, 2504, -5593, 16419, 23807, -4780, 1451, -247, -138, 169, -94, 29 },
+    { 9, -14, -51, 326, -1032, 2509, -5588, 16338, 23869, -4758, 1434, -237, -143, 172, -95, 29 },
+    { 9, -13, -53, 329, -1037, 2513, -5583, 16258, 23931, -4736, 1418, -226, -149, 174, -96, 29 },
+    { 9, -13, -54, 333, -1042, 2517, -5578, 16177, 23992, -4713, 1401, -216, -154, 177, -97, 29 },
+    { 9, -12, -56, 336, -1046, 2520, -5572, 16096, 24054, -4690, 1384, -205, -160, 179, -98, 29 },
+    { 8, -11, -58, 339, -1051, 2524, -5567, 16015, 24116, -4667, 1367, -195, -165, 182, -99, 30 },
+    { 8, -11, -60, 342, -1056, 2528, -5561, 15934, 24178, -4644, 1350, -184, -171, 184, -99, 30 },
+    { 8, -10, -61, 346, -1060, 2531, -5555, 15853, 24237, -4620, 1333, -174, -177, 187, -100, 30 },
+    { 8, -9, -63, 349, -1064, 2534, -5549, 15772, 24297, -4596, 1316, -163, -182, 189, -101, 30 },
+    { 8, -9, -65, 352, -1069, 2538, -5542, 15690, 24360, -4571, 1298, -153, -188, 191, -102, 30 },
+    { 8, -8, -66, 355, -1073, 2541, -5535, 15609, 24416, -4547, 1281, -142, -193, 194, -103, 31 },
+    { 7, -7, -68, 358, -1077, 2544, -5528, 15528, 24477, -4522, 1263, -131, -199, 196, -104, 31 },
+    { 7, -7, -70, 361, -1082, 2547, -5521, 15446, 24537, -4496, 1245, -121, -204, 199, -104, 31 },
+    { 7, -6, -71, 364, -1086, 2549, -5514, 15365, 24597, -4471, 1227, -110, -210, 201, -105, 31 },
+    { 7, -6, -73, 367, -1090, 2552, -5506, 15283, 24656, -4445, 1209, -99, -216, 204, -106, 31 },
+    { 7, -5, -75, 370, -1094, 2554, -5499, 15201, 24715, -4419, 1191, -88, -221, 206, -107, 32 },
+    { 7, -4, -76, 373, -1098, 2557, -5491, 15120, 24771, -4393, 1173, -77, -227, 209, -108, 32 },
+    { 7, -4, -78, 376, -1102, 2559, -5482, 15038, 24830, -4366, 1155, -66, -233, 211, -109, 32 },
+    { 6, -3, -79, 379, -1105, 2561, -5474, 14956, 24887, -4339, 1136, -55, -238, 213, -109, 32 },
+    { 6, -2, -81, 382, -1109, 2563, -5465, 14874, 24944, -4312, 1118, -44, -244, 216, -110, 32 },
+    { 6, -2, -83, 385, -1113, 2565, -5457, 14792, 25003, -4284, 1099, -33, -250, 218, -111, 33 },
+    { 6, -1, -84, 388, -1116, 2567, -5448, 14711, 25056, -4256, 1080, -22, -255, 221, -112, 33 },
+    { 6, -1, -86, 391, -1120, 2569, -5438, 14629, 25113, -4228, 1062, -11, -261, 223, -113, 33 },
+    { 6, 0, -87, 394, -1124, 2570, -5429, 14547, 25170, -4200, 1043, 0, -267, 226, -114, 33 },
+    { 6, 1, -89, 396, -1127, 2572, -5419, 14465, 25225, -4171, 1024, 11, -273, 228, -114, 33 },
+    { 5, 1, -90, 399, -1130, 2573, -5410, 14382, 25281, -4142, 1005, 22, -278, 231, -115, 34 },
+    { 5, 2, -92, 402, -1134, 2574, -5400, 14300, 25337, -4112, 985, 34, -284, 233, -116, 34 },
+    { 5, 2, -93, 404, -1137, 2575, -5389, 14218, 25393, -4083, 966, 45, -290, 235, -117, 34 },
+    { 5, 3, -95, 407, -1140, 2576, -5379, 14136, 25448, -4053, 946, 56, -296, 238, -118, 34 },
+    { 5, 4, -96, 410, -1143, 2577, -5368, 14054, 25497, -4022, 927, 68, -301, 240, -118, 34 },
+    { 5, 4, -98, 412, -1146, 2578, -5358, 13972, 25553, -3992, 907, 79, -307, 243, -119, 35 },
+    { 5, 5, -99, 415, -1150, 2579, -5347, 13889, 25607, -3961, 888, 90, -313, 245, -120, 35 },
+    { 4, 5, -101, 417, -1152, 2579, -5335, 13807, 25661, -3930, 868, 102, -319, 248, -121, 35 },
+    { 4, 6, -102, 420, -1155, 2580, -5324, 13725, 25713, -3899, 848, 113, -324, 250, -122, 35 },
+    { 4, 6, -103, 422, -1158, 2580, -5313, 13642, 25767, -3867, 828, 125, -330, 253, -123, 35 },
+    { 4, 7, -105, 425, -1161, 2580, -5301, 13560, 25818, -3835, 808, 136, -336, 255, -123, 36 },
+    { 4, 8, -106, 427, -1164, 2580, -5289, 13478, 25871, -3803, 787, 148, -342, 257, -124, 36 },
+    { 4, 8, -108, 430, -1166, 2580, -5277, 13395, 25923, -3770, 767, 159, -348, 260, -125, 36 },
+    { 4, 9, -109, 432, -1169, 2580, -5265, 13313, 25973, -3737, 747, 171, -353, 262, -126, 36 },
+    { 4, 9, -110, 434, -1172, 2580, -5252, 13231, 26024, -3704, 726, 183, -359, 265, -127, 36 },
+    { 3, 10, -112, 437, -1174, 2579, -5239, 13148, 26074, -3670, 706, 194, -365, 267, -127, 37 },
+    { 3, 10, -113, 439, -1177, 2579, -5227, 13066, 26127, -3637, 685, 206, -371, 269, -128, 37 },
+    { 3, 11, -114, 441, -1179, 2578, -5214, 12983, 26177, -3603, 664, 218, -377, 272, -129, 37 },
+    { 3, 11, -116, 443, -1181, 2578, -5200, 12901, 26226, -3568, 643, 229, -382, 274, -130, 37 },
+    { 3, 12, -117, 446, -1184, 2577, -5187, 12819, 26274, -3533, 622, 241, -388, 277, -131, 37 },
+    { 3, 12, -118, 448, -1186, 2576, -5173, 12736, 26323, -3499, 601, 253, -394, 279, -131, 38 },
+    { 3, 13, -119, 450, -1188, 2575, -5160, 12654, 26370, -3463, 580, 265, -400, 282, -132, 38 },
+    { 3, 13, -121, 452, -1190, 2574, -5146, 12572, 26420, -3428, 559, 277, -406, 284, -133, 38 },
+    { 2, 14, -122, 454, -1192, 2573, -5132, 12489, 26470, -3392, 537, 288, -411, 286, -134, 38 },
+    { 2, 14, -123, 456, -1194, 2571, -5118, 12407, 26517, -3356, 516, 300, -417, 289, -134, 38 },
+    { 2, 15, -125, 458, -1196, 2570, -5103, 12324, 26565, -3319, 494, 312, -423, 291, -135, 38 },
+    { 2, 15, -126, 460, -1198, 2568, -5089, 12242, 26612, -3283, 473, 324, -429, 294, -136, 39 },
+    { 2, 16, -127, 462, -1200, 2567, -5074, 12160, 26658, -3246, 451, 336, -435, 296, -137, 39 },
+    { 2, 16, -128, 464, -1201, 2565, -5059, 12078, 26703, -3208, 429, 348, -441, 298, -137, 39 },
+    { 2, 17, -129, 466, -1203, 2563, -5044, 11995, 26749, -3171, 407, 360, -446, 301, -138, 39 },
+    { 2, 17, -131, 468, -1205, 2561, -5029, 11913, 26796, -3133, 386, 372, -452, 303, -139, 39 },
+    { 2, 18, -132, 470, -1206, 2559, -5013, 11831, 26840, -3095, 363, 384, -458, 305, -140, 40 },
+    { 1, 18, -133, 472, -1208, 2557, -4998, 11749, 26885, -3056, 341, 396, -464, 308, -140, 40 },
+    { 1, 19, -134, 474, -1209, 2554, -4982, 11666, 26930, -3017, 319, 408, -470, 310, -141, 40 },
+    { 1, 19, -135, 475, -1210, 2552, -4966, 11584, 26975, -2978, 297, 420, -476, 312, -142, 40 },
+    { 1, 20, -136, 477, -1212, 2550, -4950, 11502, 27017, -2939, 275, 432, -481, 315, -143, 40 },
+    { 1, 20, -137, 479, -1213, 2547, -4934, 11420, 27060, -2899, 252, 445, -487, 317, -143, 40 },
+    { 1, 21, -138, 481, -1214, 2544, -4917, 11338, 27101, -2859, 230, 457, -493, 319, -144, 41 },
+    { 1, 21, -140, 482, -1215, 2541, -4901, 11256, 27147, -2819, 207, 469, -499, 322, -145, 41 },
+    { 1, 22, -141, 484, -1217, 2538, -4884, 11174, 27190, -2778, 184, 481, -505, 324, -146, 41 },
+    { 1, 22, -142, 485, -1218, 2535, -4867, 11092, 27233, -2738, 161, 493, -510, 326, -146, 41 },
+    { 1, 22, -143, 487, -1219, 2532, -4850, 11010, 27273, -2696, 139, 505, -516, 329, -147, 41 },
+    { 0, 23, -144, 489, -1220, 2529, -4833, 10928, 27315, -2655, 116, 518, -522, 331, -148, 41 },
+    { 0, 23, -145, 490, -1220, 2526, -4816, 10847, 27355, -2613, 93, 530, -528, 333, -149, 42 },
+    { 0, 24, -146, 492, -1221, 2522, -4799, 10765, 27395, -2571, 70, 542, -534, 336, -149, 42 },
+    { 0, 24, -147, 493, -1222, 2519, -4781, 10683, 27436, -2529, 47, 554, -539, 338, -150, 42 },
+    { 0, 25, -148, 495, -1223, 2515, -4763, 10601, 27477, -2487, 23, 567, -545, 340, -151, 42 },
+    { 0, 25, -149, 496, -1223, 2512, -4746, 10520, 27516, -2444, 0, 579, -551, 342, -151, 42 },
+    { 0, 25, -150, 497, -1224, 2508, -4728, 10438, 27557, -2401, -23, 591, -557, 345, -152, 42 },
+    { 0, 26, -151, 499, -1224, 2504, -4709, 10357, 27593, -2357, -47, 604, -563, 347, -153, 42 },
+    { 0, 26, -152, 500, -1225, 2500, -4691, 10275, 27631, -2313, -70, 616, -568, 349, -153, 43 },
+    { 0, 27, -153, 501, -1225, 2496, -4673, 10194, 27669, -2269, -94, 628, -574, 352, -154, 43 },
+    { 0, 27, -154, 503, -1226, 2492, -4654, 10113, 27707, -2225, -118, 641, -580, 354, -155, 43 },
+    { -1, 27, -155, 504, -1226, 2487, -4635, 10032, 27746, -2181, -141, 653, -586, 356, -155, 43 },
+    { -1, 28, -155, 505, -1226, 2483, -4617, 9950, 27783, -2136, -165, 665, -591, 358, -156, 43 },
+    { -1, 28, -156, 506, -1227, 2479, -4598, 9869, 27821, -2091, -189, 678, -597, 360, -157, 43 },
+    { -1, 29, -157, 508, -1227, 2474, -4579, 9788, 27854, -2045, -213, 690, -603, 363, -157, 44 },
+    { -1, 29, -158, 509, -1227, 2469, -4559, 9707, 27890, -1999, -237, 702, -608, 365, -158, 44 },
+    { -1, 29, -159, 510, -1227, 2465, -4540, 9626, 27926, -1953, -261, 715, -614, 367, -159, 44 },
+    { -1, 30, -160, 511, -1227, 2460, -4521, 9546, 27961, -1907, -285, 727, -620, 369, -159, 44 },
+    { -1, 30, -161, 512, -1227, 2455, -4501, 9465, 27997, -1861, -309, 740, -626, 371, -160, 44 },
+    { -1, 31, -161, 513, -1227, 2450, -4481, 9384, 28029, -1814, -333, 752, -631, 374, -161, 44 },
+    { -1, 31, -162, 514, -1227, 2445, -4461, 9304, 28064, -1767, -358, 764, -637, 376, -161, 44 },
+    { -1, 31, -163, 515, -1226, 2439, -4441, 9223, 28098, -1719, -382, 777, -643, 378, -162, 44 },
+    { -1, 32, -164, 516, -1226, 2434, -4421, 9143, 28129, -1671, -406, 789, -648, 380, -163, 45 },
+    { -1, 32, -165, 517, -1226, 2429, -4401, 9062, 28163, -1623, -431, 802, -654, 382, -163, 45 },
+    { -2, 32, -165, 518, -1225, 2423, -4381, 8982, 28196, -1575, -455, 814, -659, 384, -164, 45 },
+    { -2, 33, -166, 519, -1225, 2418, -4360, 8902, 28227, -1527, -480, 827, -665, 386, -164, 45 },
+    { -2, 33, -167, 520, -1224, 2412, -4340, 8822, 28261, -1478, -505, 839, -671, 388, -165, 45 },
+    { -2, 33, -168, 520, -1224, 2406, -4319, 8742, 28293, -1429, -529, 851, -676, 391, -166, 45 },
+    { -2, 34, -168, 521, -1223, 2401, -4298, 8662, 28320, -1379, -554, 864, -682, 393, -166, 45 },
+    { -2, 34, -169, 522, -1223, 2395, -4277, 8582, 28353, -1330, -579, 876, -687, 395, -167, 45 },
+    { -2, 34, -170, 523, -1222, 2389, -4256, 8503, 28381, -1280, -604, 889, -693, 397, -167, 46 },
+    { -2, 35, -170, 524, -1221, 2383, -4235, 8423, 28411, -1230, -629, 901, -699, 399, -168, 46 },
+    { -2, 35, -171, 524, -1220, 2376, -4214, 8344, 28441, -1179, -654, 914, -704, 401, -169, 46 },
+    { -2, 35, -172, 525, -1220, 2370, -4192, 8264, 28471, -1128, -679, 926, -710, 403, -169, 46 },
+    { -2, 36, -172, 526, -1219, 2364, -4171, 8185, 28498, -1077, -704, 938, -715, 405, -170, 46 },
+    { -2, 36, -173, 526, -1218, 2357, -4149, 8106, 28527, -1026, -729, 951, -721, 407, -170, 46 },
+    { -2, 36, -174, 527, -1217, 2351, -4127, 8027, 28554, -974, -754, 963, -726, 409, -171, 46 },
+    { -2, 36, -174, 527, -1216, 2344, -4105, 7948, 28582, -923, -779, 976, -732, 411, -171, 46 },
+    { -2, 37, -175, 528, -1215, 2338, -4084, 7869, 28608, -870, -804, 988, -737, 413, -172, 46 },
+    { -3, 37, -176, 528, -1213, 2331, -4062, 7791, 28636, -818, -830, 1000, -743, 415, -172, 47 },
+    { -3, 37, -176, 529, -1212, 2324, -4039, 7712, 28660, -765, -855, 1013, -748, 417, -173, 47 },
+    { -3, 38, -177, 529, -1211, 2317, -4017, 7633, 28686, -712, -880, 1025, -753, 419, -173, 47 },
+    { -3, 38, -177, 530, -1210, 2310, -3995, 7555, 28712, -659, -906, 1038, -759, 421, -174, 47 },
+    { -3, 38, -178, 530, -1208, 2303, -3972, 7477, 28736, -606, -931, 1050, -764, 423, -174, 47 },
+    { -3, 38, -178, 531, -1207, 2296, -3950, 7399, 28761, -552, -957, 1062, -769, 425, -175, 47 },
+    { -3, 39, -179, 531, -1205, 2289, -3927, 7321, 28784, -498, -982, 1075, -775, 426, -175, 47 },
+    { -3, 39, -180, 531, -1204, 2281, -3905, 7243, 28812, -444, -1008, 1087, -780, 428, -176, 47 },
+    { -3, 39, -180, 532, -1202, 2274, -3882, 7165, 28832, -389, -1033, 1099, -785, 430, -176, 47 },
+    { -3, 39, -181, 532, -1201, 2267, -3859, 7088, 28856, -334, -1059, 1112, -791, 432, -177, 47 },
+    { -3, 40, -181, 532, -1199, 2259, -3836, 7010, 28878, -279, -1085, 1124, -796, 434, -177, 47 },
+    { -3, 40, -182, 532, -1198, 2251, -3813, 6933, 28901, -224, -1110, 1136, -801, 436, -178, 48 },
+    { -3, 40, -182, 533, -1196, 2244, -3790, 6856, 28920, -168, -1136, 1149, -807, 438, -178, 48 },
+    { -3, 40, -182, 533, -1194, 2236, -3766, 6779, 28943, -113, -1162, 1161, -812, 439, -179, 48 },
+    { -3, 41, -183, 533, -1192, 2228, -3743, 6702, 28963, -56, -1188, 1173, -817, 441, -179, 48 },
+    { -3, 41, -183, 533, -1190, 2220, -3720, 6625, 28985, 0, -1214, 1185, -822, 443, -180, 48 },
+    { -3, 41, -184, 533, -1188, 2212, -3696, 6548, 29004, 57, -1240, 1198, -827, 445, -180, 48 },
+    { -3, 41, -184, 533, -1186, 2204, -3673, 6472, 29023, 114, -1265, 1210, -832, 447, -181, 48 },
+    { -3, 42, -185, 533, -1184, 2196, -3649, 6395, 29044, 171, -1291, 1222, -838, 448, -181, 48 },
+    { -3, 42, -185, 533, -1182, 2188, -3625, 6319, 29062, 228, -1317, 1234, -843, 450, -181, 48 },
+    { -4, 42, -185, 533, -1180, 2180, -3602, 6243, 29082, 286, -1343, 1246, -848, 452, -182, 48 },
+    { -4, 42, -186, 533, -1178, 2171, -3578, 6167, 29102, 344, -1369, 1258, -853, 453, -182, 48 },
+    { -4, 42, -186, 533, -1176, 2163, -3554, 6091, 29119, 402, -1395, 1271, -858, 455, -183, 48 },
+    { -4, 43, -186, 533, -1174, 2154, -3530, 6016, 29135, 460, -1421, 1283, -863, 457, -183, 48 },
+    { -4, 43, -187, 533, -1171, 2146, -3506, 5940, 29152, 519, -1447, 1295, -868, 458, -183, 48 },
+    { -4, 43, -187, 533, -1169, 2137, -3481, 5865, 29169, 578, -1474, 1307, -873, 460, -184, 48 },
+    { -4, 43, -187, 533, -1167, 2129, -3457, 5790, 29184, 637, -1500, 1319, -878, 462, -184, 48 },
+    { -4, 43, -188, 533, -1164, 2120, -3433, 5715, 29200, 697, -1526, 1331, -883, 463, -184, 48 },
+    { -4, 44, -188, 533, -1162, 2111, -3408, 5640, 29215, 756, -1552, 1343, -888, 465, -185, 48 },
+    { -4, 44, -188, 532, -1159, 2102, -3384, 5565, 29229, 816, -1578, 1355, -893, 467, -185, 49 },
+    { -4, 44, -189, 532, -1157, 2093, -3359, 5491, 29243, 876, -1604, 1367, -897, 468, -185, 49 },
+    { -4, 44, -189, 532, -1154, 2084, -3335, 5416, 29258, 937, -1631, 1379, -902, 470, -186, 49 },
+    { -4, 44, -189, 532, -1152, 2075, -3310, 5342, 29271, 998, -1657, 1391, -907, 471, -186, 49 },
+    { -4, 45, -189, 531, -1149, 2066, -3285, 5268, 29282, 1059, -1683, 1403, -912, 473, -186, 49 },
+    { -4, 45, -190, 531, -1146, 2057, -3261, 5194, 29298, 1120, -1709, 1414, -917, 474, -187, 49 },
+    { -4, 45, -190, 531, -1143, 2048, -3236, 5120, 29308, 1181, -1735, 1426, -921, 476, -187, 49 },
+    { -4, 45, -190, 530, -1141, 2038, -3211, 5047, 29322, 1243, -1762, 1438, -926, 477, -187, 49 },
+    { -4, 45, -190, 530, -1138, 2029, -3186, 4974, 29332, 1305, -1788, 1450, -931, 479, -188, 49 },
+    { -4, 45, -190, 530, -1135, 2020, -3161, 4900, 29342, 1367, -1814, 1462, -935, 480, -188, 49 },
+    { -4, 45, -191, 529, -1132, 2010, -3136, 4827, 29356, 1429, -1840, 1473, -940, 481, -188, 49 },
+    { -4, 46, -191, 529, -1129, 2001, -3111, 4755, 29363, 1492, -1867, 1485, -945, 483, -188, 49 },
+    { -4, 46, -191, 528, -1126, 1991, -3086, 4682, 29374, 1555, -1893, 1497, -949, 484, -189, 49 },
+    { -4, 46, -191, 528, -1123, 1981, -3061, 4609, 29384, 1618, -1919, 1508, -954, 486, -189, 49 },
+    { -4, 46, -191, 527, -1120, 1972, -3035, 4537, 29392, 1681, -1946, 1520, -958, 487, -189, 49 },
+    { -4, 46, -191, 527, -1117, 1962, -3010, 4465, 29401, 1745, -1972, 1531, -963, 488, -189, 49 },
+    { -4, 46, -192, 526, -1114, 1952, -2985, 4393, 29411, 1808, -1998, 1543, -967, 490, -190, 49 },
+    { -4, 46, -192, 526, -1110, 1942, -2959, 4321, 29417, 1872, -2024, 1555, -972, 491, -190, 49 },
+    { -4, 47, -192, 525, -1107, 1932, -2934, 4250, 29424, 1937, -2051, 1566, -976, 492, -190, 49 },
+    { -4, 47, -192, 524, -1104, 1922, -2908, 4178, 29432, 2001, -2077, 1577, -981, 494, -190, 49 },
+    { -4, 47, -192, 524, -1101, 1912, -2883, 4107, 29437, 2066, -2103, 1589, -985, 495, -190, 49 },
+    { -4, 47, -192, 523, -1097, 1902, -2857, 4036, 29443, 2131, -2129, 1600, -989, 496, -191, 49 },
+    { -4, 47, -192, 522, -1094, 1892, -2832, 3965, 29451, 2196, -2156, 1612, -994, 497, -191, 49 },
+    { -4, 47, -192, 522, -1090, 1882, -2806, 3895, 29454, 2261, -2182, 1623, -998, 498, -191, 49 },
+    { -4, 47, -192, 521, -1087, 1871, -2780, 3824, 29459, 2327, -2208, 1634, -1002, 500, -191, 49 },
+    { -4, 47, -192, 520, -1084, 1861, -2755, 3754, 29464, 2393, -2234, 1645, -1006, 501, -191, 49 },
+    { -4, 47, -192, 519, -1080, 1851, -2729, 3684, 29467, 2459, -2261, 1657, -1010, 502, -191, 49 },
+    { -4, 47, -192, 519, -1076, 1840, -2703, 3614, 29473, 2525, -2287, 1668, -1015, 503, -192, 48 },
+    { -4, 48, -192, 518, -1073, 1830, -2677, 3545, 29475, 2591, -2313, 1679, -1019, 504, -192, 48 },
+    { -4, 48, -192, 517, -1069, 1819, -2651, 3475, 29478, 2658, -2339, 1690, -1023, 505, -192, 48 },
+    { -5, 48, -192, 516, -1065, 1809, -2625, 3406, 29480, 2725, -2365, 1701, -1027, 506, -192, 48 },
+    { -5, 48, -192, 515, -1062, 1798, -2600, 3337, 29484, 2792, -2391, 1712, -1031, 507, -192, 48 },
+    { -5, 48, -192, 514, -1058, 1788, -2574, 3268, 29484, 2860, -2417, 1723, -1035, 508, -192, 48 },
+    { -5, 48, -192, 513, -1054, 1777, -2548, 3200, 29486, 2927, -2444, 1734, -1039, 509, -192, 48 },
+    { -5, 48, -192, 512, -1050, 1766, -2522, 3131, 29487, 2995, -2470, 1745, -1043, 510, -192, 48 },
+};
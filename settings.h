@@ -3,18 +3,74 @@
 #define SETTINGS_H
 
     #define PICO_W // Uncomment if using a Pico-W board.
-    #define CLOCK_SPEED_KHZ 250000 // Overclocked to 250MHz.
+    #define CLOCK_SPEED_KHZ 250000 // Overclocked to 250MHz.  With the governor on, this is just where it starts.
+
+    // Clock governor.  Steps the system clock between these operating points (kHz) based on the measured
+    // decode load.  CLOCK_SPEED_KHZ has to be one of them.  Set CLOCK_GOVERNOR to 0 to stay at CLOCK_SPEED_KHZ.  The `governor` console command
+    // shows the decisions it has made, which is what you want when tuning the thresholds.
+    #define CLOCK_GOVERNOR 1
+    #define CLOCK_GOVERNOR_POINTS { 96000, 125000, 150000, 200000, 250000 }
+    #define CLOCK_GOVERNOR_UP_PERMILLE 600   // Step up when the smoothed load is over 60% of buffer play time.
+    #define CLOCK_GOVERNOR_DOWN_PERMILLE 400 // Step down when the load one point lower would still be under 40%...
+    #define CLOCK_GOVERNOR_HOLD_BUFFERS 25   // ...for this many buffers in a row.
+
+    // I2S sample rate.  Clips are decoded at PLAYER_SAMPLE_RATE (16kHz) and resampled to this.  44100 and 48000 suit
+    // most DACs; set it to 16000 to skip the resampler.
+    #define AUDIO_OUTPUT_RATE 48000
+
+    // Decoded PCM cache for short clips that get replayed a lot (see pcm_cache.h).  It's allocated from the FreeRTOS heap.
+    // Set PCM_CACHE_BUDGET to 0 to turn it off.
+    #define PCM_CACHE_BUDGET (64*1024)      // Bytes.
+    #define PCM_CACHE_ENTRIES 8
+    #define PCM_CACHE_MAX_SAMPLES (2*16000) // Longest clip worth caching.  2s at the decode rate.
+
+    // Opus decoders shared by the player (see decoder_pool.h).  A clip only holds one while it's playing or
+    // pre-rolled, so two per mixer voice never runs out.  Fewer saves ~18K each; queued clips then wait for one.
+    #define DECODER_POOL_SIZE 4
+
+    // Post-processing on the mixed audio (see postproc.h).  POSTPROC_EQ is a list of { type, Hz, Q, dB } biquad
+    // bands, up to POSTPROC_MAX_BIQUADS.  The default pair is a 4th-order Butterworth low cut for small speakers.
+    // POSTPROC_LIMIT is the limiter threshold out of 32767 (29204 is -1dBFS).
+    #define POSTPROC 1
+    #define POSTPROC_EQ { { POSTPROC_HIGHPASS, 150, 0.541f, 0 }, { POSTPROC_HIGHPASS, 150, 1.307f, 0 } }
+    #define POSTPROC_LIMIT 29204
+    #define POSTPROC_LIMIT_RELEASE_MS 50
 
     #define I2S_DATA_PIN 13
     #define I2S_CLOCK_PIN 14
 
+    // Opus scratch arena, used when built with OPUS_SCRATCH_ARENA (the default, see CMakeLists.txt).
+    // OPUS_SCRATCH_PLACEMENT picks the SRAM bank.  Leave it empty for the striped main SRAM, or use
+    // __scratch_x("opus") / __scratch_y("opus") for a small arena in the 4K banks.  Note that those
+    // also hold the core 1 / core 0 stacks.
+    #define OPUS_SCRATCH_PLACEMENT
+
+    // Both of these are sized from a `bench` run over the bench-data assets, whose worst case is the deepest decode.
+    // Put the scratch figure from its total row, and the words used from the "App stack" line after it, into the
+    // _MEASURED defines, and each size becomes that plus its margin.  Until they're measured (0), the arena is 24K
+    // and the app task stack the 16K words it was with alloca().
+    #define OPUS_SCRATCH_MEASURED 0         // Bytes.
+    #define OPUS_SCRATCH_MARGIN 1024
+    #define APP_TASK_STACK_MEASURED 0       // Words.
+    #define APP_TASK_STACK_MARGIN 256       // The task also warns if fewer than this were left.
+#if OPUS_SCRATCH_MEASURED
+    #define OPUS_SCRATCH_SIZE (OPUS_SCRATCH_MEASURED + OPUS_SCRATCH_MARGIN)
+#else
+    #define OPUS_SCRATCH_SIZE (24*1024)
+#endif
+    // App task stack, in words.  With the arena, Opus' temporaries aren't on it, so it needs the player's own frames
+    // plus what opus_decode uses outside the arena.  A measurement only applies to the build it was taken with.
+#if defined(OPUS_SCRATCH_ARENA) && APP_TASK_STACK_MEASURED
+    #define APP_TASK_STACK_SIZE (APP_TASK_STACK_MEASURED + APP_TASK_STACK_MARGIN)
+#else
     #define APP_TASK_STACK_SIZE (16*1024) // Increase this if you're getting HardFaults.
+#endif
     #define APP_TASK_PRIORITY ( tskIDLE_PRIORITY + 3 )
     
     #define USB_TASK_STACK_SIZE ( (3*configMINIMAL_STACK_SIZE/2) * (CFG_TUSB_DEBUG ? 2 : 1) )
     #define USB_TASK_PRIORITY ( tskIDLE_PRIORITY + 2 )
 
-    #define CDC_TASK_STACK_SIZE (configMINIMAL_STACK_SIZE)
+    #define CDC_TASK_STACK_SIZE (2*configMINIMAL_STACK_SIZE) // The console prints from this task.
     #define CDC_TASK_PRIORITY ( tskIDLE_PRIORITY + 1 )
 
     /* A combination of interfaces must have a unique product id, since PC will save device driver after the first plug.
@@ -0,0 +1,115 @@
+/*
+ * FreeRTOS configuration for the simulation (sim/), on the POSIX port.
+ *
+ * It follows the RP2040 one in the root directory wherever the port allows: the same tick rate,
+ * priorities, preemption and time slicing, so the tasks are scheduled the same way.  The
+ * differences are the POSIX port's:
+ *  - One core.  The RP2040 runs the App task and the USB task side by side; here they share one, so
+ *    headroom figures are on the cautious side.
+ *  - Stacks are pthread stacks, so the minimum is PTHREAD_STACK_MIN and overflow checking is off.
+ *  - The heap is malloc (heap_3).
+ */
+
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+#include <stdint.h>
+
+/* Scheduler Related */
+#define configUSE_PREEMPTION                    1
+#define configUSE_TICKLESS_IDLE                 0
+#define configUSE_IDLE_HOOK                     0
+#define configUSE_TICK_HOOK                     0
+#define configTICK_RATE_HZ                      ( ( TickType_t ) 1000 )
+#define configMAX_PRIORITIES                    32
+#define configMINIMAL_STACK_SIZE                ( configSTACK_DEPTH_TYPE ) 4096
+#define configUSE_16_BIT_TICKS                  0
+
+#define configIDLE_SHOULD_YIELD                 1
+
+/* Synchronization Related */
+#define configUSE_MUTEXES                       1
+#define configUSE_RECURSIVE_MUTEXES             1
+#define configUSE_APPLICATION_TASK_TAG          0
+#define configUSE_COUNTING_SEMAPHORES           1
+#define configQUEUE_REGISTRY_SIZE               8
+#define configUSE_QUEUE_SETS                    1
+#define configUSE_TIME_SLICING                  1
+#define configUSE_NEWLIB_REENTRANT              0
+#define configENABLE_BACKWARD_COMPATIBILITY     0
+#define configNUM_THREAD_LOCAL_STORAGE_POINTERS 5
+
+/* System */
+#define configSTACK_DEPTH_TYPE                  uint32_t
+#define configMESSAGE_BUFFER_LENGTH_TYPE        size_t
+
+/* Memory allocation related definitions. */
+#define configSUPPORT_STATIC_ALLOCATION         0
+#define configSUPPORT_DYNAMIC_ALLOCATION        1
+#define configTOTAL_HEAP_SIZE                   (200*1024)
+#define configAPPLICATION_ALLOCATED_HEAP        0
+
+/* Hook function related definitions. */
+#define configCHECK_FOR_STACK_OVERFLOW          0
+#define configUSE_MALLOC_FAILED_HOOK            1
+#define configUSE_DAEMON_TASK_STARTUP_HOOK      0
+
+/* Run time and task stats gathering related definitions. */
+#define configGENERATE_RUN_TIME_STATS           1
+#define configUSE_TRACE_FACILITY                1
+#define configUSE_STATS_FORMATTING_FUNCTIONS    1
+#define configMAX_TASK_NAME_LEN                 16
+#define configRECORD_STACK_HIGH_ADDRESS         1
+/* Co-routine related definitions. */
+#define configUSE_CO_ROUTINES                   0
+#define configMAX_CO_ROUTINE_PRIORITIES         1
+
+/* Software timer related definitions. */
+#define configUSE_TIMERS                        1
+#define configTIMER_TASK_PRIORITY               ( configMAX_PRIORITIES - 1 )
+#define configTIMER_QUEUE_LENGTH                10
+#define configTIMER_TASK_STACK_DEPTH            configMINIMAL_STACK_SIZE
+
+/* One core.  The SMP kernel's name for it, and the one cpu_stats.c uses. */
+#define configNUMBER_OF_CORES                   1
+#define configNUM_CORES                         1
+#define configTICK_CORE                         0
+#define configUSE_CORE_AFFINITY                 0
+
+/* With one core there's nothing to pin to.  clock_governor.c hops to configTICK_CORE, which is here. */
+#define vTaskCoreAffinityGet(xTask)             ( ( void ) ( xTask ), ( UBaseType_t ) 1 )
+#define vTaskCoreAffinitySet(xTask, uxMask)     do { ( void ) ( xTask ); ( void ) ( uxMask ); } while( 0 )
+
+#include <assert.h>
+#define configASSERT(x)                         assert(x)
+
+#define INCLUDE_vTaskPrioritySet                1
+#define INCLUDE_uxTaskPriorityGet               1
+#define INCLUDE_vTaskDelete                     1
+#define INCLUDE_vTaskSuspend                    1
+#define INCLUDE_vTaskDelayUntil                 1
+#define INCLUDE_vTaskDelay                      1
+#define INCLUDE_xTaskGetSchedulerState          1
+#define INCLUDE_xTaskGetCurrentTaskHandle       1
+#define INCLUDE_uxTaskGetStackHighWaterMark     1
+#define INCLUDE_xTaskGetIdleTaskHandle          1
+#define INCLUDE_eTaskGetState                   1
+#define INCLUDE_xTimerPendFunctionCall          1
+#define INCLUDE_xTaskAbortDelay                 1
+#define INCLUDE_xTaskGetHandle                  1
+#define INCLUDE_xTaskResumeFromISR              1
+#define INCLUDE_xQueueGetMutexHolder            1
+
+/* Run time stats count microseconds, as on the RP2040, from the host clock.  cpu_stats.c hooks every
+context switch the same way. */
+#define configRUN_TIME_COUNTER_TYPE             uint64_t
+
+extern void CpuStatsInit(void);
+extern void CpuStatsTaskSwitchedIn(void);
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() CpuStatsInit()
+#define traceTASK_SWITCHED_IN()                 CpuStatsTaskSwitchedIn()
+
+extern uint64_t time_us_64(void);
+#define portGET_RUN_TIME_COUNTER_VALUE() time_us_64()
+
+#endif /* FREERTOS_CONFIG_H */
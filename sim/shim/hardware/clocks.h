@@ -0,0 +1,26 @@
+// Simulation stand-in for hardware/clocks.h.  clk_sys is just a number the clock governor sets;
+// the decode cost model (sim_decode_cost.c) turns cycles into time with it.
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifndef SIM_HARDWARE_CLOCKS_H
+#define SIM_HARDWARE_CLOCKS_H
+
+#define KHZ 1000
+#define MHZ 1000000
+
+#define CLOCKS_CLK_PERI_CTRL_AUXSRC_VALUE_CLKSRC_PLL_USB 2
+#define CLOCKS_CLK_USB_CTRL_AUXSRC_VALUE_CLKSRC_PLL_USB 0
+
+enum clock_index {
+    clk_sys = 5,
+    clk_peri = 6,
+    clk_usb = 7,
+};
+
+uint32_t clock_get_hz (enum clock_index clock);
+bool set_sys_clock_khz (uint32_t khz, bool required);
+bool clock_configure (enum clock_index clock, uint32_t src, uint32_t auxsrc, uint32_t src_freq, uint32_t freq);
+bool check_sys_clock_khz (uint32_t khz, unsigned int * vco, unsigned int * postdiv1, unsigned int * postdiv2);
+
+#endif
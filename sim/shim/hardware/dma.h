@@ -0,0 +1,17 @@
+// Simulation stand-in for hardware/dma.h.  The only channel the firmware touches directly is I2S's,
+// to abort it when parking, and the I2S model (sim_audio_i2s.c) keeps its state.
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifndef SIM_HARDWARE_DMA_H
+#define SIM_HARDWARE_DMA_H
+
+void dma_channel_abort (unsigned int channel);
+
+// The model raises no interrupts, so there's never a flag to clear.
+static inline void dma_irqn_acknowledge_channel (unsigned int irq_index, unsigned int channel) {
+    (void)irq_index;
+    (void)channel;
+}
+
+#endif
@@ -0,0 +1,17 @@
+// Simulation stand-in.  The POSIX port's tick doesn't come from SysTick, so writes are dropped.
+#include <stdint.h>
+
+#ifndef SIM_HARDWARE_STRUCTS_SYSTICK_H
+#define SIM_HARDWARE_STRUCTS_SYSTICK_H
+
+typedef struct {
+    volatile uint32_t csr;
+    volatile uint32_t rvr;
+    volatile uint32_t cvr;
+    volatile uint32_t calib;
+} systick_hw_t;
+
+static systick_hw_t simSystick;
+#define systick_hw (&simSystick)
+
+#endif
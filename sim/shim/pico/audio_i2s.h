@@ -0,0 +1,55 @@
+// Simulation stand-in for pico-extras' audio_i2s.h and the producer pool from audio.h.  The I2S
+// consumer behind it (sim_audio_i2s.c) plays buffers at exactly the sample rate.
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef SIM_PICO_AUDIO_I2S_H
+#define SIM_PICO_AUDIO_I2S_H
+
+#define AUDIO_BUFFER_FORMAT_PCM_S16 1
+#define PICO_AUDIO_I2S_DMA_IRQ 0
+
+typedef struct audio_format {
+    uint32_t sample_freq;
+    uint16_t format;
+    uint16_t channel_count;
+} audio_format_t;
+
+typedef struct audio_buffer_format {
+    const audio_format_t * format;
+    uint16_t sample_stride;
+} audio_buffer_format_t;
+
+typedef struct mem_buffer {
+    size_t size;
+    uint8_t * bytes;
+} mem_buffer_t;
+
+typedef struct audio_buffer {
+    mem_buffer_t * buffer;
+    const audio_buffer_format_t * format;
+    uint32_t sample_count;
+    uint32_t max_sample_count;
+    uint32_t user_data;
+    struct audio_buffer * next;
+} audio_buffer_t;
+
+typedef struct audio_buffer_pool audio_buffer_pool_t;
+
+typedef struct audio_i2s_config {
+    uint8_t data_pin;
+    uint8_t clock_pin_base;
+    uint8_t dma_channel;
+    uint8_t pio_sm;
+} audio_i2s_config_t;
+
+audio_buffer_pool_t * audio_new_producer_pool (audio_buffer_format_t * format, int buffer_count, int buffer_sample_count);
+audio_buffer_t * take_audio_buffer (audio_buffer_pool_t * pool, bool block);
+void give_audio_buffer (audio_buffer_pool_t * pool, audio_buffer_t * buffer);
+void queue_free_audio_buffer (audio_buffer_pool_t * pool, audio_buffer_t * buffer);
+const audio_format_t * audio_i2s_setup (const audio_format_t * intended_audio_format, const audio_i2s_config_t * config);
+bool audio_i2s_connect (audio_buffer_pool_t * producer);
+void audio_i2s_set_enabled (bool enabled);
+
+#endif
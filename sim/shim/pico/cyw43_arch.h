@@ -0,0 +1,12 @@
+// Simulation stand-in for the Pico W's CYW43 driver.  The LED is all the app uses, and there isn't one.
+#include <stdbool.h>
+
+#ifndef SIM_PICO_CYW43_ARCH_H
+#define SIM_PICO_CYW43_ARCH_H
+
+#define CYW43_WL_GPIO_LED_PIN 0
+
+static inline int cyw43_arch_init (void) { return 0; }
+static inline void cyw43_arch_gpio_put (unsigned int pin, bool value) { (void)pin; (void)value; }
+
+#endif
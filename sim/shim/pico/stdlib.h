@@ -0,0 +1,43 @@
+// Simulation stand-in for pico/stdlib.h.  Time is the host's monotonic clock, counted from start-up
+// the way the RP2040 timer counts from boot (sim_hardware.c).
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "pico/platform.h"
+
+#ifndef SIM_PICO_STDLIB_H
+#define SIM_PICO_STDLIB_H
+
+#define GPIO_OUT 1
+
+typedef uint64_t absolute_time_t;
+
+uint64_t time_us_64 (void);
+void stdio_init_all (void);
+
+static inline uint32_t time_us_32 (void) {
+    return (uint32_t)time_us_64();
+}
+
+static inline absolute_time_t get_absolute_time (void) {
+    return time_us_64();
+}
+
+static inline uint64_t to_us_since_boot (absolute_time_t t) {
+    return t;
+}
+
+static inline absolute_time_t make_timeout_time_ms (uint32_t ms) {
+    return time_us_64() + (uint64_t)ms * 1000;
+}
+
+static inline int64_t absolute_time_diff_us (absolute_time_t from, absolute_time_t to) {
+    return (int64_t)(to - from);
+}
+
+static inline void gpio_init (uint gpio) { (void)gpio; }
+static inline void gpio_set_dir (uint gpio, bool out) { (void)gpio; (void)out; }
+static inline void gpio_put (uint gpio, bool value) { (void)gpio; (void)value; }
+
+#endif
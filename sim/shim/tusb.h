@@ -0,0 +1,18 @@
+// Simulation stand-in for the TinyUSB device calls the USB and CDC tasks make.  sim_usb.c models the
+// USB task's load, and feeds the console the commands given with -e as if they'd been typed.
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifndef SIM_TUSB_H
+#define SIM_TUSB_H
+
+#define BOARD_TUD_RHPORT 0
+#define CFG_TUSB_DEBUG 0
+
+bool tud_init (uint8_t rhport);
+void tud_task (void);
+uint32_t tud_cdc_available (void);
+uint32_t tud_cdc_read (void * buffer, uint32_t length);
+uint32_t tud_cdc_write_flush (void);
+
+#endif
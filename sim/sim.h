@@ -0,0 +1,48 @@
+// Simulation Header File
+// Runs the firmware's tasks (main.c) on the FreeRTOS POSIX port, in real time, against a model of
+// the hardware: an I2S consumer that drains buffers at exactly the sample rate (sim_audio_i2s.c), a
+// decode cost scaled to target cycles at the governor's clock (sim_decode_cost.c), and a USB stack
+// that takes its share of the CPU and types console commands on cue (sim_usb.c).
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifndef SIM_H
+#define SIM_H
+
+#define SIM_MAX_COMMANDS 32
+#define SIM_SILENCE_SAMPLES 256        // What pico-extras' I2S plays when it has nothing queued.
+
+// What the decode costs on the target, in thousands of cycles per 20ms of audio, by Opus mode.
+// Take them from `bench` on the Pico (cyc/pkt, scaled to 20ms).  The defaults are only a guess.
+#define SIM_SILK_KCYCLES 700
+#define SIM_HYBRID_KCYCLES 1600
+#define SIM_CELT_KCYCLES 1800
+#define SIM_PLC_KCYCLES 500
+
+typedef struct {
+    uint32_t AtMs;
+    const char * Line;
+} simCommand_t;
+
+typedef struct {
+    uint32_t DurationMs;
+    int BufferCount;                    // 0 for AUDIO_OUT_BUFFER_COUNT.
+    int AppPriority;                    // -1 for what settings.h says.
+    int UsbPriority;
+    int CdcPriority;
+    uint32_t Kcycles[4];                // SILK, hybrid, CELT, then concealment.
+    double HostScale;                   // If set, decode costs this times the host's own decode time instead.
+    uint32_t UsbLoadUs;                 // Busy time per 1ms USB frame.
+    simCommand_t Commands[SIM_MAX_COMMANDS];
+    int CommandCount;
+    bool FailOnUnderrun;
+} simOptions_t;
+
+extern simOptions_t SimOptions;
+
+void SimI2sPrint (void);
+uint32_t SimI2sStarvedCount (void);
+uint32_t SimI2sRearmFaults (void);
+void SimDecodeCostPrint (void);
+
+#endif
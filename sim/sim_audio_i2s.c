@@ -0,0 +1,254 @@
+// The I2S consumer, modelled.  On the Pico a DMA interrupt takes the next queued buffer each time
+// the last finishes, and plays a short silence buffer if there's none, so it never stops.  Here the
+// same timeline is worked out from the clock whenever the producer takes or gives a buffer: every
+// buffer plays for exactly its samples at the sample rate, back to back.
+// Disabling I2S leaves the DMA channel part way through its transfer, as pico-extras does.  Enabling
+// it again before the channel is aborted plays out the rest of that transfer first, so the first
+// buffer after a re-arm starts late; aborting a channel that holds a real buffer loses the buffer.
+// Both are counted, and -f fails on them.
+#include <stdio.h>
+#include <stdlib.h>
+#include "pico/stdlib.h"
+#include "pico/audio_i2s.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "sim.h"
+
+#define SIM_MAX_BUFFERS 16
+
+struct audio_buffer_pool {
+    audio_buffer_t * Free;
+    audio_buffer_t * QueueHead;
+    audio_buffer_t * QueueTail;
+};
+
+static audio_buffer_pool_t producerPool;
+static audio_buffer_t buffers[SIM_MAX_BUFFERS];
+static mem_buffer_t memBuffers[SIM_MAX_BUFFERS];
+static uint64_t givenAt[SIM_MAX_BUFFERS];
+static int bufferCount = 0;
+static uint32_t sampleRate = 0;
+
+static bool enabled = false;
+static audio_buffer_t * playing = NULL;    // NULL while playing silence.
+static uint64_t timelineStart = 0;         // When I2S was enabled.
+static uint64_t timelineSamples = 0;       // Samples played or being played since then.
+static uint64_t playingEnd = 0;            // When the current buffer or silence runs out.
+static bool stalled = false;               // Disabled with a transfer part done.
+static uint64_t stalledSamples = 0;        // What that transfer had left.
+static uint32_t stops = 0;
+static uint32_t staleRearms = 0;           // Re-armed with the channel still stalled.
+static uint32_t lostBuffers = 0;           // Aborted mid-buffer.
+
+// A starved gap is silence between two buffers while I2S is running.  Silence that ends with I2S
+// being parked was the producer's choice, so it isn't counted.
+static bool starving = false;
+static uint64_t starvingSince = 0;
+static uint32_t buffersPlayed = 0;
+static uint32_t starvedGaps = 0;
+static uint64_t starvedTotalUs = 0;
+static uint32_t starvedMaxUs = 0;
+static uint64_t latencyTotalUs = 0;
+static uint32_t latencyMaxUs = 0;
+
+
+static uint64_t TimelineUs (uint64_t samples) {
+    return timelineStart + samples * 1000000 / sampleRate;
+}
+
+
+// Play everything that would have finished by now, starting whatever comes next.
+static void Advance (uint64_t now) {
+    audio_buffer_t * next;
+    uint32_t gapUs;
+
+    while (enabled && playingEnd <= now) {
+        if (playing != NULL) {
+            playing->next = producerPool.Free;
+            producerPool.Free = playing;
+            playing = NULL;
+            buffersPlayed++;
+        }
+
+        next = producerPool.QueueHead;
+        if (next != NULL) {
+            producerPool.QueueHead = next->next;
+            if (producerPool.QueueHead == NULL)
+                producerPool.QueueTail = NULL;
+            if (starving) {
+                gapUs = (uint32_t)(playingEnd - starvingSince);
+                starvedGaps++;
+                starvedTotalUs += gapUs;
+                if (gapUs > starvedMaxUs)
+                    starvedMaxUs = gapUs;
+                starving = false;
+            }
+            gapUs = (uint32_t)(playingEnd - givenAt[next - buffers]);
+            latencyTotalUs += gapUs;
+            if (gapUs > latencyMaxUs)
+                latencyMaxUs = gapUs;
+            playing = next;
+            timelineSamples += next->sample_count;
+        } else {
+            if (!starving && buffersPlayed) {
+                starving = true;
+                starvingSince = playingEnd;
+            }
+            timelineSamples += SIM_SILENCE_SAMPLES;
+        }
+        playingEnd = TimelineUs(timelineSamples);
+    }
+}
+
+
+audio_buffer_pool_t * audio_new_producer_pool (audio_buffer_format_t * format, int buffer_count, int buffer_sample_count) {
+    int i;
+
+    if (SimOptions.BufferCount)
+        buffer_count = SimOptions.BufferCount;
+    if (buffer_count > SIM_MAX_BUFFERS)
+        panic("Sim: at most %d audio buffers.\n", SIM_MAX_BUFFERS);
+
+    for (i = 0; i < buffer_count; i++) {
+        memBuffers[i].size = (size_t)buffer_sample_count * format->sample_stride;
+        memBuffers[i].bytes = malloc(memBuffers[i].size);
+        buffers[i].buffer = &memBuffers[i];
+        buffers[i].format = format;
+        buffers[i].max_sample_count = (uint32_t)buffer_sample_count;
+        buffers[i].next = producerPool.Free;
+        producerPool.Free = &buffers[i];
+    }
+    bufferCount = buffer_count;
+    sampleRate = format->format->sample_freq;
+    return &producerPool;
+}
+
+
+// Blocks by sleeping until the buffer playing now is due to finish, where pico-extras would spin.
+// Spinning here would starve the USB task, which on the Pico has the other core to itself.
+audio_buffer_t * take_audio_buffer (audio_buffer_pool_t * pool, bool block) {
+    audio_buffer_t * buffer;
+    uint64_t now;
+
+    while (1) {
+        taskENTER_CRITICAL();
+        now = time_us_64();
+        Advance(now);
+        buffer = pool->Free;
+        if (buffer != NULL)
+            pool->Free = buffer->next;
+        taskEXIT_CRITICAL();
+
+        if (buffer != NULL || !block)
+            return buffer;
+        vTaskDelay(enabled && playingEnd > now ? (TickType_t)((playingEnd - now + 999) / 1000) : 1);
+    }
+}
+
+
+void give_audio_buffer (audio_buffer_pool_t * pool, audio_buffer_t * buffer) {
+    taskENTER_CRITICAL();
+    Advance(time_us_64());
+    givenAt[buffer - buffers] = time_us_64();
+    buffer->next = NULL;
+    if (pool->QueueTail != NULL)
+        pool->QueueTail->next = buffer;
+    else
+        pool->QueueHead = buffer;
+    pool->QueueTail = buffer;
+    taskEXIT_CRITICAL();
+}
+
+
+void queue_free_audio_buffer (audio_buffer_pool_t * pool, audio_buffer_t * buffer) {
+    taskENTER_CRITICAL();
+    buffer->next = pool->Free;
+    pool->Free = buffer;
+    taskEXIT_CRITICAL();
+}
+
+
+const audio_format_t * audio_i2s_setup (const audio_format_t * intended_audio_format, const audio_i2s_config_t * config) {
+    (void)config;
+    return intended_audio_format;
+}
+
+
+bool audio_i2s_connect (audio_buffer_pool_t * producer) {
+    (void)producer;
+    return true;
+}
+
+
+// Stopping leaves the transfer where it is.  Starting again on a stalled channel finishes that
+// transfer before anything newly queued.
+void audio_i2s_set_enabled (bool enable) {
+    uint64_t now;
+
+    taskENTER_CRITICAL();
+    now = time_us_64();
+    Advance(now);
+    if (enable && !enabled) {
+        timelineStart = now;
+        timelineSamples = 0;
+        if (stalled) {
+            staleRearms++;
+            timelineSamples = stalledSamples;
+            stalled = false;
+        }
+        playingEnd = TimelineUs(timelineSamples);
+    } else if (!enable && enabled) {
+        stops++;
+        stalled = true;
+        stalledSamples = playingEnd > now ? (playingEnd - now) * sampleRate / 1000000 : 0;
+        starving = false;
+    }
+    enabled = enable;
+    taskEXIT_CRITICAL();
+}
+
+
+// Stops the channel for good.  pico-extras never gets a buffer back that was playing, since its
+// completion interrupt doesn't come.
+void dma_channel_abort (unsigned int channel) {
+    (void)channel;
+    taskENTER_CRITICAL();
+    Advance(time_us_64());
+    if (playing != NULL && (enabled || stalled))
+        lostBuffers++;
+    playing = NULL;
+    stalled = false;
+    if (enabled)
+        playingEnd = timelineStart = time_us_64();
+    timelineSamples = 0;
+    taskEXIT_CRITICAL();
+}
+
+
+uint32_t SimI2sStarvedCount (void) {
+    return starvedGaps;
+}
+
+
+// Re-arms that didn't start clean, and buffers lost to aborts.
+uint32_t SimI2sRearmFaults (void) {
+    return staleRearms + lostBuffers;
+}
+
+
+void SimI2sPrint (void) {
+    taskENTER_CRITICAL();
+    Advance(time_us_64());
+    taskEXIT_CRITICAL();
+
+    printf("I2S: %d buffers of %u samples at %u Hz.  %u played, %u starved gaps (%u us total, longest %u us).\r\n",
+           bufferCount, bufferCount ? (unsigned)buffers[0].max_sample_count : 0, (unsigned)sampleRate,
+           (unsigned)buffersPlayed, (unsigned)starvedGaps, (unsigned)starvedTotalUs, (unsigned)starvedMaxUs);
+    if (buffersPlayed)
+        printf("I2S: queued %u us on average before playing, %u us at most.\r\n",
+               (unsigned)(latencyTotalUs / buffersPlayed), (unsigned)latencyMaxUs);
+    printf("I2S: stopped %u times.  %u re-arms found the DMA still mid-transfer, %u buffers lost to aborts.\r\n",
+           (unsigned)stops, (unsigned)staleRearms, (unsigned)lostBuffers);
+}
@@ -0,0 +1,59 @@
+// Makes opus_decode take as long as it would on the Pico.  The link wraps it (--wrap=opus_decode), so
+// every call the player and bench make comes here first.  The real decode runs, then we busy-wait
+// until the packet has used up its target cycles at the clock the governor has set: the cycles per
+// 20ms for its Opus mode from SimOptions, scaled to the samples it decoded.  With -s the target is
+// the host's own decode time times a scale factor instead, which keeps the variation between packets.
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "hardware/clocks.h"
+
+#include "opus.h"
+#include "decode_stats.h"
+#include "sim.h"
+
+#define SIM_PLC 3
+
+int __real_opus_decode (OpusDecoder * st, const unsigned char * data, opus_int32 len, opus_int16 * pcm, int frame_size, int decode_fec);
+
+static uint32_t calls[4];
+static uint64_t hostUs[4];
+static uint64_t targetUs[4];
+
+
+int __wrap_opus_decode (OpusDecoder * st, const unsigned char * data, opus_int32 len, opus_int16 * pcm, int frame_size, int decode_fec) {
+    uint64_t start = time_us_64(), target;
+    opus_int32 rate = 48000;
+    int samples, mode;
+
+    samples = __real_opus_decode(st, data, len, pcm, frame_size, decode_fec);
+    if (samples <= 0)
+        return samples;
+
+    mode = data != NULL && len > 0 ? DecodeStatsMode(data) : SIM_PLC;
+    if (SimOptions.HostScale > 0) {
+        target = (uint64_t)((double)(time_us_64() - start) * SimOptions.HostScale);
+    } else {
+        opus_decoder_ctl(st, OPUS_GET_SAMPLE_RATE(&rate));
+        // kcycles per 20ms * 1000 * (samples / (rate / 50)) / MHz.
+        target = (uint64_t)SimOptions.Kcycles[mode] * 1000 * 50 * (uint64_t)samples / (uint64_t)rate
+                 / (clock_get_hz(clk_sys) / MHZ);
+    }
+
+    calls[mode]++;
+    hostUs[mode] += time_us_64() - start;
+    targetUs[mode] += target;
+    while (time_us_64() - start < target)
+        ;
+    return samples;
+}
+
+
+void SimDecodeCostPrint (void) {
+    static const char * const names[4] = { "SILK", "Hybrid", "CELT", "PLC" };
+    int i;
+
+    for (i = 0; i < 4; i++)
+        if (calls[i])
+            printf("Decode cost: %-6s %6u calls, host %5u us, target %5u us per call.\r\n", names[i], (unsigned)calls[i],
+                   (unsigned)(hostUs[i] / calls[i]), (unsigned)(targetUs[i] / calls[i]));
+}
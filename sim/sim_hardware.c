@@ -0,0 +1,69 @@
+// The few RP2040 calls the firmware makes that the simulation has to answer: the microsecond timer,
+// and a system clock that's only a number for the decode cost model to read.
+#include <stdio.h>
+#include <time.h>
+#include "pico/stdlib.h"
+#include "hardware/clocks.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+static uint64_t startUs = 0;
+static uint32_t sysKhz = 125000;       // What the boot ROM leaves it at.
+
+
+static uint64_t MonotonicUs (void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000 + (uint64_t)now.tv_nsec / 1000;
+}
+
+
+// Counts from the first call, which is before the scheduler starts, the way the timer counts from boot.
+uint64_t time_us_64 (void) {
+    if (startUs == 0)
+        startUs = MonotonicUs();
+    return MonotonicUs() - startUs;
+}
+
+
+void stdio_init_all (void) {
+    setvbuf(stdout, NULL, _IOLBF, 0);
+}
+
+
+uint32_t clock_get_hz (enum clock_index clock) {
+    return clock == clk_sys ? sysKhz * KHZ : 48 * MHZ;
+}
+
+
+// Any clock the governor asks for can be had.  On the Pico it only asks for ones the PLL can hit.
+bool check_sys_clock_khz (uint32_t khz, unsigned int * vco, unsigned int * postdiv1, unsigned int * postdiv2) {
+    *vco = khz * KHZ * 6;
+    *postdiv1 = 6;
+    *postdiv2 = 1;
+    return true;
+}
+
+
+bool set_sys_clock_khz (uint32_t khz, bool required) {
+    (void)required;
+    sysKhz = khz;
+    return true;
+}
+
+
+// Only clk_sys is modelled.  Everything else stays at 48MHz, which is all the governor sets it to.
+bool clock_configure (enum clock_index clock, uint32_t src, uint32_t auxsrc, uint32_t src_freq, uint32_t freq) {
+    (void)clock;
+    (void)src;
+    (void)auxsrc;
+    (void)src_freq;
+    (void)freq;
+    return true;
+}
+
+
+void vApplicationMallocFailedHook (void) {
+    panic("Sim: out of FreeRTOS heap.\n");
+}
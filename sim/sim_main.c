@@ -0,0 +1,172 @@
+/**
+ * PicoPlayOpus simulation
+ * Runs the firmware's own tasks (App_Init in main.c) on the FreeRTOS POSIX port, in real time, against
+ * the models in sim.h, then reports what the console would: underruns, decode timing, CPU use per task
+ * and the clock governor, plus what the modelled I2S consumer saw.  Everything that matters for
+ * scheduling can be changed from the command line, so a script can sweep buffer counts, priorities
+ * and decode costs without rebuilding.
+ *
+ * The POSIX port runs one task at a time, so this is the Pico with everything on one core.
+ *
+ * Time is the host's wall clock: the tick is a host timer and the decode cost is a busy-wait.  Other
+ * load on the host stretches both, so the same run can starve on a busy machine and not on a quiet
+ * one.  That makes -f a check to run by hand on an idle host, not a CI gate.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "pico/stdlib.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "audio_out.h"
+#include "clock_governor.h"
+#include "cpu_stats.h"
+#include "decode_stats.h"
+#include "sim.h"
+
+void App_Init (void);
+
+// By default the sample plays from 1s to about 10s, I2S parks, and it's played again, so every run
+// goes through a park and a re-arm.
+simOptions_t SimOptions = {
+    .DurationMs = 14000,
+    .AppPriority = -1,
+    .UsbPriority = -1,
+    .CdcPriority = -1,
+    .Kcycles = { SIM_SILK_KCYCLES, SIM_HYBRID_KCYCLES, SIM_CELT_KCYCLES, SIM_PLC_KCYCLES },
+    .Commands = { { 11500, "play" } },
+    .CommandCount = 1,
+};
+
+
+static void Usage (const char * name) {
+    fprintf(stderr, "Usage: %s [-d seconds] [-b buffers] [-p app=N,usb=N,cdc=N] [-c silk=K,hybrid=K,celt=K,plc=K]\n"
+                    "       %*s [-s scale] [-u us] [-e ms:command ...] [-f]\n"
+                    "  -d  How long to run for (default %u s).\n"
+                    "  -b  I2S buffers in the producer pool, instead of AUDIO_OUT_BUFFER_COUNT.\n"
+                    "  -p  Task priorities, instead of the ones in settings.h.\n"
+                    "  -c  Decode cost on the Pico, in thousands of cycles per 20ms, by Opus mode.\n"
+                    "  -s  Make the decode cost this many times the host's own decode time instead.\n"
+                    "  -u  Microseconds of CPU the USB task uses every 1ms frame.\n"
+                    "  -e  Type a console command at a time in milliseconds, e.g. -e \"2000:play 0\".\n"
+                    "      Any -e replaces the default replay at 11.5 s.\n"
+                    "  -f  Exit with status 1 if the I2S consumer was ever starved, or a re-arm after\n"
+                    "      parking didn't start clean.  This runs on the wall clock, so host load can\n"
+                    "      starve it too: use an idle machine.\n",
+            name, (int)strlen(name), "", (unsigned)(SimOptions.DurationMs / 1000));
+    exit(2);
+}
+
+
+// Parse "name=value,name=value", setting the values whose names are given.
+static void ParsePairs (const char * name, char * text, const char * const * keys, int keyCount, int32_t * values) {
+    char * pair, * equals;
+    int i;
+
+    for (pair = strtok(text, ","); pair != NULL; pair = strtok(NULL, ",")) {
+        equals = strchr(pair, '=');
+        if (equals == NULL)
+            Usage(name);
+        *equals = '\0';
+        for (i = 0; i < keyCount && strcmp(pair, keys[i]) != 0; i++)
+            ;
+        if (i == keyCount)
+            Usage(name);
+        values[i] = atoi(equals + 1);
+    }
+}
+
+
+static void SetPriority (const char * taskName, int priority) {
+    TaskHandle_t task = xTaskGetHandle(taskName);
+
+    if (priority >= 0 && task != NULL)
+        vTaskPrioritySet(task, (UBaseType_t)priority);
+}
+
+
+// Runs above everything else, so the report comes out on time however busy the other tasks are.
+static void Report_Task (void * argument) {
+    uint32_t starved, rearmFaults;
+    (void)argument;
+
+    vTaskDelay(pdMS_TO_TICKS(SimOptions.DurationMs));
+
+    printf("\r\n--- %u ms simulated ---\r\n", (unsigned)SimOptions.DurationMs);
+    AudioOutPrintUnderruns();
+    DecodeStatsPrint();
+    CpuStatsPrint();
+    ClockGovernorPrint();
+    SimI2sPrint();
+    SimDecodeCostPrint();
+    fflush(stdout);
+
+    starved = SimI2sStarvedCount();
+    rearmFaults = SimI2sRearmFaults();
+    exit(SimOptions.FailOnUnderrun && (starved || rearmFaults) ? 1 : 0);
+}
+
+
+int main (int argc, char ** argv) {
+    static const char * const priorityKeys[] = { "app", "usb", "cdc" };
+    static const char * const costKeys[] = { "silk", "hybrid", "celt", "plc" };
+    int32_t values[4];
+    char * colon;
+    int option, i;
+    bool defaultCommands = true;
+
+    while ((option = getopt(argc, argv, "d:b:p:c:s:u:e:f")) != -1) {
+        switch (option) {
+            case 'd': SimOptions.DurationMs = (uint32_t)(atof(optarg) * 1000); break;
+            case 'b': SimOptions.BufferCount = atoi(optarg); break;
+            case 'p':
+                values[0] = SimOptions.AppPriority;
+                values[1] = SimOptions.UsbPriority;
+                values[2] = SimOptions.CdcPriority;
+                ParsePairs(argv[0], optarg, priorityKeys, 3, values);
+                SimOptions.AppPriority = values[0];
+                SimOptions.UsbPriority = values[1];
+                SimOptions.CdcPriority = values[2];
+                break;
+            case 'c':
+                for (i = 0; i < 4; i++)
+                    values[i] = (int32_t)SimOptions.Kcycles[i];
+                ParsePairs(argv[0], optarg, costKeys, 4, values);
+                for (i = 0; i < 4; i++)
+                    SimOptions.Kcycles[i] = (uint32_t)values[i];
+                break;
+            case 's': SimOptions.HostScale = atof(optarg); break;
+            case 'u': SimOptions.UsbLoadUs = (uint32_t)atoi(optarg); break;
+            case 'e':
+                colon = strchr(optarg, ':');
+                if (colon == NULL || SimOptions.CommandCount == SIM_MAX_COMMANDS)
+                    Usage(argv[0]);
+                *colon = '\0';
+                if (defaultCommands) {
+                    SimOptions.CommandCount = 0;
+                    defaultCommands = false;
+                }
+                SimOptions.Commands[SimOptions.CommandCount].AtMs = (uint32_t)atoi(optarg);
+                SimOptions.Commands[SimOptions.CommandCount++].Line = colon + 1;
+                break;
+            case 'f': SimOptions.FailOnUnderrun = true; break;
+            default: Usage(argv[0]);
+        }
+    }
+    if (optind != argc || SimOptions.DurationMs == 0 || SimOptions.BufferCount < 0)
+        Usage(argv[0]);
+
+    time_us_64();   // Start the clock.
+    App_Init();
+    SetPriority("App", SimOptions.AppPriority);
+    SetPriority("USB", SimOptions.UsbPriority);
+    SetPriority("CDC", SimOptions.CdcPriority);
+    xTaskCreate(Report_Task, "Report", configMINIMAL_STACK_SIZE, NULL, configMAX_PRIORITIES - 1, NULL);
+
+    vTaskStartScheduler();
+    panic("Sim: the scheduler stopped.\n");
+    return 1;
+}
@@ -0,0 +1,65 @@
+// The USB stack, as far as the rest of the firmware can tell.  tud_task() waits for the next 1ms frame
+// and then keeps the CPU busy for SimOptions.UsbLoadUs, and the CDC port "receives" each -e command
+// once the simulation clock reaches its time.  Output goes straight to stdout.
+#include <string.h>
+#include "pico/stdlib.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "tusb.h"
+
+#include "sim.h"
+
+static int nextCommand = 0;
+static const char * pending = NULL;    // What's left of the command being typed, then its "\r".
+static bool pendingReturn = false;
+
+
+bool tud_init (uint8_t rhport) {
+    (void)rhport;
+    return true;
+}
+
+
+void tud_task (void) {
+    uint64_t start;
+
+    vTaskDelay(1);
+    start = time_us_64();
+    while (time_us_64() - start < SimOptions.UsbLoadUs)
+        ;
+}
+
+
+uint32_t tud_cdc_available (void) {
+    if (pending == NULL && !pendingReturn && nextCommand < SimOptions.CommandCount &&
+        time_us_64() >= (uint64_t)SimOptions.Commands[nextCommand].AtMs * 1000) {
+        pending = SimOptions.Commands[nextCommand++].Line;
+        pendingReturn = true;
+    }
+    return (pending != NULL ? (uint32_t)strlen(pending) : 0) + (pendingReturn ? 1 : 0);
+}
+
+
+uint32_t tud_cdc_read (void * buffer, uint32_t length) {
+    uint32_t count = 0, available = tud_cdc_available();
+    char * out = buffer;
+
+    if (length > available)
+        length = available;
+    while (count < length) {
+        if (pending != NULL && *pending != '\0') {
+            out[count++] = *pending++;
+        } else {
+            out[count++] = '\r';
+            pending = NULL;
+            pendingReturn = false;
+        }
+    }
+    return count;
+}
+
+
+uint32_t tud_cdc_write_flush (void) {
+    return 0;
+}
@@ -0,0 +1,164 @@
+#!/usr/bin/env python3
+"""Check that the decoded audio hasn't changed, before and after optimising a hot path.
+
+Uses the host build (host/CMakeLists.txt), which compiles Opus from opus_codec.cmake with the same
+definitions as the firmware.  That includes the M0+ multiply macros: a 64-bit host would use Opus'
+64-bit ones, so the build forces them with OPUS_M0PLUS_FORCE.  Configure it with
+-DOPUS_SCRATCH_ARENA=OFF for the USE_ALLOCA build.
+
+  record   Play each clip of the corpus through the player pipeline (ogg_stripper, Opus, mixer,
+           post-processing, resampler) and store a hash of the PCM in the golden file.  Do this
+           on a build you trust, and commit the file.
+  check    Play the corpus again and compare against the golden file.  Exits non-zero if any
+           clip's output has changed by even one bit, or if there's no golden file yet.
+  compact  Convert each clip of the corpus to a compact stream (opus_compact.py) and play both.
+           They must decode to the same PCM.
+  vectors  Decode the official Opus test vectors (https://opus-codec.org/testvectors/) with -t.
+           Every packet's final range coder state must match the encoder's.  Given opus_compare
+           (built from the Opus sources) the output is also checked against the mono reference
+           decodes (testvectorNNm.dec) at the player's rate.
+
+The corpus defaults to ogg-data/*.ogg and bench-data/*.opus (see make_bench_assets.py).
+
+Usage: python3 tools/conformance.py record|check|compact [--host build-host/PicoPlayOpusHost] [clip ...]
+       python3 tools/conformance.py vectors DIR [--host ...] [--opus-compare PATH] [--rate 16000]
+"""
+import argparse
+import glob
+import os
+import re
+import subprocess
+import sys
+import tempfile
+
+ROOT = os.path.normpath(os.path.join(os.path.dirname(os.path.abspath(__file__)), ".."))
+GOLDEN = os.path.join(ROOT, "conformance", "golden.txt")
+PCM_LINE = re.compile(r"^PCM: (\d+) samples, hash ([0-9a-f]{16})\.$", re.MULTILINE)
+
+
+def corpus(clips):
+    if clips:
+        return clips
+    return sorted(glob.glob(os.path.join(ROOT, "ogg-data", "*.ogg"))) + \
+        sorted(glob.glob(os.path.join(ROOT, "bench-data", "*.opus")))
+
+
+def play(host, clip):
+    """(samples, hash) of one clip through the player pipeline."""
+    result = subprocess.run([host, "-n", clip], capture_output=True, text=True)
+    match = PCM_LINE.search(result.stdout)
+    if result.returncode != 0 or match is None:
+        sys.exit("%s failed on %s:\n%s" % (host, clip, result.stderr))
+    return int(match.group(1)), match.group(2)
+
+
+def read_golden():
+    if not os.path.exists(GOLDEN):
+        sys.exit("No golden file at %s.  Run `record` on a build you trust and commit what it writes first."
+                 % os.path.relpath(GOLDEN, ROOT))
+    golden = {}
+    with open(GOLDEN) as f:
+        for line in f:
+            if line.strip() and not line.startswith("#"):
+                digest, samples, clip = line.split(None, 2)
+                golden[clip.strip()] = (int(samples), digest)
+    return golden
+
+
+def record(host, clips):
+    os.makedirs(os.path.dirname(GOLDEN), exist_ok=True)
+    with open(GOLDEN, "w") as f:
+        f.write("# PCM hash, samples and clip, from tools/conformance.py record.\n")
+        for clip in corpus(clips):
+            samples, digest = play(host, clip)
+            f.write("%s %d %s\n" % (digest, samples, os.path.relpath(clip, ROOT)))
+            print("%s %8d %s" % (digest, samples, clip))
+    return 0
+
+
+def check(host, clips):
+    golden = read_golden()
+    failed = 0
+    for clip in corpus(clips) if clips else [os.path.join(ROOT, c) for c in golden]:
+        name = os.path.relpath(clip, ROOT)
+        if name not in golden:
+            print("NEW   %s (not in the golden file)" % name)
+            continue
+        samples, digest = play(host, clip)
+        if (samples, digest) == golden[name]:
+            print("OK    %s" % name)
+        else:
+            print("FAIL  %s: %d samples, hash %s; expected %d, %s" % ((name, samples, digest) + golden[name]))
+            failed += 1
+    print("%d of %d clips changed." % (failed, len(golden)))
+    return 1 if failed else 0
+
+
+def compact(host, clips):
+    sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+    import opus_compact
+    failed = 0
+    clips = corpus(clips)
+    with tempfile.TemporaryDirectory() as temp:
+        for clip in clips:
+            with open(clip, "rb") as f:
+                data, _ = opus_compact.convert(f.read(), name=clip)
+            out = os.path.join(temp, "clip.opk")
+            with open(out, "wb") as f:
+                f.write(data)
+            ogg, opk = play(host, clip), play(host, out)
+            if ogg == opk:
+                print("OK    %s" % os.path.relpath(clip, ROOT))
+            else:
+                print("FAIL  %s: %d samples, hash %s from Ogg; %d, %s compact" % ((os.path.relpath(clip, ROOT),) + ogg + opk))
+                failed += 1
+    print("%d of %d clips differ." % (failed, len(clips)))
+    return 1 if failed else 0
+
+
+def vectors(host, directory, opus_compare, rate):
+    bits = sorted(glob.glob(os.path.join(directory, "testvector*.bit")))
+    if not bits:
+        sys.exit("No testvector*.bit in %s." % directory)
+    failed = 0
+    with tempfile.TemporaryDirectory() as temp:
+        for bit in bits:
+            out = os.path.join(temp, "out.pcm")
+            result = subprocess.run([host, "-t", "-R", str(rate), "-o", out, bit], capture_output=True, text=True)
+            status = "OK" if result.returncode == 0 else "FAIL"
+            detail = (result.stdout + result.stderr).strip().splitlines()[0]
+            reference = bit[:-len(".bit")] + "m.dec"
+            if result.returncode == 0 and opus_compare and os.path.exists(reference):
+                compare = subprocess.run([opus_compare, "-r", str(rate), reference, out], capture_output=True, text=True)
+                if compare.returncode != 0:
+                    status = "FAIL"
+                detail += "  " + (compare.stdout + compare.stderr).strip().splitlines()[-1]
+            if status != "OK":
+                failed += 1
+            print("%-4s  %s" % (status, detail))
+    print("%d of %d vectors failed." % (failed, len(bits)))
+    return 1 if failed else 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("command", choices=("record", "check", "compact", "vectors"))
+    parser.add_argument("paths", nargs="*", help="clips, or for vectors the test vector directory")
+    parser.add_argument("--host", default=os.path.join(ROOT, "build-host", "PicoPlayOpusHost"))
+    parser.add_argument("--opus-compare", help="opus_compare, to check test vector output against the references")
+    parser.add_argument("--rate", type=int, default=16000, help="rate to decode test vectors at")
+    args = parser.parse_args()
+
+    if args.command == "record":
+        return record(args.host, args.paths)
+    if args.command == "check":
+        return check(args.host, args.paths)
+    if args.command == "compact":
+        return compact(args.host, args.paths)
+    if len(args.paths) != 1:
+        parser.error("vectors takes the directory holding the test vectors")
+    return vectors(args.host, args.paths[0], args.opus_compare, args.rate)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,71 @@
+#!/usr/bin/env python3
+"""Generate resampler_tables.c, the polyphase filter tables used by resampler.c.
+
+Each table is one windowed-sinc low-pass filter, cut off just below the input Nyquist, sampled at
+PHASES points per input sample and split into PHASES rows of TAPS coefficients.  Row p is the
+filter for an output that falls p/PHASES of the way between two input samples.
+
+    12 phases covers 8/12/16/24 kHz to 48 kHz (x6, x4, x3, x2).
+    441 phases covers 8/12/16/24 kHz to 44.1 kHz (x441/80, x147/40, x441/160, x147/80).
+
+Every row is rounded to Q15 and then nudged so it sums to exactly 1.0, so DC passes unchanged.
+
+Usage: python3 tools/gen_resampler_tables.py > resampler_tables.c
+"""
+import datetime
+import math
+
+TAPS = 16
+CUTOFF = 0.9    # Fraction of the input Nyquist.
+BETA = 7.0      # Kaiser window shape.  Higher trades transition width for stop-band depth.
+TABLES = (12, 441)
+
+
+def bessel_i0(x):
+    total, term, k = 1.0, 1.0, 1
+    while term > 1e-12 * total:
+        term *= (x / (2 * k)) ** 2
+        total += term
+        k += 1
+    return total
+
+
+def kernel(t):
+    """The continuous filter at t input samples from its centre."""
+    half = TAPS / 2
+    if abs(t) >= half:
+        return 0.0
+    sinc = 1.0 if t == 0 else math.sin(math.pi * CUTOFF * t) / (math.pi * CUTOFF * t)
+    window = bessel_i0(BETA * math.sqrt(1 - (t / half) ** 2)) / bessel_i0(BETA)
+    return CUTOFF * sinc * window
+
+
+def row(phase, phases):
+    # Tap k multiplies x[i - (TAPS - 1) + k]; the output sits at i - TAPS/2 + phase/phases.
+    ideal = [kernel(TAPS / 2 - 1 - k + phase / phases) for k in range(TAPS)]
+    scale = 32768 / sum(ideal)
+    coefs = [int(round(c * scale)) for c in ideal]
+    error = 32768 - sum(coefs)
+    biggest = max(range(TAPS), key=lambda k: abs(coefs[k]))
+    coefs[biggest] += error
+    assert -32768 <= coefs[biggest] <= 32767
+    return coefs
+
+
+def main():
+    print("// Generated by gen_resampler_tables.py on %s.  Don't edit; re-run the script." %
+          datetime.date.today().isoformat())
+    print("// Windowed-sinc, %d taps, cut-off %.2f of the input Nyquist, Kaiser beta %.1f." %
+          (TAPS, CUTOFF, BETA))
+    print()
+    print('#include "resampler.h"')
+    for phases in TABLES:
+        print()
+        print("const int16_t resamplerTable%d[%d][RESAMPLER_TAPS] = {" % (phases, phases))
+        for p in range(phases):
+            print("    { " + ", ".join("%d" % c for c in row(p, phases)) + " },")
+        print("};")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,118 @@
+#!/usr/bin/env python3
+"""Turn a hot-code profile into opus_hot_functions.txt, the list of Opus functions to run from SRAM.
+
+Build with -DOPUS_HOT_PROFILE=ON, play something representative, then capture the output of the
+`profile` console command to a file.  This maps each sampled PC to the function containing it
+(using arm-none-eabi-nm on the elf), ranks the functions by samples, and takes them in order until
+the SRAM budget is used up.  Only functions from the Opus library are candidates, since those are
+the only ones the OPUS_HOT_PLACEMENT build moves.
+
+The report on stderr shows what each function costs in SRAM and what share of decode time it
+accounted for, so you can see where the budget stops paying for itself.
+
+Usage: python3 tools/hot_placement.py profile.txt build/PicoPlayOpus.elf build/libopus_codec.a \\
+           [--budget BYTES] [--nm arm-none-eabi-nm] > opus_hot_functions.txt
+"""
+import argparse
+import bisect
+import collections
+import subprocess
+import sys
+
+SRAM_BASE = 0x20000000
+
+
+def read_profile(path):
+    """The sampled PCs between the HOTPROFILE markers."""
+    pcs, inside = [], False
+    with open(path) as f:
+        for line in f:
+            line = line.strip()
+            if line.startswith("HOTPROFILE END"):
+                inside = False
+            elif line.startswith("HOTPROFILE"):
+                inside, pcs = True, []    # A later dump replaces an earlier one in the same log.
+            elif inside:
+                pcs.extend(int(word, 16) for word in line.split())
+    return pcs
+
+
+def read_functions(nm, elf):
+    """(address, size, name) for every function in the elf, sorted by address."""
+    out = subprocess.run([nm, "-S", "--defined-only", elf], check=True, capture_output=True, text=True).stdout
+    functions = []
+    for line in out.splitlines():
+        fields = line.split()
+        if len(fields) == 4 and fields[2] in "tTwW":
+            functions.append((int(fields[0], 16) & ~1, int(fields[1], 16), fields[3]))
+    return sorted(functions)
+
+
+def read_library_functions(nm, library):
+    """Names of the functions defined in the Opus library."""
+    out = subprocess.run([nm, "--defined-only", library], check=True, capture_output=True, text=True).stdout
+    return {fields[2] for fields in (line.split() for line in out.splitlines())
+            if len(fields) == 3 and fields[1] in "tT"}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("profile")
+    parser.add_argument("elf")
+    parser.add_argument("library")
+    parser.add_argument("--budget", type=int, default=24 * 1024, help="SRAM to spend on code, in bytes")
+    parser.add_argument("--nm", default="arm-none-eabi-nm")
+    args = parser.parse_args()
+
+    pcs = read_profile(args.profile)
+    if not pcs:
+        sys.exit("No samples in %s.  Was it built with OPUS_HOT_PROFILE, and did anything play?" % args.profile)
+    functions = read_functions(args.nm, args.elf)
+    movable = read_library_functions(args.nm, args.library)
+    starts = [address for address, _, _ in functions]
+
+    hits = collections.Counter()
+    for pc in pcs:
+        i = bisect.bisect_right(starts, pc) - 1
+        if i >= 0 and pc < functions[i][0] + max(functions[i][1], 2):
+            hits[i] += 1
+        else:
+            hits[None] += 1
+
+    total = len(pcs)
+    chosen, used, covered, in_sram, other = [], 0, 0, 0, 0
+    print("%6s %6s %7s  %s" % ("bytes", "samples", "share", "function"), file=sys.stderr)
+    for i, count in hits.most_common():
+        if i is None:
+            other += count
+            continue
+        address, size, name = functions[i]
+        if address >= SRAM_BASE:
+            in_sram += count
+            note = "already in SRAM"
+        elif name not in movable:
+            other += count
+            note = "not in Opus"
+        elif used + size > args.budget:
+            note = "over budget"
+        else:
+            chosen.append(name)
+            used += size
+            covered += count
+            note = ""
+        print("%6d %6d %6.1f%%  %s %s" % (size, count, 100.0 * count / total, name, note), file=sys.stderr)
+
+    print("\n%d samples.  %d functions, %d bytes of SRAM, cover %.1f%% of decode time."
+          % (total, len(chosen), used, 100.0 * covered / total), file=sys.stderr)
+    print("%.1f%% was already in SRAM, %.1f%% was outside Opus." % (100.0 * in_sram / total, 100.0 * other / total),
+          file=sys.stderr)
+
+    print("# Opus functions to run from SRAM when built with OPUS_HOT_PLACEMENT.")
+    print("# Generated by tools/hot_placement.py from %d samples: %d bytes, %.1f%% of decode time."
+          % (total, used, 100.0 * covered / total))
+    for name in chosen:
+        print(name)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,147 @@
+#!/usr/bin/env python3
+"""Generate the decode benchmark's asset matrix in bench-data/.
+
+Encodes a few seconds of a source recording with opusenc at every combination of:
+
+    mode     SILK (6-12 kbps), hybrid (16-24 kbps) or CELT (32-64 kbps)
+    frame    10, 20, 40 and 60 ms
+    channels mono and stereo
+
+opusenc doesn't let you pick the Opus mode directly.  SILK and hybrid are encoded with --speech at
+speech bitrates, CELT with --music at higher ones, and the encoder picks the mode from that.  Each
+asset's name says what was asked for; the bench reports the modes its packets actually used.
+Encoding is hard CBR, so every packet is the same size, at most 480 bytes (64 kbps, 60ms).  Packets of
+255 bytes or more span Ogg lacing segments, which ogg_stripper puts back together; the check against
+MAX_PACKET (the player's PLAYER_PACKET_LEN) only matters if the matrix grows.
+
+Writes bench-data/<name>.opus for the host bench (`make bench` in the host build), and
+bench-data/bench_assets.c/.h to build them into the firmware (-DOPUS_BENCH_ASSETS=ON).  By default
+the source is ogg-data/sample.ogg, decoded with opusdec.  Stereo assets made from a mono source
+have the right channel delayed by a millisecond, so they aren't coded as plain mid.
+
+Usage: python3 tools/make_bench_assets.py [source.wav] [--seconds 2] [--out bench-data]
+"""
+import argparse
+import array
+import datetime
+import os
+import subprocess
+import sys
+import tempfile
+import wave
+
+MODES = (
+    ("silk", "--speech", (6, 8, 12)),
+    ("hybrid", "--speech", (16, 24)),
+    ("celt", "--music", (32, 48, 64)),
+)
+FRAMES_MS = (10, 20, 40, 60)
+MAX_PACKET = 1275
+STEREO_DELAY_MS = 1
+
+
+def read_wav(path, seconds):
+    """The first seconds of a 16-bit WAV, as (rate, [left, right] or [mono]) sample arrays."""
+    with wave.open(path, "rb") as f:
+        if f.getsampwidth() != 2:
+            sys.exit("%s isn't 16-bit." % path)
+        rate, channels = f.getframerate(), f.getnchannels()
+        frames = f.readframes(min(f.getnframes(), int(rate * seconds)))
+    samples = array.array("h", frames)
+    if sys.byteorder == "big":
+        samples.byteswap()
+    return rate, [samples[c::channels] for c in range(channels)]
+
+
+def write_wav(path, rate, channels):
+    interleaved = array.array("h", [0] * (len(channels[0]) * len(channels)))
+    for c, samples in enumerate(channels):
+        interleaved[c::len(channels)] = samples
+    if sys.byteorder == "big":
+        interleaved.byteswap()
+    with wave.open(path, "wb") as f:
+        f.setnchannels(len(channels))
+        f.setsampwidth(2)
+        f.setframerate(rate)
+        f.writeframes(interleaved.tobytes())
+
+
+def mono_and_stereo(rate, channels):
+    if len(channels) == 1:
+        mono = channels[0]
+        delay = rate * STEREO_DELAY_MS // 1000
+        right = array.array("h", [0] * delay) + mono[:len(mono) - delay]
+        return [mono], [mono, right]
+    mono = array.array("h", ((l + r) // 2 for l, r in zip(channels[0], channels[1])))
+    return [mono], channels[:2]
+
+
+def bin2c(name, data):
+    """A C array in the style of ogg-data/sample.c."""
+    lines = ["const char %s[%d] = {" % (name, len(data))]
+    for i in range(0, len(data), 12):
+        lines.append("    " + " ".join("0x%02x," % b for b in data[i:i + 12]))
+    lines.append("};")
+    return "\n".join(lines)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("source", nargs="?", help="16-bit WAV to encode (default: the decoded sample)")
+    parser.add_argument("--seconds", type=float, default=2.0, help="length of each asset")
+    parser.add_argument("--out", default="bench-data", help="output directory")
+    parser.add_argument("--opusenc", default="opusenc")
+    parser.add_argument("--opusdec", default="opusdec")
+    args = parser.parse_args()
+
+    os.makedirs(args.out, exist_ok=True)
+    with tempfile.TemporaryDirectory() as temp:
+        source = args.source
+        if source is None:
+            source = os.path.join(temp, "sample.wav")
+            here = os.path.dirname(os.path.abspath(__file__))
+            subprocess.run([args.opusdec, "--quiet", "--rate", "48000",
+                            os.path.join(here, "..", "ogg-data", "sample.ogg"), source], check=True)
+        rate, channels = read_wav(source, args.seconds)
+        inputs = {}
+        for layout, data in zip(("mono", "stereo"), mono_and_stereo(rate, channels)):
+            inputs[layout] = os.path.join(temp, layout + ".wav")
+            write_wav(inputs[layout], rate, data)
+
+        assets = []
+        for mode, tuning, bitrates in MODES:
+            for kbps in bitrates:
+                for frame in FRAMES_MS:
+                    packet = kbps * frame // 8
+                    for layout in ("mono", "stereo"):
+                        name = "%s_%dk_%dms_%s" % (mode, kbps, frame, layout)
+                        if packet > MAX_PACKET:
+                            print("Skipping %s: %d byte packets." % (name, packet), file=sys.stderr)
+                            continue
+                        path = os.path.join(args.out, name + ".opus")
+                        subprocess.run([args.opusenc, "--quiet", tuning, "--hard-cbr", "--bitrate", str(kbps),
+                                        "--framesize", str(frame), inputs[layout], path], check=True)
+                        assets.append(name)
+
+    date = datetime.date.today().isoformat()
+    with open(os.path.join(args.out, "bench_assets.h"), "w") as h:
+        h.write("// Generated by make_bench_assets.py on %s\n" % date)
+        h.write("#include \"bench.h\"\n\n#ifndef BENCH_ASSETS_H\n#define BENCH_ASSETS_H\n\n")
+        h.write("    #define BENCH_ASSET_COUNT %d\n" % len(assets))
+        h.write("    extern const benchAsset_t BenchAssets[BENCH_ASSET_COUNT];\n\n#endif\n")
+    with open(os.path.join(args.out, "bench_assets.c"), "w") as c:
+        c.write("// Generated by make_bench_assets.py on %s\n" % date)
+        c.write("#include \"bench_assets.h\"\n\n")
+        for name in assets:
+            with open(os.path.join(args.out, name + ".opus"), "rb") as f:
+                data = f.read()
+            c.write("static " + bin2c("bench_" + name, data) + "\n\n")
+        c.write("const benchAsset_t BenchAssets[BENCH_ASSET_COUNT] = {\n")
+        for name in assets:
+            c.write("    { \"%s\", bench_%s, sizeof(bench_%s) },\n" % (name, name, name))
+        c.write("};\n")
+    print("%d assets in %s." % (len(assets), args.out), file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
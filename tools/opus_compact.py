@@ -0,0 +1,178 @@
+#!/usr/bin/env python3
+"""Convert Ogg Opus clips to compact streams (see compact_stream.h), and report what it saves.
+
+A compact stream keeps the Opus packets exactly as they are and drops the Ogg framing around them:
+the 27-byte page headers and segment tables, the OpusHead and OpusTags packets, and the CRCs.  What
+the player needs from the headers (channels, pre-skip, length) goes in a 32-byte header instead, and
+each packet gets its length as a varint, one byte long for packets under 240 bytes.  A seek table with
+a point every --seek-ms or so lets a reader start part way through.  Packets can be any length, where
+ogg_stripper stops at the player's PLAYER_PACKET_LEN (1275 bytes).
+
+The player, the bench and the asset bundle take compact streams wherever they take Ogg; they tell
+them apart by the magic number.  For each clip this prints the Ogg and compact sizes, and how much of
+each is framing rather than Opus packets.  Run the bench (`-b` in the host build) over both to
+compare the time to fetch a packet.
+
+Usage: python3 tools/opus_compact.py clip.opus ... [-o out.opk | --out-dir DIR] [--seek-ms 1000]
+"""
+import argparse
+import os
+import struct
+import sys
+
+MAGIC = 0x314B504F  # "OPK1"
+VERSION = 1
+HEADER = struct.Struct("<IBBHIIIIIHH")
+SEEK_POINT = struct.Struct("<II")
+SHORT = 0xF0  # COMPACT_SHORT and COMPACT_LONG in compact_stream.h.
+LONG = 0xFF
+LONG_BASE = SHORT + ((LONG - SHORT) << 8)
+
+
+def ogg_packets(data, name="clip"):
+    """The packets of a single-stream Ogg file, with the number of pages and the granule of each
+    packet's page (or -1 where a page ends with no packet finished on it)."""
+    packets, pages, partial, serials = [], 0, b"", set()
+    offset = 0
+    while offset < len(data):
+        if data[offset:offset + 4] != b"OggS" or offset + 27 > len(data):
+            raise ValueError("%s: no Ogg page at byte %d." % (name, offset))
+        granule, serial, count = struct.unpack_from("<qIxxxxxxxxB", data, offset + 6)
+        table = data[offset + 27:offset + 27 + count]
+        body = offset + 27 + count
+        serials.add(serial)
+        pages += 1
+        finished = []
+        for lace in table:
+            partial += data[body:body + lace]
+            body += lace
+            if lace < 255:
+                finished.append(partial)
+                partial = b""
+        # A page's granule is that of the last packet finished on it.
+        for i, packet in enumerate(finished):
+            packets.append((packet, granule if i == len(finished) - 1 else None))
+        offset = body
+    if len(serials) != 1:
+        raise ValueError("%s: one Opus stream per file, please." % name)
+    return packets, pages
+
+
+def packet_samples(packet):
+    """Samples at 48kHz in an Opus packet, from its TOC byte (RFC 6716, section 3.1)."""
+    if not packet:
+        return 0
+    toc = packet[0]
+    config = toc >> 3
+    if config < 12:
+        frame = (480, 960, 1920, 2880)[config & 3]
+    elif config < 16:
+        frame = (480, 960)[config & 1]
+    else:
+        frame = (120, 240, 480, 960)[config & 3]
+    code = toc & 3
+    if code == 0:
+        frames = 1
+    elif code < 3:
+        frames = 2
+    else:
+        frames = packet[1] & 0x3F if len(packet) > 1 else 0
+    return frame * frames
+
+
+def varint(value):
+    """A packet length as compact_stream.c reads it: one byte under SHORT, two under LONG_BASE, else three."""
+    if value < SHORT:
+        return bytes([value])
+    if value < LONG_BASE:
+        value -= SHORT
+        return bytes([SHORT + (value >> 8), value & 0xFF])
+    value -= LONG_BASE
+    if value > 0xFFFF:
+        raise ValueError("A %d byte packet is too long." % (value + LONG_BASE))
+    return bytes([LONG, value & 0xFF, value >> 8])
+
+
+def convert(data, seek_ms=1000, name="clip"):
+    """(compact stream, report dict) for an Ogg Opus file."""
+    packets, pages = ogg_packets(data, name)
+    if len(packets) < 2 or packets[0][0][:8] != b"OpusHead" or packets[1][0][:8] != b"OpusTags":
+        raise ValueError("%s: not Ogg Opus." % name)
+    head = packets[0][0]
+    channels, pre_skip, input_rate = struct.unpack_from("<xBHI", head, 8)
+    audio = [packet for packet, _ in packets[2:]]
+    last_granule = max((g for _, g in packets[2:] if g is not None and g >= 0), default=-1)
+    samples = max(last_granule - pre_skip, 0)
+
+    # A seek point every so many packets, by the average packet duration.
+    durations = [packet_samples(packet) for packet in audio]
+    average = sum(durations) / len(durations) if durations else 960
+    interval = max(1, min(0xFFFF, int(round(seek_ms * 48 / max(average, 1))))) if seek_ms > 0 else 0
+
+    body = bytearray()
+    seek = []
+    position = 0
+    for i, packet in enumerate(audio):
+        if interval and i % interval == 0 and i:
+            seek.append((position, len(body)))
+        body += varint(len(packet)) + packet
+        position += durations[i]
+    if len(seek) > 0xFFFF:
+        raise ValueError("%s: too many seek points; raise --seek-ms." % name)
+
+    data_offset = HEADER.size + SEEK_POINT.size * len(seek)
+    out = bytearray(HEADER.pack(MAGIC, VERSION, channels, pre_skip, input_rate, samples, len(audio),
+                                data_offset, len(body), interval, len(seek)))
+    for point in seek:
+        out += SEEK_POINT.pack(*point)
+    out += body
+
+    packet_bytes = sum(len(packet) for packet in audio)
+    report = {"packets": len(audio), "pages": pages, "ogg": len(data), "compact": len(out),
+              "ogg_framing": len(data) - packet_bytes, "compact_framing": len(out) - packet_bytes,
+              "longest": max((len(packet) for packet in audio), default=0)}
+    return bytes(out), report
+
+
+def print_report(name, report):
+    saved = report["ogg"] - report["compact"]
+    print("%-32s %8d %8d %7d %5.1f%% %7.2f %7.2f %6d %s" % (
+        name, report["ogg"], report["compact"], saved, 100.0 * saved / report["ogg"] if report["ogg"] else 0,
+        report["ogg_framing"] / max(report["packets"], 1), report["compact_framing"] / max(report["packets"], 1),
+        report["packets"], "(packets over 1275 bytes: the player skips them in the Ogg)" if report["longest"] > 1275 else ""))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("clips", nargs="+")
+    parser.add_argument("-o", "--out", help="output file, for a single clip")
+    parser.add_argument("--out-dir", help="directory for the .opk files (default: beside each clip)")
+    parser.add_argument("--seek-ms", type=int, default=1000, help="spacing of seek points, or 0 for none")
+    args = parser.parse_args()
+    if args.out and len(args.clips) != 1:
+        parser.error("-o is for a single clip; use --out-dir for several.")
+
+    print("%-32s %8s %8s %7s %6s %7s %7s %6s" % ("clip", "ogg", "compact", "saved", "", "ogg B/p", "opk B/p", "pkts"))
+    total = {"ogg": 0, "compact": 0, "ogg_framing": 0, "compact_framing": 0, "packets": 0, "longest": 0}
+    for clip in args.clips:
+        with open(clip, "rb") as f:
+            data = f.read()
+        try:
+            compact, report = convert(data, args.seek_ms, clip)
+        except ValueError as error:
+            sys.exit(str(error))
+        out = args.out or os.path.join(args.out_dir or os.path.dirname(clip),
+                                       os.path.splitext(os.path.basename(clip))[0] + ".opk")
+        if args.out_dir:
+            os.makedirs(args.out_dir, exist_ok=True)
+        with open(out, "wb") as f:
+            f.write(compact)
+        print_report(os.path.basename(clip), report)
+        for key in ("ogg", "compact", "ogg_framing", "compact_framing", "packets"):
+            total[key] += report[key]
+    if len(args.clips) > 1:
+        print_report("total", total)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,185 @@
+#!/usr/bin/env python3
+"""Pack a directory of Opus clips into one asset bundle for flash (see asset_bundle.h).
+
+Clips are Ogg Opus (.opus or .ogg) or compact streams from opus_compact.py (.opk).  Each keeps its
+bytes, starting on a multiple of --align.  Ahead of them go a header and a directory sorted by clip
+ID, so the firmware finds any clip with a binary search.  A clip's ID is the 32-bit FNV-1a hash of
+its name, which is its file name without the extension.  The directory also has what the player
+would otherwise read from the clip's headers when it starts: pre-skip, channels, length in samples
+and where the audio begins.
+
+Ogg clips are checked against what ogg_stripper can read: one Opus stream, the ID and comment headers
+on a page each, and no audio packet longer than the player's PLAYER_PACKET_LEN (1275 bytes).  Compact
+streams have no such limits.  Names whose IDs
+collide are refused, since the firmware could only ever find one of them.
+
+--ids writes a header of CLIP_<NAME> defines, for phrases built into the firmware.
+
+Build it into the firmware with -DASSET_BUNDLE_DIR=dir, which runs this as part of the build.
+
+Usage: python3 tools/pack_bundle.py DIR [-o assets.bundle] [--ids asset_ids.h] [--align 4]
+"""
+import argparse
+import datetime
+import glob
+import os
+import re
+import struct
+import sys
+
+MAGIC = 0x3142504F  # "OPB1"
+VERSION = 1
+HEADER = struct.Struct("<IHHIIII")
+ENTRY = struct.Struct("<IIIIIIIHBB")
+MAX_ALIGN = 256  # asset_bundle.c aligns the bundle itself to this.
+MAX_PACKET = 1275  # PLAYER_PACKET_LEN in player.h.
+COMPACT_MAGIC = 0x314B504F  # "OPK1", see compact_stream.h.
+COMPACT_HEADER = struct.Struct("<IBBHIIIIIHH")
+
+
+def fnv1a(name):
+    value = 2166136261
+    for byte in name.encode("utf-8"):
+        value = ((value ^ byte) * 16777619) & 0xFFFFFFFF
+    return value
+
+
+def pages(data, path):
+    """(offset, flags, granule, serial, segment table, body offset) for each Ogg page."""
+    offset = 0
+    while offset < len(data):
+        if data[offset:offset + 4] != b"OggS" or offset + 27 > len(data):
+            sys.exit("%s: no Ogg page at byte %d." % (path, offset))
+        flags, granule, serial, count = struct.unpack_from("<xBqIxxxxxxxxB", data, offset + 4)
+        table = data[offset + 27:offset + 27 + count]
+        body = offset + 27 + count
+        yield offset, flags, granule, serial, table, body
+        offset = body + sum(table)
+
+
+def parse(path, data):
+    """The stream info the player needs, checked against what ogg_stripper can read."""
+    info = None
+    serials = set()
+    last_granule = -1
+    packet = 0
+    for number, (offset, flags, granule, serial, table, body) in enumerate(pages(data, path)):
+        serials.add(serial)
+        if number == 0:
+            if data[body:body + 8] != b"OpusHead" or len(table) != 1:
+                sys.exit("%s: the first page isn't just an OpusHead." % path)
+            channels, pre_skip, input_rate = struct.unpack_from("<xBHI", data, body + 8)
+            info = {"channels": channels, "pre_skip": pre_skip, "input_rate": input_rate}
+        elif number == 1:
+            if data[body:body + 8] != b"OpusTags" or table[-1] == 255:
+                sys.exit("%s: OpusTags doesn't fit on the second page.  Strip the tags (opusenc --discard-comments)." % path)
+        else:
+            if number == 2:
+                info["audio_offset"] = offset
+            for lace in table:
+                packet += lace
+                if lace < 255:
+                    if packet > MAX_PACKET:
+                        sys.exit("%s: a %d byte packet on the page at byte %d, longer than the player takes." %
+                                 (path, packet, offset))
+                    packet = 0
+            if granule >= 0:
+                last_granule = granule
+    if info is None or "audio_offset" not in info:
+        sys.exit("%s: no audio." % path)
+    if len(serials) != 1:
+        sys.exit("%s: more than one Ogg stream." % path)
+    if last_granule <= info["pre_skip"]:
+        sys.exit("%s: no granule position past the pre-skip." % path)
+    info["samples"] = last_granule - info["pre_skip"]
+    return info
+
+
+def parse_compact(path, data):
+    """The stream info from a compact stream's header."""
+    if len(data) < COMPACT_HEADER.size:
+        sys.exit("%s: too short for a compact stream." % path)
+    magic, version, channels, pre_skip, input_rate, samples, _, data_offset, data_length, _, _ = \
+        COMPACT_HEADER.unpack_from(data)
+    if magic != COMPACT_MAGIC or version != 1 or data_offset + data_length > len(data):
+        sys.exit("%s: not a compact stream opus_compact.py would write." % path)
+    return {"channels": channels, "pre_skip": pre_skip, "input_rate": input_rate,
+            "audio_offset": data_offset, "samples": samples}
+
+
+def define_name(name):
+    return "CLIP_" + re.sub(r"[^A-Za-z0-9]", "_", name).upper()
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("directory", help="directory of .opus, .ogg and .opk clips")
+    parser.add_argument("-o", "--out", default="assets.bundle")
+    parser.add_argument("--ids", help="also write a header of clip ID defines")
+    parser.add_argument("--align", type=int, default=4, help="alignment of each clip, a power of two up to %d" % MAX_ALIGN)
+    args = parser.parse_args()
+    if args.align < 1 or args.align > MAX_ALIGN or args.align & (args.align - 1):
+        parser.error("--align must be a power of two up to %d." % MAX_ALIGN)
+
+    paths = sorted(glob.glob(os.path.join(args.directory, "*.opus")) + glob.glob(os.path.join(args.directory, "*.ogg")) +
+                   glob.glob(os.path.join(args.directory, "*.opk")))
+    if not paths:
+        sys.exit("No .opus, .ogg or .opk clips in %s." % args.directory)
+
+    clips = {}
+    for path in paths:
+        name = os.path.splitext(os.path.basename(path))[0]
+        clip_id = fnv1a(name)
+        if clip_id in clips:
+            sys.exit("%s and %s have the same ID, %08x.  Rename one." % (clips[clip_id]["name"], name, clip_id))
+        with open(path, "rb") as f:
+            data = f.read()
+        info = parse_compact(path, data) if path.endswith(".opk") else parse(path, data)
+        clips[clip_id] = dict(info, name=name, data=data)
+
+    ids = sorted(clips)
+    names = b""
+    name_offsets = {}
+    names_offset = HEADER.size + ENTRY.size * len(ids)
+    for clip_id in ids:
+        name_offsets[clip_id] = names_offset + len(names)
+        names += clips[clip_id]["name"].encode("utf-8") + b"\0"
+
+    body = bytearray()
+    offset = names_offset + len(names)
+    clip_offsets = {}
+    for clip_id in ids:
+        padding = -(offset + len(body)) % args.align
+        body += b"\0" * padding
+        clip_offsets[clip_id] = offset + len(body)
+        body += clips[clip_id]["data"]
+    length = offset + len(body)
+
+    out = bytearray(HEADER.pack(MAGIC, VERSION, ENTRY.size, len(ids), names_offset, length, args.align))
+    for clip_id in ids:
+        clip = clips[clip_id]
+        out += ENTRY.pack(clip_id, name_offsets[clip_id], clip_offsets[clip_id], len(clip["data"]),
+                          clip["audio_offset"], clip["samples"], clip["input_rate"], clip["pre_skip"],
+                          clip["channels"], 0)
+    out += names + body
+    with open(args.out, "wb") as f:
+        f.write(out)
+
+    if args.ids:
+        guard = re.sub(r"[^A-Za-z0-9]", "_", os.path.basename(args.ids)).upper()
+        with open(args.ids, "w") as h:
+            h.write("// Generated by pack_bundle.py on %s from \"%s\"\n" % (datetime.date.today().isoformat(), args.directory))
+            h.write("#ifndef %s\n#define %s\n\n" % (guard, guard))
+            for name in sorted(clip["name"] for clip in clips.values()):
+                h.write("    #define %s 0x%08xu\n" % (define_name(name), fnv1a(name)))
+            h.write("\n#endif\n")
+
+    audio = sum(len(clip["data"]) for clip in clips.values())
+    seconds = sum(clip["samples"] for clip in clips.values()) / 48000
+    print("%d clips, %.1f s, in %d bytes: %d of audio, %d of directory and names, %d of padding." %
+          (len(ids), seconds, length, audio, names_offset + len(names), length - audio - names_offset - len(names)),
+          file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()